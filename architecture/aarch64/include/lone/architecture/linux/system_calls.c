@@ -152,3 +152,25 @@ long linux_system_call_6(long n, long _1, long _2, long _3, long _4, long _5, lo
 
 	return x0;
 }
+
+/* The kernel finds the saved signal frame at the stack pointer.
+ * The handler returns to this code through the link register,
+ * no prologue may touch the stack before the system call.
+ */
+__attribute__((naked, noreturn))
+void linux_rt_sigreturn(void)
+{
+	__asm__
+	(
+
+#define S2(s) #s
+#define S(s) S2(s)
+
+	"mov x8, #" S(__NR_rt_sigreturn)    "\n"
+	"svc 0"                             "\n"
+
+#undef S2
+#undef S
+
+	);
+}
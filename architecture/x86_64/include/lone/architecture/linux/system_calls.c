@@ -148,3 +148,25 @@ long linux_system_call_6(long number, long _1, long _2, long _3, long _4, long _
 
 	return rax;
 }
+
+/* The kernel finds the saved signal frame at the stack pointer.
+ * The handler's return has just popped the address of this code,
+ * no prologue may touch the stack before the system call.
+ */
+__attribute__((naked, noreturn))
+void linux_rt_sigreturn(void)
+{
+	__asm__
+	(
+
+#define S2(s) #s
+#define S(s) S2(s)
+
+	"mov $" S(__NR_rt_sigreturn) ", %rax"    "\n"
+	"syscall"                                "\n"
+
+#undef S2
+#undef S
+
+	);
+}
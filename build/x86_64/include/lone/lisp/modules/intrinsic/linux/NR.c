@@ -0,0 +1,362 @@
+{ "waitid", __NR_waitid },
+{ "fdatasync", __NR_fdatasync },
+{ "mq_getsetattr", __NR_mq_getsetattr },
+{ "chmod", __NR_chmod },
+{ "sched_getaffinity", __NR_sched_getaffinity },
+{ "connect", __NR_connect },
+{ "epoll_pwait", __NR_epoll_pwait },
+{ "init_module", __NR_init_module },
+{ "delete_module", __NR_delete_module },
+{ "exit_group", __NR_exit_group },
+{ "mkdirat", __NR_mkdirat },
+{ "io_uring_enter", __NR_io_uring_enter },
+{ "rt_sigsuspend", __NR_rt_sigsuspend },
+{ "openat", __NR_openat },
+{ "name_to_handle_at", __NR_name_to_handle_at },
+{ "setdomainname", __NR_setdomainname },
+{ "open", __NR_open },
+{ "timerfd_settime", __NR_timerfd_settime },
+{ "getxattr", __NR_getxattr },
+{ "pause", __NR_pause },
+{ "semop", __NR_semop },
+{ "swapoff", __NR_swapoff },
+{ "setpgid", __NR_setpgid },
+{ "epoll_ctl_old", __NR_epoll_ctl_old },
+{ "ioperm", __NR_ioperm },
+{ "shmat", __NR_shmat },
+{ "ioprio_get", __NR_ioprio_get },
+{ "setpriority", __NR_setpriority },
+{ "rt_sigqueueinfo", __NR_rt_sigqueueinfo },
+{ "nanosleep", __NR_nanosleep },
+{ "pidfd_send_signal", __NR_pidfd_send_signal },
+{ "shmdt", __NR_shmdt },
+{ "fanotify_init", __NR_fanotify_init },
+{ "lremovexattr", __NR_lremovexattr },
+{ "fsopen", __NR_fsopen },
+{ "read", __NR_read },
+{ "kcmp", __NR_kcmp },
+{ "sched_setparam", __NR_sched_setparam },
+{ "swapon", __NR_swapon },
+{ "io_getevents", __NR_io_getevents },
+{ "link", __NR_link },
+{ "timer_gettime", __NR_timer_gettime },
+{ "sendmmsg", __NR_sendmmsg },
+{ "timerfd_create", __NR_timerfd_create },
+{ "gettid", __NR_gettid },
+{ "set_tid_address", __NR_set_tid_address },
+{ "setregid", __NR_setregid },
+{ "membarrier", __NR_membarrier },
+{ "io_uring_register", __NR_io_uring_register },
+{ "mq_unlink", __NR_mq_unlink },
+{ "request_key", __NR_request_key },
+{ "get_kernel_syms", __NR_get_kernel_syms },
+{ "statx", __NR_statx },
+{ "mkdir", __NR_mkdir },
+{ "semctl", __NR_semctl },
+{ "sysinfo", __NR_sysinfo },
+{ "getrandom", __NR_getrandom },
+{ "utime", __NR_utime },
+{ "poll", __NR_poll },
+{ "mq_timedsend", __NR_mq_timedsend },
+{ "prlimit64", __NR_prlimit64 },
+{ "timerfd_gettime", __NR_timerfd_gettime },
+{ "pkey_free", __NR_pkey_free },
+{ "futex_waitv", __NR_futex_waitv },
+{ "removexattr", __NR_removexattr },
+{ "lchown", __NR_lchown },
+{ "inotify_init1", __NR_inotify_init1 },
+{ "semget", __NR_semget },
+{ "nfsservctl", __NR_nfsservctl },
+{ "inotify_add_watch", __NR_inotify_add_watch },
+{ "perf_event_open", __NR_perf_event_open },
+{ "io_destroy", __NR_io_destroy },
+{ "prctl", __NR_prctl },
+{ "rt_sigpending", __NR_rt_sigpending },
+{ "pwritev", __NR_pwritev },
+{ "pwritev2", __NR_pwritev2 },
+{ "get_mempolicy", __NR_get_mempolicy },
+{ "quotactl", __NR_quotactl },
+{ "newfstatat", __NR_newfstatat },
+{ "tuxcall", __NR_tuxcall },
+{ "setresuid", __NR_setresuid },
+{ "mincore", __NR_mincore },
+{ "rt_sigreturn", __NR_rt_sigreturn },
+{ "epoll_wait_old", __NR_epoll_wait_old },
+{ "fremovexattr", __NR_fremovexattr },
+{ "restart_syscall", __NR_restart_syscall },
+{ "process_vm_readv", __NR_process_vm_readv },
+{ "vhangup", __NR_vhangup },
+{ "landlock_create_ruleset", __NR_landlock_create_ruleset },
+{ "renameat", __NR_renameat },
+{ "clock_getres", __NR_clock_getres },
+{ "lsetxattr", __NR_lsetxattr },
+{ "pkey_mprotect", __NR_pkey_mprotect },
+{ "inotify_init", __NR_inotify_init },
+{ "mount", __NR_mount },
+{ "fgetxattr", __NR_fgetxattr },
+{ "wait4", __NR_wait4 },
+{ "clone", __NR_clone },
+{ "kexec_file_load", __NR_kexec_file_load },
+{ "mount_setattr", __NR_mount_setattr },
+{ "select", __NR_select },
+{ "semtimedop", __NR_semtimedop },
+{ "syslog", __NR_syslog },
+{ "getresuid", __NR_getresuid },
+{ "fsync", __NR_fsync },
+{ "close", __NR_close },
+{ "capset", __NR_capset },
+{ "sendfile", __NR_sendfile },
+{ "getdents", __NR_getdents },
+{ "ftruncate", __NR_ftruncate },
+{ "memfd_secret", __NR_memfd_secret },
+{ "pread64", __NR_pread64 },
+{ "madvise", __NR_madvise },
+{ "mbind", __NR_mbind },
+{ "unlinkat", __NR_unlinkat },
+{ "pivot_root", __NR_pivot_root },
+{ "recvmsg", __NR_recvmsg },
+{ "socketpair", __NR_socketpair },
+{ "write", __NR_write },
+{ "symlink", __NR_symlink },
+{ "clock_adjtime", __NR_clock_adjtime },
+{ "pidfd_getfd", __NR_pidfd_getfd },
+{ "unshare", __NR_unshare },
+{ "io_setup", __NR_io_setup },
+{ "getgroups", __NR_getgroups },
+{ "ioprio_set", __NR_ioprio_set },
+{ "munlockall", __NR_munlockall },
+{ "times", __NR_times },
+{ "set_thread_area", __NR_set_thread_area },
+{ "landlock_add_rule", __NR_landlock_add_rule },
+{ "truncate", __NR_truncate },
+{ "getuid", __NR_getuid },
+{ "setresgid", __NR_setresgid },
+{ "rt_sigtimedwait", __NR_rt_sigtimedwait },
+{ "get_robust_list", __NR_get_robust_list },
+{ "reboot", __NR_reboot },
+{ "dup", __NR_dup },
+{ "process_mrelease", __NR_process_mrelease },
+{ "signalfd", __NR_signalfd },
+{ "msgctl", __NR_msgctl },
+{ "mprotect", __NR_mprotect },
+{ "statfs", __NR_statfs },
+{ "getpriority", __NR_getpriority },
+{ "rt_sigaction", __NR_rt_sigaction },
+{ "mq_open", __NR_mq_open },
+{ "timer_delete", __NR_timer_delete },
+{ "munmap", __NR_munmap },
+{ "lstat", __NR_lstat },
+{ "mremap", __NR_mremap },
+{ "shutdown", __NR_shutdown },
+{ "epoll_create1", __NR_epoll_create1 },
+{ "pidfd_open", __NR_pidfd_open },
+{ "chroot", __NR_chroot },
+{ "lgetxattr", __NR_lgetxattr },
+{ "msgget", __NR_msgget },
+{ "preadv", __NR_preadv },
+{ "msgrcv", __NR_msgrcv },
+{ "getresgid", __NR_getresgid },
+{ "open_tree", __NR_open_tree },
+{ "mq_notify", __NR_mq_notify },
+{ "pselect6", __NR_pselect6 },
+{ "getsockname", __NR_getsockname },
+{ "eventfd", __NR_eventfd },
+{ "rt_tgsigqueueinfo", __NR_rt_tgsigqueueinfo },
+{ "setitimer", __NR_setitimer },
+{ "vserver", __NR_vserver },
+{ "sched_get_priority_max", __NR_sched_get_priority_max },
+{ "getcpu", __NR_getcpu },
+{ "pipe2", __NR_pipe2 },
+{ "acct", __NR_acct },
+{ "afs_syscall", __NR_afs_syscall },
+{ "fchdir", __NR_fchdir },
+{ "chown", __NR_chown },
+{ "security", __NR_security },
+{ "putpmsg", __NR_putpmsg },
+{ "mlock", __NR_mlock },
+{ "sched_getparam", __NR_sched_getparam },
+{ "mmap", __NR_mmap },
+{ "create_module", __NR_create_module },
+{ "preadv2", __NR_preadv2 },
+{ "pwrite64", __NR_pwrite64 },
+{ "utimes", __NR_utimes },
+{ "getcwd", __NR_getcwd },
+{ "sched_get_priority_min", __NR_sched_get_priority_min },
+{ "readlinkat", __NR_readlinkat },
+{ "rt_sigprocmask", __NR_rt_sigprocmask },
+{ "fspick", __NR_fspick },
+{ "accept", __NR_accept },
+{ "clock_settime", __NR_clock_settime },
+{ "bind", __NR_bind },
+{ "mlockall", __NR_mlockall },
+{ "sched_yield", __NR_sched_yield },
+{ "access", __NR_access },
+{ "munlock", __NR_munlock },
+{ "dup2", __NR_dup2 },
+{ "dup3", __NR_dup3 },
+{ "pipe", __NR_pipe },
+{ "getitimer", __NR_getitimer },
+{ "setuid", __NR_setuid },
+{ "getgid", __NR_getgid },
+{ "getpmsg", __NR_getpmsg },
+{ "llistxattr", __NR_llistxattr },
+{ "seccomp", __NR_seccomp },
+{ "readlink", __NR_readlink },
+{ "fchmodat", __NR_fchmodat },
+{ "accept4", __NR_accept4 },
+{ "fchown", __NR_fchown },
+{ "stat", __NR_stat },
+{ "execve", __NR_execve },
+{ "vmsplice", __NR_vmsplice },
+{ "sched_setattr", __NR_sched_setattr },
+{ "splice", __NR_splice },
+{ "umask", __NR_umask },
+{ "open_by_handle_at", __NR_open_by_handle_at },
+{ "futimesat", __NR_futimesat },
+{ "fcntl", __NR_fcntl },
+{ "rmdir", __NR_rmdir },
+{ "getdents64", __NR_getdents64 },
+{ "alarm", __NR_alarm },
+{ "futex", __NR_futex },
+{ "arch_prctl", __NR_arch_prctl },
+{ "tee", __NR_tee },
+{ "umount2", __NR_umount2 },
+{ "mknodat", __NR_mknodat },
+{ "fork", __NR_fork },
+{ "creat", __NR_creat },
+{ "inotify_rm_watch", __NR_inotify_rm_watch },
+{ "process_vm_writev", __NR_process_vm_writev },
+{ "copy_file_range", __NR_copy_file_range },
+{ "sched_rr_get_interval", __NR_sched_rr_get_interval },
+{ "openat2", __NR_openat2 },
+{ "set_mempolicy", __NR_set_mempolicy },
+{ "ioctl", __NR_ioctl },
+{ "clock_gettime", __NR_clock_gettime },
+{ "getsockopt", __NR_getsockopt },
+{ "getppid", __NR_getppid },
+{ "modify_ldt", __NR_modify_ldt },
+{ "epoll_pwait2", __NR_epoll_pwait2 },
+{ "linkat", __NR_linkat },
+{ "keyctl", __NR_keyctl },
+{ "pkey_alloc", __NR_pkey_alloc },
+{ "iopl", __NR_iopl },
+{ "io_pgetevents", __NR_io_pgetevents },
+{ "sched_setaffinity", __NR_sched_setaffinity },
+{ "exit", __NR_exit },
+{ "sched_getattr", __NR_sched_getattr },
+{ "sched_setscheduler", __NR_sched_setscheduler },
+{ "io_submit", __NR_io_submit },
+{ "lseek", __NR_lseek },
+{ "symlinkat", __NR_symlinkat },
+{ "signalfd4", __NR_signalfd4 },
+{ "setgid", __NR_setgid },
+{ "utimensat", __NR_utimensat },
+{ "move_pages", __NR_move_pages },
+{ "sendmsg", __NR_sendmsg },
+{ "kill", __NR_kill },
+{ "mlock2", __NR_mlock2 },
+{ "ppoll", __NR_ppoll },
+{ "mq_timedreceive", __NR_mq_timedreceive },
+{ "fsmount", __NR_fsmount },
+{ "quotactl_fd", __NR_quotactl_fd },
+{ "get_thread_area", __NR_get_thread_area },
+{ "vfork", __NR_vfork },
+{ "clone3", __NR_clone3 },
+{ "recvfrom", __NR_recvfrom },
+{ "readahead", __NR_readahead },
+{ "writev", __NR_writev },
+{ "io_cancel", __NR_io_cancel },
+{ "msgsnd", __NR_msgsnd },
+{ "userfaultfd", __NR_userfaultfd },
+{ "personality", __NR_personality },
+{ "flistxattr", __NR_flistxattr },
+{ "ustat", __NR_ustat },
+{ "geteuid", __NR_geteuid },
+{ "timer_create", __NR_timer_create },
+{ "msync", __NR_msync },
+{ "time", __NR_time },
+{ "settimeofday", __NR_settimeofday },
+{ "fsetxattr", __NR_fsetxattr },
+{ "lookup_dcookie", __NR_lookup_dcookie },
+{ "sendto", __NR_sendto },
+{ "getpeername", __NR_getpeername },
+{ "readv", __NR_readv },
+{ "remap_file_pages", __NR_remap_file_pages },
+{ "setgroups", __NR_setgroups },
+{ "sched_getscheduler", __NR_sched_getscheduler },
+{ "sysfs", __NR_sysfs },
+{ "chdir", __NR_chdir },
+{ "move_mount", __NR_move_mount },
+{ "uname", __NR_uname },
+{ "bpf", __NR_bpf },
+{ "setfsuid", __NR_setfsuid },
+{ "getsid", __NR_getsid },
+{ "rename", __NR_rename },
+{ "brk", __NR_brk },
+{ "clock_nanosleep", __NR_clock_nanosleep },
+{ "sync_file_range", __NR_sync_file_range },
+{ "setxattr", __NR_setxattr },
+{ "getpid", __NR_getpid },
+{ "adjtimex", __NR_adjtimex },
+{ "renameat2", __NR_renameat2 },
+{ "getpgid", __NR_getpgid },
+{ "fsconfig", __NR_fsconfig },
+{ "execveat", __NR_execveat },
+{ "fstat", __NR_fstat },
+{ "io_uring_setup", __NR_io_uring_setup },
+{ "sigaltstack", __NR_sigaltstack },
+{ "epoll_ctl", __NR_epoll_ctl },
+{ "timer_getoverrun", __NR_timer_getoverrun },
+{ "fchownat", __NR_fchownat },
+{ "uselib", __NR_uselib },
+{ "gettimeofday", __NR_gettimeofday },
+{ "fallocate", __NR_fallocate },
+{ "landlock_restrict_self", __NR_landlock_restrict_self },
+{ "getpgrp", __NR_getpgrp },
+{ "recvmmsg", __NR_recvmmsg },
+{ "eventfd2", __NR_eventfd2 },
+{ "mknod", __NR_mknod },
+{ "faccessat", __NR_faccessat },
+{ "listen", __NR_listen },
+{ "fstatfs", __NR_fstatfs },
+{ "kexec_load", __NR_kexec_load },
+{ "memfd_create", __NR_memfd_create },
+{ "migrate_pages", __NR_migrate_pages },
+{ "listxattr", __NR_listxattr },
+{ "ptrace", __NR_ptrace },
+{ "fadvise64", __NR_fadvise64 },
+{ "shmctl", __NR_shmctl },
+{ "getegid", __NR_getegid },
+{ "process_madvise", __NR_process_madvise },
+{ "set_mempolicy_home_node", __NR_set_mempolicy_home_node },
+{ "setrlimit", __NR_setrlimit },
+{ "rseq", __NR_rseq },
+{ "unlink", __NR_unlink },
+{ "setreuid", __NR_setreuid },
+{ "_sysctl", __NR__sysctl },
+{ "setns", __NR_setns },
+{ "shmget", __NR_shmget },
+{ "faccessat2", __NR_faccessat2 },
+{ "fchmod", __NR_fchmod },
+{ "timer_settime", __NR_timer_settime },
+{ "getrusage", __NR_getrusage },
+{ "sync", __NR_sync },
+{ "close_range", __NR_close_range },
+{ "setsockopt", __NR_setsockopt },
+{ "socket", __NR_socket },
+{ "fanotify_mark", __NR_fanotify_mark },
+{ "finit_module", __NR_finit_module },
+{ "syncfs", __NR_syncfs },
+{ "query_module", __NR_query_module },
+{ "setsid", __NR_setsid },
+{ "setfsgid", __NR_setfsgid },
+{ "epoll_create", __NR_epoll_create },
+{ "tgkill", __NR_tgkill },
+{ "flock", __NR_flock },
+{ "capget", __NR_capget },
+{ "add_key", __NR_add_key },
+{ "getrlimit", __NR_getrlimit },
+{ "set_robust_list", __NR_set_robust_list },
+{ "tkill", __NR_tkill },
+{ "epoll_wait", __NR_epoll_wait },
+{ "sethostname", __NR_sethostname },
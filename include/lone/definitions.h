@@ -75,6 +75,23 @@ static_assert(LONE_MEMORY_SLAB_SIZE >= LONE_MEMORY_SLAB_MAX, "Slab size must be
 
 #define LONE_MINIMUM_ALIGNMENT LONE_MEMORY_SLAB_MIN
 
+/* SipHash-c-d round counts.
+ * Defaults to the standard SipHash-2-4.
+ * Define as 1 and 3 to select SipHash-1-3.
+ */
+#ifndef LONE_HASH_SIPHASH_COMPRESSION_ROUNDS
+	#define LONE_HASH_SIPHASH_COMPRESSION_ROUNDS 2
+#endif
+
+#ifndef LONE_HASH_SIPHASH_FINALIZATION_ROUNDS
+	#define LONE_HASH_SIPHASH_FINALIZATION_ROUNDS 4
+#endif
+
+/* Largest key hashed by the single shot fast path. */
+#ifndef LONE_HASH_SIPHASH_SHORT_MAXIMUM
+	#define LONE_HASH_SIPHASH_SHORT_MAXIMUM 64
+#endif
+
 #ifndef PT_LONE
 //      PT_LONE   l o n e
 #define PT_LONE 0x6c6f6e65
@@ -540,11 +540,15 @@ typedef lone_elf32_address lone_elf_native_address;
 typedef lone_elf32_offset  lone_elf_native_offset;
 typedef Elf32_Ehdr lone_elf_native_header;
 typedef Elf32_Phdr lone_elf_native_segment;
+typedef Elf32_Dyn  lone_elf_native_dynamic;
+typedef Elf32_Sym  lone_elf_native_symbol;
 #elif __BITS_PER_LONG == 64
 typedef lone_elf64_address lone_elf_native_address;
 typedef lone_elf64_offset  lone_elf_native_offset;
 typedef Elf64_Ehdr lone_elf_native_header;
 typedef Elf64_Phdr lone_elf_native_segment;
+typedef Elf64_Dyn  lone_elf_native_dynamic;
+typedef Elf64_Sym  lone_elf_native_symbol;
 #else
 #	error "Unsupported architecture"
 #endif
@@ -18,8 +18,17 @@
    │    Core operation is ARX (add/rotate/xor) on four 64-bit words.        │
    │    Requires a 128-bit key for keyed hashing.                           │
    │                                                                        │
+   │    The number of compression and finalization rounds is selected       │
+   │    at build time. SipHash-1-3 trades security margin for speed.        │
+   │                                                                        │
    ╰────────────────────────────────────────────────────────────────────────╯ */
 
+/* Initial state derived from the 128-bit key.
+ * Computed once and copied into every hash state. */
+struct lone_hash_siphash_key {
+	lone_u64 v0, v1, v2, v3;
+};
+
 struct lone_hash_siphash_state {
 	lone_u64 v0, v1, v2, v3;
 	unsigned char buffer[8];
@@ -27,8 +36,13 @@ struct lone_hash_siphash_state {
 	size_t total;
 };
 
+void lone_hash_siphash_key_initialize(struct lone_hash_siphash_key *key,
+		lone_u64 k0, lone_u64 k1);
+
 void lone_hash_siphash_initialize(struct lone_hash_siphash_state *state,
 		lone_u64 k0, lone_u64 k1);
+void lone_hash_siphash_initialize_from_key(struct lone_hash_siphash_state *state,
+		const struct lone_hash_siphash_key *key);
 void lone_hash_siphash_update(struct lone_hash_siphash_state *state,
 		struct lone_bytes data);
 lone_u64 lone_hash_siphash_finish(struct lone_hash_siphash_state *state);
@@ -36,4 +50,11 @@ lone_u64 lone_hash_siphash_finish(struct lone_hash_siphash_state *state);
 lone_u64
 lone_hash_siphash(struct lone_bytes data, lone_u64 k0, lone_u64 k1);
 
+/* Hashes the prefix byte followed by the data in a single pass.
+ * Equivalent to updating a fresh state with both, in that order.
+ * Data up to LONE_HASH_SIPHASH_SHORT_MAXIMUM bytes takes the fast path. */
+lone_u64
+lone_hash_siphash_prefixed(const struct lone_hash_siphash_key *key,
+		unsigned char prefix, struct lone_bytes data);
+
 #endif /* LONE_HASH_SIPHASH_HEADER */
@@ -9,7 +9,15 @@
 #include <linux/fcntl.h>
 #include <linux/mman.h>
 #include <linux/stat.h>
+#include <linux/time.h>
+#include <linux/time_types.h>
+#include <linux/uio.h>
+#include <linux/eventpoll.h>
+#include <linux/poll.h>
+#include <linux/io_uring.h>
+#include <linux/timerfd.h>
 #include <asm/stat.h>
+#include <asm/signal.h>
 
 #include <lone/types.h>
 
@@ -29,6 +37,18 @@ long
 __attribute__((tainted_args))
 linux_openat(int dirfd, unsigned char *path, int flags);
 
+long
+__attribute__((tainted_args))
+linux_openat_mode(int dirfd, unsigned char *path, int flags, int mode);
+
+long
+__attribute__((tainted_args))
+linux_renameat(int old_dirfd, unsigned char *old_path, int new_dirfd, unsigned char *new_path);
+
+long
+__attribute__((tainted_args))
+linux_unlinkat(int dirfd, unsigned char *path, int flags);
+
 long
 __attribute__((tainted_args))
 linux_pipe2(int fds[2], int flags);
@@ -37,6 +57,17 @@ long
 __attribute__((tainted_args))
 linux_close(int fd);
 
+long
+__attribute__((tainted_args))
+linux_dup3(int old, int new, int flags);
+
+/* Returns the child's pid in the parent and zero in the child. */
+long
+linux_fork(void);
+
+long
+linux_getpid(void);
+
 long
 __attribute__((fd_arg_read(1), tainted_args))
 linux_fstat(int fd, struct stat *buffer);
@@ -46,8 +77,9 @@ __attribute__((fd_arg_read(1), tainted_args))
 linux_read(int fd, void *buffer, size_t count);
 
 /* Performs exactly one read system call.
- * Loops on EINTR and EAGAIN. Returns the kernel's value:
- * bytes read (0 == end of input) or the negative errno on failure. */
+ * Loops on EINTR. Returns the kernel's value:
+ * bytes read (0 == end of input) or the negative errno on failure,
+ * including -EAGAIN for nonblocking descriptors without input. */
 ssize_t
 __attribute__((fd_arg_read(1), tainted_args))
 linux_read_once(int fd, struct lone_bytes buffer);
@@ -79,6 +111,10 @@ ssize_t
 __attribute__((fd_arg_write(1), tainted_args))
 linux_write_bytes(int fd, struct lone_bytes buffer);
 
+ssize_t
+__attribute__((fd_arg_write(1), tainted_args))
+linux_writev(int fd, const struct iovec *vectors, int count);
+
 off_t
 __attribute__((tainted_args))
 linux_lseek(int fd, off_t offset, int origin);
@@ -95,8 +131,90 @@ int
 __attribute__((tainted_args))
 linux_munmap(void *address, size_t length);
 
+int
+__attribute__((tainted_args))
+linux_msync(void *address, size_t length, int flags);
+
+int
+__attribute__((tainted_args))
+linux_madvise(void *address, size_t length, int advice);
+
+long
+__attribute__((tainted_args))
+linux_sendfile(int out, int in, __kernel_loff_t *offset, size_t count);
+
+long
+__attribute__((tainted_args))
+linux_splice(int in, __kernel_loff_t *in_offset, int out, __kernel_loff_t *out_offset, size_t count, unsigned int flags);
+
+long
+__attribute__((tainted_args))
+linux_tee(int in, int out, size_t count, unsigned int flags);
+
+long
+__attribute__((tainted_args))
+linux_copy_file_range(int in, __kernel_loff_t *in_offset, int out, __kernel_loff_t *out_offset, size_t count, unsigned int flags);
+
 intptr_t
 __attribute__((tainted_args))
 linux_mremap(void *address, size_t old_length, size_t new_length, unsigned long flags, void *new_address);
 
+long
+__attribute__((tainted_args))
+linux_ioctl(int fd, unsigned long request, void *argument);
+
+long
+__attribute__((tainted_args))
+linux_clock_gettime(int clock, struct __kernel_timespec *time);
+
+long
+__attribute__((tainted_args))
+linux_rt_sigaction(int signal, const struct sigaction *action, struct sigaction *old);
+
+/* Returns from a signal handler to the interrupted code.
+ * Never called directly: installed as the restorer of
+ * every signal action, the kernel returns into it
+ * once the handler is done. */
+void
+__attribute__((noreturn))
+linux_rt_sigreturn(void);
+
+long
+__attribute__((tainted_args))
+linux_getcpu(unsigned int *cpu, unsigned int *node);
+
+long
+__attribute__((tainted_args))
+linux_timerfd_create(int clock, int flags);
+
+long
+__attribute__((tainted_args))
+linux_timerfd_settime(int fd, int flags, const struct __kernel_itimerspec *value, struct __kernel_itimerspec *old);
+
+/* Waits for events on a single file descriptor.
+ * Negative timeouts wait indefinitely. */
+long
+__attribute__((tainted_args))
+linux_poll_one(int fd, short events, int timeout);
+
+long
+__attribute__((tainted_args))
+linux_epoll_create1(int flags);
+
+long
+__attribute__((tainted_args))
+linux_epoll_ctl(int epoll, int operation, int fd, struct epoll_event *event);
+
+long
+__attribute__((tainted_args))
+linux_epoll_wait(int epoll, struct epoll_event *events, int count, int timeout);
+
+long
+__attribute__((tainted_args))
+linux_io_uring_setup(unsigned int entries, struct io_uring_params *parameters);
+
+long
+__attribute__((tainted_args))
+linux_io_uring_enter(int ring, unsigned int submit, unsigned int wait, unsigned int flags);
+
 #endif /* LONE_LINUX_HEADER */
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_CACHE_HEADER
+#define LONE_LISP_CACHE_HEADER
+
+#include <lone/types.h>
+#include <lone/lisp/types.h>
+
+#include <lone/linux.h>
+
+/* ╭──────────────────────────┨ LONE LISP CACHE ┠───────────────────────────╮
+   │                                                                        │
+   │    Module files are read once and the forms produced by the            │
+   │    reader are serialized into a cache file next to the module:         │
+   │                                                                        │
+   │        module.ln     source                                            │
+   │        module.lnc    cached forms                                      │
+   │                                                                        │
+   │    Later loads decode the forms directly, bypassing the lexer          │
+   │    and the parser. The cache is used only if the size, the             │
+   │    modification time and the hash of the source all match the          │
+   │    ones recorded when it was written and its own contents hash         │
+   │    to the recorded value. Anything else is silently ignored and        │
+   │    the module is read from source and cached again.                    │
+   │                                                                        │
+   │    Header:                                                             │
+   │                                                                        │
+   │        magic              8 bytes    "\177lonelc" + version            │
+   │        source size        u64le                                        │
+   │        source seconds     s64le      modification time                 │
+   │        source nanoseconds u64le                                        │
+   │        source hash        u64le                                        │
+   │        payload size       u64le                                        │
+   │        payload hash       u64le                                        │
+   │        form count         u64le                                        │
+   │                                                                        │
+   │    Payload is a sequence of values, each a tag byte followed by        │
+   │    its data. Counts, lengths and integers are LEB128 encoded;          │
+   │    integers are zigzag encoded first. Lists, vectors and tables        │
+   │    are sequences of values closed by an end tag. Lists may be          │
+   │    closed by a dot tag followed by the final rest value instead.       │
+   │    Values nest at most LONE_LISP_CACHE_DEPTH_LIMIT levels deep:        │
+   │    deeper forms are not cached and deeper payloads are rejected.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+struct lone_lisp_cache_source {
+	lone_u64 size;
+	lone_s64 seconds;
+	lone_u64 nanoseconds;
+	lone_u64 hash;
+};
+
+struct lone_lisp_cache_writer {
+	struct lone_bytes buffer;
+	size_t used;
+	size_t forms;
+	size_t depth;
+	bool failed;
+};
+
+void lone_lisp_cache_source_of(struct lone_lisp_cache_source *source,
+		struct stat *status, struct lone_bytes contents);
+
+/* Decodes the forms cached for the source at the given path
+ * relative to the given directory file descriptor.
+ * Returns false if there is no valid cache for the source. */
+bool lone_lisp_cache_load(struct lone_lisp *lone, int directory, struct lone_bytes path,
+		struct lone_lisp_cache_source *source, struct lone_lisp_value *forms);
+
+void lone_lisp_cache_writer_initialize(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer);
+void lone_lisp_cache_writer_append(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		struct lone_lisp_value form);
+
+/* Writes the cache file for the source at the given path
+ * relative to the given directory file descriptor.
+ * Failures are ignored, caching is an optimization. */
+void lone_lisp_cache_writer_store(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		int directory, struct lone_bytes path, struct lone_lisp_cache_source *source);
+
+void lone_lisp_cache_writer_finalize(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer);
+
+#endif /* LONE_LISP_CACHE_HEADER */
@@ -6,6 +6,7 @@
 #include <lone/definitions.h>
 
 #define LONE_LISP_DECIMAL_DIGITS_PER_INTEGER LONE_DECIMAL_DIGITS_PER_LONG
+#define LONE_LISP_INTEGER_FORMAT_SIZE (LONE_LISP_DECIMAL_DIGITS_PER_INTEGER + 1) /* digits + sign */
 
 /* ╭────────────────────────────────────────────────────────────────────────╮
    │                                                                        │
@@ -113,6 +114,42 @@
 #define LONE_LISP_INLINE_LENGTH_MASK       0x07  /* 3 bits for length 0-7 */
 #define LONE_LISP_INLINE_MAX_LENGTH        7
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Packed symbols.                                                     │
+   │                                                                        │
+   │    Symbols with 8 to 11 byte names drawn from a small alphabet         │
+   │    are encoded in the word as fixed width character codes.             │
+   │                                                                        │
+   │        length 8-9:      6 bit codes,  9 × 6 = 54 bits                  │
+   │        length 10-11:    5 bit codes, 11 × 5 = 55 bits                  │
+   │                                                                        │
+   │    Inline value type 011 marks packed symbols.                         │
+   │    The length field holds the length minus 8.                          │
+   │    Character i is stored at bit 8 + i × width.                         │
+   │    Unused high bits are zero.                                          │
+   │                                                                        │
+   │    The width is a function of the length and names are                 │
+   │    packed whenever possible, so every name has exactly one             │
+   │    encoding and identity comparison keeps working.                     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define LONE_LISP_INLINE_TYPE_PACKED_SYMBOL 0xB1  /* 1_011_xxx_1 */
+#define LONE_LISP_PACKED_SYMBOL_MIN_LENGTH  8
+#define LONE_LISP_PACKED_SYMBOL_MAX_LENGTH  11
+#define LONE_LISP_PACKED_SYMBOL_WIDE_LENGTH 9   /* longest name using 6 bit codes */
+#define LONE_LISP_PACKED_SYMBOL_WIDE_BITS   6
+#define LONE_LISP_PACKED_SYMBOL_NARROW_BITS 5
+
+/* Decoded packed symbol names are written into a ring of
+ * buffers in the interpreter. Each decoded name remains
+ * valid until that many more packed names are decoded.
+ */
+#ifndef LONE_LISP_PACKED_SYMBOL_BUFFERS
+	#define LONE_LISP_PACKED_SYMBOL_BUFFERS 8
+#endif
+
 /* Flag bit in an INTERCEPTOR_DELIMITER stack frame.
  * Set while that interceptor is dispatching a signal.
  * The stack walker skips dispatching delimiters so that
@@ -127,6 +164,32 @@
 	#define LONE_LISP_BUFFER_SIZE 4096
 #endif
 
+/* Output streams buffer this many bytes before writing. */
+#ifndef LONE_LISP_OUTPUT_BUFFER_SIZE
+	#define LONE_LISP_OUTPUT_BUFFER_SIZE 4096
+#endif
+
+/* Maximum number of simultaneously buffered file descriptors.
+ * Output to other file descriptors is written unbuffered.
+ */
+#ifndef LONE_LISP_OUTPUT_STREAMS
+	#define LONE_LISP_OUTPUT_STREAMS 8
+#endif
+
+/* Default limits on printed values. Zero means unlimited. */
+#ifndef LONE_LISP_PRINT_DEPTH_LIMIT
+	#define LONE_LISP_PRINT_DEPTH_LIMIT 0
+#endif
+
+#ifndef LONE_LISP_PRINT_LENGTH_LIMIT
+	#define LONE_LISP_PRINT_LENGTH_LIMIT 0
+#endif
+
+/* Initial number of pending tasks of the printer. */
+#ifndef LONE_LISP_PRINT_STACK_INITIAL_SIZE
+	#define LONE_LISP_PRINT_STACK_INITIAL_SIZE 64
+#endif
+
 #ifndef LONE_LISP_MEMORY_SIZE
 	#define LONE_LISP_MEMORY_SIZE (1024 * 1024)
 #endif
@@ -135,8 +198,43 @@
 	#define LONE_LISP_HEAP_INITIAL_CAPACITY (1024 * 1024)
 #endif
 
+/* Symbol name arena size in bytes.
+ * Rounded up to whole pages.
+ */
+#ifndef LONE_LISP_NAMES_INITIAL_CAPACITY
+	#define LONE_LISP_NAMES_INITIAL_CAPACITY (64 * 1024)
+#endif
+
+#ifndef LONE_LISP_NAMES_GROWTH_FACTOR
+	#define LONE_LISP_NAMES_GROWTH_FACTOR 2
+#endif
+
 #define LONE_LISP_TABLE_INDEX_EMPTY ((size_t) -1)
 
+/* Size of the stack buffers module file paths are built in.
+ * Modules with longer relative paths cannot be found. */
+#ifndef LONE_LISP_MODULE_PATH_SIZE
+	#define LONE_LISP_MODULE_PATH_SIZE 1024
+#endif
+
+/* Whether the forms read from module files
+ * are cached next to them for faster loading. */
+#ifndef LONE_LISP_MODULE_CACHE
+	#define LONE_LISP_MODULE_CACHE true
+#endif
+
+/* Maximum nesting depth of cached values. Deeper forms
+ * are not cached and are read from source instead. */
+#ifndef LONE_LISP_CACHE_DEPTH_LIMIT
+	#define LONE_LISP_CACHE_DEPTH_LIMIT 256
+#endif
+
+/* Whether the reader hash conses literals by default:
+ * texts, bytes and quoted data. */
+#ifndef LONE_LISP_HASH_CONS_LITERALS
+	#define LONE_LISP_HASH_CONS_LITERALS false
+#endif
+
 #ifndef LONE_LISP_HEAP_GROWTH_FACTOR
 	#define LONE_LISP_HEAP_GROWTH_FACTOR 2
 #endif
@@ -155,6 +253,14 @@
 	#define LONE_LISP_GENERATOR_STACK_INITIAL_SIZE 128
 #endif
 
+#ifndef LONE_LISP_EVENT_BATCH_SIZE
+	#define LONE_LISP_EVENT_BATCH_SIZE 64
+#endif
+
+#ifndef LONE_LISP_EVENT_QUANTUM
+	#define LONE_LISP_EVENT_QUANTUM 10000
+#endif
+
 #ifndef LONE_LISP_MACHINE_STACK_MAXIMUM_SIZE
 	#define LONE_LISP_MACHINE_STACK_MAXIMUM_SIZE 65536
 #endif
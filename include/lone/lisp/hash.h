@@ -5,6 +5,10 @@
 
 #include <lone/lisp/types.h>
 
+/* Derives the keyed SipHash initial state from the system random bytes.
+ * Must run before any value is hashed. */
+void lone_lisp_hash_initialize(struct lone_lisp *lone);
+
 lone_hash lone_lisp_hash_of(struct lone_lisp *lone, struct lone_lisp_value value);
 
 lone_hash lone_lisp_hash_as_symbol(struct lone_lisp *lone, struct lone_bytes name);
@@ -0,0 +1,29 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_HASH_CONS_HEADER
+#define LONE_LISP_HASH_CONS_HEADER
+
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Hash consing of frozen values.                                      │
+   │                                                                        │
+   │    Texts, frozen bytes and lists made of such values are canonicalized │
+   │    through a table with weak keys and values. Equal values passed      │
+   │    through it come out as the same heap value, which lets equality     │
+   │    checks on them succeed by identity and releases the duplicates.     │
+   │    Entries die with the last reference to their canonical value.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_hash_cons_initialize(struct lone_lisp *lone);
+
+/* Returns the canonical value equal to the given value.
+ * Lists are canonicalized element by element.
+ * Values that cannot be shared are returned unchanged:
+ * vectors, tables, mutable bytes and lists containing them
+ * as well as lists deeper or longer than the cache limit. */
+struct lone_lisp_value lone_lisp_hash_cons(struct lone_lisp *lone, struct lone_lisp_value value);
+
+#endif /* LONE_LISP_HASH_CONS_HEADER */
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MACHINE_INTERRUPT_HEADER
+#define LONE_LISP_MACHINE_INTERRUPT_HEADER
+
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Linux signals interrupt the machine between evaluation steps.       │
+   │                                                                        │
+   │    The native handler is asynchronous and can do almost nothing:       │
+   │    it sets the signal's bit in the pending word and writes a byte      │
+   │    to a self-pipe. The machine tests the pending word whenever it      │
+   │    begins evaluating a list. At that point the expression and its      │
+   │    environment are all the state there is, so they are saved on        │
+   │    the stack and the lisp handler is applied to the signal number.     │
+   │    The expression is evaluated once the handler has returned.          │
+   │                                                                        │
+   │    The self-pipe becomes readable when signals are delivered.          │
+   │    Event loops wait for it in order to wake up and let tasks run,      │
+   │    which is when the handlers are applied. It is drained by the        │
+   │    machine. Handlers may be interrupted by further signals.            │
+   │                                                                        │
+   │    Schedulers preempt tasks in the same place. The machine counts      │
+   │    down the budget of the generator it was given and makes it          │
+   │    yield nil once it is exhausted.                                     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+extern lone_u64 lone_lisp_machine_interrupts;
+
+long lone_lisp_machine_interrupt_descriptor(struct lone_lisp *lone);
+long lone_lisp_machine_interrupt_handle(struct lone_lisp *lone, long signal, struct lone_lisp_value handler);
+bool lone_lisp_machine_interrupt(struct lone_lisp *lone, struct lone_lisp_machine *machine);
+bool lone_lisp_machine_preempt(struct lone_lisp *lone, struct lone_lisp_machine *machine);
+long lone_lisp_machine_interrupt_forked(struct lone_lisp *lone);
+
+#endif /* LONE_LISP_MACHINE_INTERRUPT_HEADER */
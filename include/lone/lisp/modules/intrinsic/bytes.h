@@ -16,6 +16,12 @@ void lone_lisp_modules_intrinsic_bytes_initialize(struct lone_lisp *lone);
 
 LONE_LISP_PRIMITIVE(bytes_new);
 LONE_LISP_PRIMITIVE(bytes_is_zero);
+LONE_LISP_PRIMITIVE(bytes_slice);
+
+LONE_LISP_PRIMITIVE(bytes_map_file);
+LONE_LISP_PRIMITIVE(bytes_map_memory);
+LONE_LISP_PRIMITIVE(bytes_sync);
+LONE_LISP_PRIMITIVE(bytes_advise);
 
 LONE_LISP_PRIMITIVE(bytes_read_u8);
 LONE_LISP_PRIMITIVE(bytes_read_s8);
@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MODULES_INTRINSIC_EVENT_HEADER
+#define LONE_LISP_MODULES_INTRINSIC_EVENT_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Tasks scheduled on file descriptor readiness.                       │
+   │                                                                        │
+   │        (run generator...)                                              │
+   │        (readable fd)  (writable fd)  (spawn generator)                 │
+   │        (sleep milliseconds)                                            │
+   │        (quantum)  (quantum lists)                                      │
+   │                                                                        │
+   │    Tasks are generators run by the scheduler until all of them         │
+   │    have finished. Inside a task, readable and writable yield to        │
+   │    the scheduler which resumes the task once the file descriptor       │
+   │    is ready. They return the ready events or a negative error          │
+   │    number. Sleep waits for a timer in the same way. Spawn starts       │
+   │    another task. Plain yields let other runnable tasks run first       │
+   │    and return nil.                                                     │
+   │                                                                        │
+   │    Tasks which do not yield are preempted by the machine once they     │
+   │    have begun evaluating quantum lists and run again after every       │
+   │    other runnable task. A quantum of zero disables preemption.         │
+   │                                                                        │
+   │    Readiness is waited for with one epoll instance per run.            │
+   │    Each file descriptor can have at most one waiting task.             │
+   │    Signals which escape a task abandon the whole run.                  │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_modules_intrinsic_event_initialize(struct lone_lisp *lone);
+
+LONE_LISP_PRIMITIVE(event_run);
+LONE_LISP_PRIMITIVE(event_readable);
+LONE_LISP_PRIMITIVE(event_writable);
+LONE_LISP_PRIMITIVE(event_spawn);
+LONE_LISP_PRIMITIVE(event_sleep);
+LONE_LISP_PRIMITIVE(event_quantum);
+
+#endif /* LONE_LISP_MODULES_INTRINSIC_EVENT_HEADER */
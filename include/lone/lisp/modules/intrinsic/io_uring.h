@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MODULES_INTRINSIC_IO_URING_HEADER
+#define LONE_LISP_MODULES_INTRINSIC_IO_URING_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+#include <lone/linux.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Batched input and output through io_uring.                          │
+   │                                                                        │
+   │        (setup entries)                                                 │
+   │        (read ring fd bytes offset tag)                                 │
+   │        (write ring fd bytes-or-text offset tag)                        │
+   │        (accept ring fd tag)                                            │
+   │        (openat ring directory path flags mode tag)                     │
+   │        (close ring fd tag)                                             │
+   │        (timeout ring nanoseconds tag)                                  │
+   │        (submit ring)  (submit ring wait)                               │
+   │        (complete ring)                                                 │
+   │        (release ring)                                                  │
+   │                                                                        │
+   │    Operations are only queued in the shared submission ring and        │
+   │    return false when it is full. Submit hands every queued one to      │
+   │    the kernel with a single system call and optionally waits for       │
+   │    some completions. Complete returns a list of (tag result) for       │
+   │    every finished operation without entering the kernel. Results       │
+   │    are those of the equivalent system calls.                           │
+   │                                                                        │
+   │    Buffers are kept alive by the ring until their operations have      │
+   │    completed. Bytes slices can be used to read into or write from      │
+   │    part of a larger buffer. Releasing a ring cancels operations        │
+   │    still in flight and waits for them to finish. Rings which are       │
+   │    garbage collected are released first. Timeouts cannot be            │
+   │    negative.                                                           │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+struct lone_lisp_io_uring {
+	int fd;
+	unsigned int queued;
+	lone_u64 next_tag;
+
+	struct {
+		unsigned int *head;
+		unsigned int *tail;
+		unsigned int *mask;
+		unsigned int *entries;
+		unsigned int *array;
+		struct io_uring_sqe *sqes;
+		size_t sqes_size;
+		void *ring;
+		size_t size;
+	} submission;
+
+	struct {
+		unsigned int *head;
+		unsigned int *tail;
+		unsigned int *mask;
+		struct io_uring_cqe *cqes;
+		void *ring;
+		size_t size;
+	} completion;
+};
+
+void lone_lisp_modules_intrinsic_io_uring_initialize(struct lone_lisp *lone);
+
+/* Releases a ring unless already released. */
+void lone_lisp_io_uring_finalize(struct lone_lisp *lone, struct lone_lisp_value ring);
+
+LONE_LISP_PRIMITIVE(io_uring_setup);
+LONE_LISP_PRIMITIVE(io_uring_read);
+LONE_LISP_PRIMITIVE(io_uring_write);
+LONE_LISP_PRIMITIVE(io_uring_accept);
+LONE_LISP_PRIMITIVE(io_uring_openat);
+LONE_LISP_PRIMITIVE(io_uring_close);
+LONE_LISP_PRIMITIVE(io_uring_timeout);
+LONE_LISP_PRIMITIVE(io_uring_submit);
+LONE_LISP_PRIMITIVE(io_uring_complete);
+LONE_LISP_PRIMITIVE(io_uring_release);
+
+#endif /* LONE_LISP_MODULES_INTRINSIC_IO_URING_HEADER */
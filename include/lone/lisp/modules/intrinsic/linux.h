@@ -16,5 +16,17 @@ void lone_lisp_modules_intrinsic_linux_initialize(struct lone_lisp *lone,
 		int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv);
 
 LONE_LISP_PRIMITIVE(linux_system_call);
+LONE_LISP_PRIMITIVE(linux_system_call_batch);
+LONE_LISP_PRIMITIVE(linux_system_call_function);
+LONE_LISP_PRIMITIVE(linux_system_call_bound);
+
+LONE_LISP_PRIMITIVE(linux_sendfile);
+LONE_LISP_PRIMITIVE(linux_splice);
+LONE_LISP_PRIMITIVE(linux_tee);
+LONE_LISP_PRIMITIVE(linux_copy_file_range);
+
+LONE_LISP_PRIMITIVE(linux_handle_signal);
+LONE_LISP_PRIMITIVE(linux_signal_descriptor);
+LONE_LISP_PRIMITIVE(linux_prefork);
 
 #endif /* LONE_LISP_MODULES_INTRINSIC_LINUX_HEADER */
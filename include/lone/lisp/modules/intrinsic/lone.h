@@ -21,6 +21,13 @@ long lone_lisp_signal_emit(
 		struct lone_lisp_value tag,
 		struct lone_lisp_value value);
 
+/* Creates a generator that will apply the function to the arguments
+ * when first resumed, with its stack loaded accordingly. */
+struct lone_lisp_value lone_lisp_generator_prepare(
+		struct lone_lisp *lone,
+		struct lone_lisp_value function,
+		struct lone_lisp_value arguments);
+
 LONE_LISP_PRIMITIVE(lone_begin);
 LONE_LISP_PRIMITIVE(lone_when);
 LONE_LISP_PRIMITIVE(lone_unless);
@@ -53,7 +60,10 @@ LONE_LISP_PRIMITIVE(lone_is_equivalent);
 LONE_LISP_PRIMITIVE(lone_is_equal);
 LONE_LISP_PRIMITIVE(lone_freeze);
 LONE_LISP_PRIMITIVE(lone_is_frozen);
+LONE_LISP_PRIMITIVE(lone_intern);
+LONE_LISP_PRIMITIVE(lone_intern_literals);
 LONE_LISP_PRIMITIVE(lone_apply);
 LONE_LISP_PRIMITIVE(lone_print);
+LONE_LISP_PRIMITIVE(lone_print_limits);
 
 #endif /* LONE_LISP_MODULES_INTRINSIC_LONE_HEADER */
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MODULES_INTRINSIC_OUTPUT_HEADER
+#define LONE_LISP_MODULES_INTRINSIC_OUTPUT_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Buffered output stream operations.                                  │
+   │                                                                        │
+   │        (write fd text-or-bytes ...)                                    │
+   │        (flush)  (flush fd)                                             │
+   │        (buffering fd 'none)  'line  'full                              │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_modules_intrinsic_output_initialize(struct lone_lisp *lone);
+
+LONE_LISP_PRIMITIVE(output_write);
+LONE_LISP_PRIMITIVE(output_flush);
+LONE_LISP_PRIMITIVE(output_buffering);
+
+#endif /* LONE_LISP_MODULES_INTRINSIC_OUTPUT_HEADER */
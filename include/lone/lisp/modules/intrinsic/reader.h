@@ -0,0 +1,29 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MODULES_INTRINSIC_READER_HEADER
+#define LONE_LISP_MODULES_INTRINSIC_READER_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Incremental reading of forms from file descriptors and bytes.       │
+   │                                                                        │
+   │        (forms fd)  (forms text-or-bytes)                               │
+   │                                                                        │
+   │    Returns a generator which yields each form as it is read.           │
+   │    File descriptors are read as forms are needed, through the          │
+   │    same buffer the reader uses for module files. The generator         │
+   │    finishes at the end of the input and signals read-error if          │
+   │    the input is malformed. Since nil is a valid form, callers          │
+   │    should check finished? rather than the yielded value.               │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_modules_intrinsic_reader_initialize(struct lone_lisp *lone);
+
+LONE_LISP_PRIMITIVE(reader_forms);
+LONE_LISP_PRIMITIVE(reader_next);
+
+#endif /* LONE_LISP_MODULES_INTRINSIC_READER_HEADER */
@@ -22,5 +22,6 @@ LONE_LISP_PRIMITIVE(text_code_unit_count);
 LONE_LISP_PRIMITIVE(text_code_point_at);
 LONE_LISP_PRIMITIVE(text_from_code_point);
 LONE_LISP_PRIMITIVE(text_slice);
+LONE_LISP_PRIMITIVE(text_format_integer);
 
 #endif /* LONE_LISP_MODULES_INTRINSIC_TEXT_HEADER */
@@ -0,0 +1,31 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_MODULES_INTRINSIC_TIME_HEADER
+#define LONE_LISP_MODULES_INTRINSIC_TIME_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Clocks read through the vDSO without entering the kernel.           │
+   │                                                                        │
+   │        (monotonic)    microseconds since an unspecified start          │
+   │        (realtime)     microseconds since the epoch                     │
+   │        (cpu)          number of the processor running the caller       │
+   │                                                                        │
+   │    Clocks are measured in microseconds because the number of           │
+   │    nanoseconds since the epoch does not fit in lisp integers.          │
+   │    Neither does the monotonic clock after about 417 days.              │
+   │    System calls are made instead when the vDSO is unavailable.         │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_modules_intrinsic_time_initialize(struct lone_lisp *lone,
+		struct lone_auxiliary_vector *auxv);
+
+LONE_LISP_PRIMITIVE(time_monotonic);
+LONE_LISP_PRIMITIVE(time_realtime);
+LONE_LISP_PRIMITIVE(time_cpu);
+
+#endif /* LONE_LISP_MODULES_INTRINSIC_TIME_HEADER */
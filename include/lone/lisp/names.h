@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_NAMES_HEADER
+#define LONE_LISP_NAMES_HEADER
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Symbol name arena.                                                  │
+   │                                                                        │
+   │    Interned symbol names are copied into a single page granular        │
+   │    mapping by bumping a pointer. Names of symbols that die are         │
+   │    reclaimed by the garbage collector, which slides the surviving      │
+   │    names down and updates their symbols.                               │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_names_initialize(struct lone_lisp *lone);
+
+/* Copies the name of the symbol at the given heap index
+ * into the arena and returns the NUL terminated copy.
+ * The bytes may point into the arena itself. */
+unsigned char *lone_lisp_names_store(struct lone_lisp *lone,
+		size_t index, unsigned char *bytes, size_t count);
+
+bool lone_lisp_names_contain(struct lone_lisp *lone, void *pointer);
+
+/* Records the new heap index of a symbol whose name is in the arena. */
+void lone_lisp_names_move(struct lone_lisp *lone, unsigned char *name, size_t index);
+
+/* Reclaims the names of dead symbols. Must run after the sweep
+ * and before the heap values are moved by compaction. */
+void lone_lisp_names_compact(struct lone_lisp *lone);
+
+#endif /* LONE_LISP_NAMES_HEADER */
@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_OUTPUT_HEADER
+#define LONE_LISP_OUTPUT_HEADER
+
+#include <lone/lisp/types.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Buffered output streams.                                            │
+   │                                                                        │
+   │    Output to a file descriptor accumulates in a per descriptor         │
+   │    buffer and is written out when the buffer fills, when a line        │
+   │    is completed on a line buffered stream or when flushed.             │
+   │    Writes that do not fit are gathered together with the pending       │
+   │    buffered output into a single writev system call.                   │
+   │                                                                        │
+   │    Defaults:                                                           │
+   │                                                                        │
+   │        ◦ standard error         unbuffered                             │
+   │        ◦ terminals              line buffered                          │
+   │        ◦ everything else        fully buffered                         │
+   │                                                                        │
+   │    Streams are flushed after every top level form is evaluated,        │
+   │    at the end of every module, before system calls and before          │
+   │    the process exits.                                                  │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_output_initialize(struct lone_lisp *lone);
+
+void lone_lisp_output_write(struct lone_lisp *lone, int file_descriptor, struct lone_bytes bytes);
+
+void lone_lisp_output_flush(struct lone_lisp *lone, int file_descriptor);
+void lone_lisp_output_flush_all(struct lone_lisp *lone);
+
+/* Forgets the stream of a file descriptor that has been closed
+ * or replaced. Its file descriptor number may be reused by
+ * an unrelated file which must not inherit the stream's mode.
+ * Pending output is discarded: streams are flushed before
+ * the system calls that close file descriptors. */
+void lone_lisp_output_close(struct lone_lisp *lone, int file_descriptor);
+
+/* Flushes every stream before exiting the process.
+ * Used wherever lisp cannot go on: unhandled signals,
+ * invalid programs and impossible machine states. */
+void
+__attribute__((noreturn))
+lone_lisp_exit(struct lone_lisp *lone, int code);
+
+/* Returns false if no stream is available for the file descriptor. */
+bool lone_lisp_output_set_buffering(struct lone_lisp *lone, int file_descriptor,
+		enum lone_lisp_output_buffering buffering);
+
+#endif /* LONE_LISP_OUTPUT_HEADER */
@@ -9,8 +9,16 @@
    │                                                                        │
    │    Transforms lone lisp objects into text and writes them out.         │
    │                                                                        │
+   │    Nested values are printed without recursion and values which        │
+   │    contain themselves are printed as #<cycle> where they recur.        │
+   │    Deeply nested containers and long sequences of elements are         │
+   │    elided as ... according to the limits, which default to the         │
+   │    interpreter's print limits.                                         │
+   │                                                                        │
    ╰────────────────────────────────────────────────────────────────────────╯ */
 
 void lone_lisp_print(struct lone_lisp *lone, struct lone_lisp_value value, int file_descriptor);
+void lone_lisp_print_with_limits(struct lone_lisp *lone, struct lone_lisp_value value, int file_descriptor,
+		struct lone_lisp_print_limits limits);
 
 #endif /* LONE_LISP_PRINTER_HEADER */
@@ -32,6 +32,12 @@
 void lone_lisp_reader_for_bytes(struct lone_lisp *lone, struct lone_lisp_reader *reader,
 		struct lone_bytes bytes);
 
+/* Reads from mapped bytes which are kept alive by the values read
+ * from them. Texts without escape sequences are slices of the
+ * mapping instead of being copied. */
+void lone_lisp_reader_for_mapped_bytes(struct lone_lisp *lone, struct lone_lisp_reader *reader,
+		struct lone_lisp_value mapping);
+
 void lone_lisp_reader_for_file_descriptor(struct lone_lisp *lone, struct lone_lisp_reader *reader,
 		size_t buffer_size, int file_descriptor);
 
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_LISP_SCAN_HEADER
+#define LONE_LISP_SCAN_HEADER
+
+#include <lone/types.h>
+
+/* ╭───────────────────────────┨ LONE LISP SCAN ┠───────────────────────────╮
+   │                                                                        │
+   │    Lexical scanning of runs of input bytes.                            │
+   │                                                                        │
+   │    Each function returns the length of the longest prefix of the       │
+   │    given bytes made up entirely of bytes of its class, which is the    │
+   │    offset of the first byte outside the class or the count if the      │
+   │    entire input belongs to it.                                         │
+   │                                                                        │
+   │        whitespace    spaces, tabs and line feeds                       │
+   │        symbol        anything but whitespace, brackets, ; and "        │
+   │        line          anything but line feeds                           │
+   │        quoted        anything but " and \                              │
+   │        digits        0 through 9                                       │
+   │                                                                        │
+   │    Input is classified sixteen bytes at a time with vector             │
+   │    comparisons which the compiler lowers to SSE2 on x86_64 and         │
+   │    to NEON on aarch64. Remaining bytes are classified one by one.      │
+   │    The first few bytes of whitespace are checked one by one            │
+   │    since most runs of it are single spaces between tokens.             │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+size_t lone_lisp_scan_whitespace(unsigned char *bytes, size_t count);
+size_t lone_lisp_scan_symbol(unsigned char *bytes, size_t count);
+size_t lone_lisp_scan_line(unsigned char *bytes, size_t count);
+size_t lone_lisp_scan_quoted(unsigned char *bytes, size_t count);
+size_t lone_lisp_scan_digits(unsigned char *bytes, size_t count);
+
+#endif /* LONE_LISP_SCAN_HEADER */
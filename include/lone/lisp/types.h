@@ -5,27 +5,13 @@
 
 #include <lone/definitions.h>
 #include <lone/types.h>
+#include <lone/hash/siphash.h>
 
 #include <lone/lisp/definitions.h>
 #include <lone/lisp/types.h>
 
 typedef long lone_lisp_integer;
 
-struct lone_lisp_reader {
-	int file_descriptor;
-	struct {
-		struct lone_bytes bytes;
-		struct {
-			size_t read;
-			size_t write;
-		} position;
-	} buffer;
-	struct {
-		bool end_of_input: 1;
-		bool error: 1;
-	} status;
-};
-
 /* ╭──────────────────────────┨ LONE LISP TYPES ┠───────────────────────────╮
    │                                                                        │
    │    Lone implements dynamic data types as a tagged union.               │
@@ -146,6 +132,24 @@ enum lone_lisp_tag {
 	LONE_LISP_TAG_INLINE_BYTES_6 = 0xAD, /* length 6 */
 	LONE_LISP_TAG_INLINE_BYTES_7 = 0xAF, /* length 7 */
 
+	/* Packed symbol tags:
+	 *
+	 * 	bit 7 = 1
+	 * 	bits 4-6 = 011
+	 * 	bits 1-3 = length - 8
+	 * 	bit 0 = 1
+	 *
+	 * Symbols with 8 to 11 byte names drawn from
+	 * the packed symbol alphabet are encoded in the
+	 * word as 6 or 5 bit character codes. Two packed
+	 * symbols with identical names produce identical
+	 * words.
+	 */
+	LONE_LISP_TAG_PACKED_SYMBOL_8  = 0xB1, /* length 8  */
+	LONE_LISP_TAG_PACKED_SYMBOL_9  = 0xB3, /* length 9  */
+	LONE_LISP_TAG_PACKED_SYMBOL_10 = 0xB5, /* length 10 */
+	LONE_LISP_TAG_PACKED_SYMBOL_11 = 0xB7, /* length 11 */
+
 	/* Internal value tags: not exposed to lisp code.
 	 * Used as sentinels in internal data structures. */
 	LONE_LISP_TAG_TOMBSTONE = 0x29, /* dead table entry marker */
@@ -182,6 +186,23 @@ struct lone_lisp_value {
 	long tagged;
 };
 
+struct lone_lisp_reader {
+	int file_descriptor;
+	struct {
+		struct lone_bytes bytes;
+		struct {
+			size_t token;  /* input before it may be discarded */
+			size_t read;
+			size_t write;
+		} position;
+		struct lone_lisp_value mapping; /* values may reference the input, nil otherwise */
+	} buffer;
+	struct {
+		bool end_of_input: 1;
+		bool error: 1;
+	} status;
+};
+
 /* Returned by fallible functions.
  * `present` indicates whether
  * `value` is valid.
@@ -276,11 +297,13 @@ struct lone_lisp_text {
 	struct lone_bytes bytes;
 	lone_hash hash;
 	size_t code_point_count;
+	struct lone_lisp_value parent; /* slices only */
 };
 
 struct lone_lisp_bytes {
 	struct lone_bytes data;
 	lone_hash hash;
+	struct lone_lisp_value parent; /* slices only */
 };
 
 static_assert(offsetof(struct lone_lisp_text, hash) == offsetof(struct lone_lisp_symbol, hash),
@@ -352,6 +375,12 @@ struct lone_lisp_heap_value {
 		bool hash_cached: 1;
 		bool code_point_count_cached: 1;
 		bool shaped: 1;
+		bool weak_keys: 1;
+		bool weak_values: 1;
+		bool slice: 1;
+		bool mapped: 1;
+		bool descriptor: 1;
+		bool io_uring: 1;
 	};
 
 	enum lone_lisp_tag type; /* tag byte, set at allocation for GC sweep */
@@ -422,6 +451,7 @@ bool lone_lisp_is_bytes(struct lone_lisp *lone, struct lone_lisp_value value);
 bool lone_lisp_is_text(struct lone_lisp *lone, struct lone_lisp_value value);
 bool lone_lisp_is_symbol(struct lone_lisp *lone, struct lone_lisp_value value);
 bool lone_lisp_is_inline_symbol(struct lone_lisp_value value);
+bool lone_lisp_is_packed_symbol(struct lone_lisp_value value);
 bool lone_lisp_is_inline_text(struct lone_lisp_value value);
 bool lone_lisp_is_inline_bytes(struct lone_lisp_value value);
 bool lone_lisp_is_inline_value(struct lone_lisp_value value);
@@ -431,6 +461,7 @@ bool lone_lisp_is_tombstone(struct lone_lisp_value value);
  * The returned pointer points into the tagged word at the address
  * of the value parameter, so the caller must keep the value alive
  * for the lifetime of the returned struct lone_bytes.
+ * Packed symbols are not stored as bytes and are not supported.
  */
 struct lone_bytes lone_lisp_inline_value_bytes(struct lone_lisp_value *value);
 
@@ -439,6 +470,10 @@ struct lone_bytes lone_lisp_inline_value_bytes(struct lone_lisp_value *value);
  * For inline values, the returned pointer points into the tagged word
  * at the address of the value parameter, so the caller must keep
  * the value alive for the lifetime of the returned struct lone_bytes.
+ * Packed symbols are decoded into a ring of
+ * LONE_LISP_PACKED_SYMBOL_BUFFERS (8) buffers:
+ * their bytes are only valid until 8 more
+ * packed symbols have been decoded.
  */
 struct lone_bytes lone_lisp_bytes_of(struct lone_lisp *lone, struct lone_lisp_value *value);
 
@@ -473,6 +508,12 @@ struct lone_lisp_value lone_lisp_integer_from_pointer(void *pointer);
 struct lone_lisp_value lone_lisp_integer_parse(struct lone_lisp *lone,
 		unsigned char *digits, size_t count);
 
+/* Write the integer's digits, preceded by a minus sign if negative,
+ * into a buffer of at least LONE_LISP_INTEGER_FORMAT_SIZE bytes.
+ * Return the number of bytes written. */
+size_t lone_lisp_integer_format_decimal(lone_lisp_integer integer, unsigned char *buffer);
+size_t lone_lisp_integer_format_hexadecimal(lone_lisp_integer integer, unsigned char *buffer);
+
 struct lone_lisp_value lone_lisp_zero(void);
 struct lone_lisp_value lone_lisp_one(void);
 struct lone_lisp_value lone_lisp_minus_one(void);
@@ -554,6 +595,11 @@ struct lone_lisp_value lone_lisp_primitive_create(struct lone_lisp *lone, char *
 		lone_lisp_primitive_function function, struct lone_lisp_value closure,
 		struct lone_lisp_function_flags flags);
 
+/* Takes an already interned symbol as the name. */
+struct lone_lisp_value lone_lisp_primitive_create_named(struct lone_lisp *lone, struct lone_lisp_value name,
+		lone_lisp_primitive_function function, struct lone_lisp_value closure,
+		struct lone_lisp_function_flags flags);
+
 /* ╭────────────────────────────────────────────────────────────────────────╮
    │                                                                        │
    │    Lone continuations reify segments of the lisp machine stack         │
@@ -674,6 +720,16 @@ struct lone_lisp_value lone_lisp_table_create(struct lone_lisp *lone,
 struct lone_lisp_value lone_lisp_table_create_from_shape(struct lone_lisp *lone,
 		struct lone_lisp_value shape, struct lone_lisp_value prototype);
 
+/* Weak tables do not keep their keys or values alive.
+ * Entries whose weak key or weak value is otherwise
+ * unreachable are deleted by the garbage collector.
+ * Values under weak keys are kept alive only while
+ * their keys are reachable from elsewhere.
+ */
+struct lone_lisp_value lone_lisp_table_create_weak(struct lone_lisp *lone,
+		size_t capacity, struct lone_lisp_value prototype,
+		bool weak_keys, bool weak_values);
+
 struct lone_lisp_value lone_lisp_table_get(struct lone_lisp *lone, struct lone_lisp_value table,
 		struct lone_lisp_value key);
 
@@ -713,6 +769,7 @@ struct lone_lisp_value lone_lisp_shape_create(struct lone_lisp *lone,
    ╰────────────────────────────────────────────────────────────────────────╯ */
 
 struct lone_lisp_value lone_lisp_inline_symbol_create(unsigned char *bytes, size_t count);
+bool lone_lisp_packed_symbol_create(unsigned char *bytes, size_t count, struct lone_lisp_value *symbol);
 struct lone_lisp_value lone_lisp_inline_text_create(unsigned char *bytes, size_t count);
 struct lone_lisp_value lone_lisp_inline_bytes_create(unsigned char *bytes, size_t count);
 
@@ -750,6 +807,14 @@ struct lone_lisp_value lone_lisp_text_from_c_string(struct lone_lisp *lone,
 struct lone_lisp_value lone_lisp_text_to_symbol(struct lone_lisp *lone,
 		struct lone_lisp_value text);
 
+/* Returns a text sharing the bytes of another text.
+ * The range must be valid UTF-8 containing the given
+ * number of code points, starting inside the text.
+ */
+struct lone_lisp_value lone_lisp_text_slice(struct lone_lisp *lone,
+		struct lone_lisp_value text, unsigned char *start, size_t length,
+		size_t code_point_count);
+
 /* ╭────────────────────────────────────────────────────────────────────────╮
    │                                                                        │
    │    Lone bytes values can be created zero-filled for a given size       │
@@ -773,6 +838,24 @@ struct lone_lisp_value lone_lisp_text_to_symbol(struct lone_lisp *lone,
    │    Transferred buffers should also contain that null byte              │
    │    but the lone bytes type currently has no way to enforce this.       │
    │                                                                        │
+   │    Slices are views into the memory of another bytes or text value     │
+   │    which they keep alive. They own nothing and are never null          │
+   │    terminated. A slice of mutable bytes aliases them: writes through   │
+   │    either are visible through the other. Freezing such a slice first   │
+   │    copies its bytes so that frozen values never change. Slices of      │
+   │    frozen values are frozen and are never copied. System calls get     │
+   │    temporary null terminated copies of text slices. Bytes slices are   │
+   │    passed in place so that the kernel reads into the parent memory.    │
+   │                                                                        │
+   │    Mapped bytes own a memory mapping instead of an allocation. It      │
+   │    is one byte longer so that they are null terminated too and is      │
+   │    unmapped when they are garbage collected. Their slices keep the     │
+   │    whole mapping alive. Mappings shared with other processes can       │
+   │    change even if the bytes are frozen.                                │
+   │                                                                        │
+   │    Descriptor bytes hold a file descriptor which is closed when        │
+   │    they are garbage collected unless it has been released first.       │
+   │                                                                        │
    ╰────────────────────────────────────────────────────────────────────────╯ */
 
 struct lone_lisp_value lone_lisp_bytes_transfer(struct lone_lisp *lone,
@@ -787,6 +870,21 @@ struct lone_lisp_value lone_lisp_bytes_copy(struct lone_lisp *lone,
 struct lone_lisp_value lone_lisp_bytes_create(struct lone_lisp *lone,
 		size_t count);
 
+struct lone_lisp_value lone_lisp_bytes_slice(struct lone_lisp *lone,
+		struct lone_lisp_value bytes, size_t start, size_t count);
+
+void lone_lisp_slice_detach(struct lone_lisp *lone, struct lone_lisp_value slice);
+
+struct lone_lisp_value lone_lisp_bytes_map(struct lone_lisp *lone,
+		void *mapping, size_t count, bool frozen);
+
+struct lone_lisp_value lone_lisp_bytes_mmap(struct lone_lisp *lone,
+		size_t count, int protection, int flags, int fd, bool frozen);
+
+struct lone_lisp_value lone_lisp_bytes_descriptor(struct lone_lisp *lone, int file_descriptor);
+int lone_lisp_bytes_descriptor_of(struct lone_lisp *lone, struct lone_lisp_value bytes);
+void lone_lisp_bytes_descriptor_close(struct lone_lisp *lone, struct lone_lisp_value bytes);
+
 /* ╭───────────────────────┨ LONE LISP INTERPRETER ┠────────────────────────╮
    │                                                                        │
    │    The lone lisp interpreter is composed of all internal state         │
@@ -814,6 +912,7 @@ enum lone_lisp_machine_step {
 	LONE_LISP_MACHINE_STEP_LOAD_EXPRESSION,
 	LONE_LISP_MACHINE_STEP_LOAD_APPLICABLE,
 	LONE_LISP_MACHINE_STEP_LOAD_LIST,
+	LONE_LISP_MACHINE_STEP_INTERRUPT_RETURN,
 	LONE_LISP_MACHINE_STEP_HALT,
 };
 
@@ -842,6 +941,11 @@ struct lone_lisp_machine {
 	struct lone_lisp_value applicable;  /* value to which arguments will be applied */
 	struct lone_lisp_value list;        /* accumulated results of evaluation of multiple expressions */
 	struct lone_lisp_value unevaluated; /* remaining expressions queued for evaluation */
+
+	struct {
+		struct lone_lisp_value task;        /* generator which may be preempted */
+		long budget;                        /* lists it may still begin to evaluate */
+	} preemption;
 };
 
 /* ╭────────────────────┨ LONE LISP MEMORY ALLOCATION ┠─────────────────────╮
@@ -854,11 +958,16 @@ struct lone_lisp_machine {
    │    is greatly simplified to the point efficient reallocation is        │
    │    provided by Linux itself via mremap.                                │
    │                                                                        │
-   │    Three separate bitmaps track per-value metadata:                    │
+   │    Four separate bitmaps track per-value metadata:                     │
    │                                                                        │
-   │      ◦ live   - whether the value is allocated and in use              │
-   │      ◦ marked - whether the value is reachable                         │
-   │      ◦ pinned - whether the value cannot move during compaction        │
+   │      ◦ live     - whether the value is allocated and in use            │
+   │      ◦ marked   - whether the value is reachable                       │
+   │      ◦ pinned   - whether the value cannot move during compaction      │
+   │      ◦ printing - whether the printer is inside the value              │
+   │                                                                        │
+   │    Keeping them outside the values means that neither collecting       │
+   │    nor printing writes to the values themselves, whose pages may       │
+   │    be shared copy-on-write with other processes.                       │
    │                                                                        │
    │    The bitmaps are word-aligned mmap'd pages that grow                 │
    │    in tandem with the values array via mremap.                         │
@@ -893,30 +1002,103 @@ struct lone_lisp_heap {
 	size_t capacity;
 	size_t count;
 	size_t first_dead;
+	size_t shared;  /* values below this index are inherited copy-on-write from a forking process */
+	size_t rings;   /* unreleased io_uring rings, finalized when unreachable */
 	struct lone_lisp_heap_value *values;
 
 	struct {
 		void *live;
 		void *marked;
 		void *pinned;
+		void *printing;
 	} bits;
+
+	/* indices of the weak tables marked during the current collection */
+	struct {
+		size_t *indices;
+		size_t count;
+		size_t capacity;
+	} weak;
+};
+
+/* Bump allocated arena of interned symbol names.
+ * Each name is preceded by a header recording the heap
+ * index of the owning symbol so that the garbage collector
+ * can find and compact live names in address order.
+ */
+struct lone_lisp_names {
+	unsigned char *base;
+	size_t used;
+	size_t capacity;
+};
+
+struct lone_lisp_name_header {
+	size_t index;
+	size_t count;
+};
+
+/* Buffered output to a file descriptor.
+ * Unused streams have a negative file descriptor.
+ * The buffer is allocated when the stream is opened.
+ */
+enum lone_lisp_output_buffering {
+	LONE_LISP_OUTPUT_UNBUFFERED,
+	LONE_LISP_OUTPUT_LINE_BUFFERED,
+	LONE_LISP_OUTPUT_FULLY_BUFFERED,
+};
+
+struct lone_lisp_output {
+	int file_descriptor;
+	enum lone_lisp_output_buffering buffering;
+	struct lone_bytes buffer;
+	size_t used;
+};
+
+/* Limits on the output of the printer.
+ * Containers nested deeper than the depth limit
+ * and elements beyond the length limit are elided.
+ * Zero means unlimited.
+ */
+struct lone_lisp_print_limits {
+	size_t depth;
+	size_t length;
 };
 
 struct lone_lisp {
 	struct lone_system *system;
 	void *native_stack;
+	struct lone_hash_siphash_key hash_key;
 	struct lone_lisp_heap heap;
 	struct lone_lisp_value symbol_table;
+	struct {
+		struct lone_lisp_value table;
+		bool literals;
+	} hash_cons;
+	struct lone_lisp_output outputs[LONE_LISP_OUTPUT_STREAMS];
+	struct lone_lisp_print_limits print_limits;
 	struct {
 		struct lone_lisp_value loaded;
 		struct lone_lisp_value embedded;
 		struct lone_lisp_value null;
 		struct lone_lisp_value top_level_environment;
 		struct lone_lisp_value path;
+		struct lone_lisp_value directories;  /* O_PATH descriptors of path */
+		struct lone_lisp_value packages;     /* package → directory descriptors */
 		struct lone_lisp_value signal_primitive;
 	} modules;
+	struct {
+		struct lone_lisp_value handlers;     /* signal number → handler */
+		int descriptor;                      /* read end of the self-pipe */
+	} interrupts;
 
 	struct {
+		struct lone_lisp_names names;
+
+		struct {
+			unsigned char buffers[LONE_LISP_PACKED_SYMBOL_BUFFERS][LONE_LISP_PACKED_SYMBOL_MAX_LENGTH + 1];
+			unsigned int next;
+		} packed;
+
 		struct {
 			struct lone_lisp_value type_error;
 			struct lone_lisp_value arity_error;
@@ -929,6 +1111,7 @@ struct lone_lisp {
 			struct lone_lisp_value generator_exhausted;
 			struct lone_lisp_value generator_reentry;
 			struct lone_lisp_value iteration_invalidated;
+			struct lone_lisp_value read_error;
 		} tags;
 	} symbols;
 };
@@ -233,4 +233,12 @@ bool lone_test_assert_u64_equal(struct lone_test_suite *suite,
 bool lone_test_assert_u64_not_equal(struct lone_test_suite *suite,
 		struct lone_test_case *test, lone_u64 x, lone_u64 y);
 
+/* Benchmarks report timings as extra lines in the test output:
+ *
+ *     BENCHMARK <name> <method> <microseconds> us <rate> <unit>/s
+ *
+ * The rate is the amount processed, in millions of units per second. */
+lone_u64 lone_test_benchmark_nanoseconds(void);
+void lone_test_benchmark_report(char *name, char *method, lone_u64 elapsed, lone_u64 amount, char *unit);
+
 #endif /* LONE_TEST_HEADER */
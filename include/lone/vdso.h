@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#ifndef LONE_VDSO_HEADER
+#define LONE_VDSO_HEADER
+
+#include <linux/time_types.h>
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/elf.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    The virtual dynamic shared object is an ELF image which Linux       │
+   │    maps into every process. It contains implementations of some        │
+   │    system calls which read kernel maintained data directly from        │
+   │    user space without the cost of entering the kernel.                 │
+   │                                                                        │
+   │    Its address is passed in the auxiliary vector. Functions are        │
+   │    located by name through its dynamic symbol table. Any function      │
+   │    that is not present is left null and callers must fall back to      │
+   │    the equivalent system call.                                         │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+typedef int (*lone_vdso_clock_gettime_function)(int clock, struct __kernel_timespec *time);
+typedef int (*lone_vdso_gettimeofday_function)(struct __kernel_old_timeval *time, void *timezone);
+typedef int (*lone_vdso_getcpu_function)(unsigned int *cpu, unsigned int *node, void *cache);
+
+struct lone_vdso {
+	lone_vdso_clock_gettime_function clock_gettime;
+	lone_vdso_gettimeofday_function gettimeofday;
+	lone_vdso_getcpu_function getcpu;
+};
+
+void lone_vdso_initialize(struct lone_vdso *vdso, struct lone_auxiliary_vector *auxiliary_vector);
+void *lone_vdso_symbol(lone_elf_native_header *header, char *name);
+
+#endif /* LONE_VDSO_HEADER */
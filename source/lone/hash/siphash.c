@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: AGPL-3.0-or-later */
 
 #include <lone/hash/siphash.h>
+#include <lone/definitions.h>
 #include <lone/types.h>
 
 static lone_u64 lone_hash_siphash_rotate_left(lone_u64 x, int b)
@@ -8,42 +9,66 @@ static lone_u64 lone_hash_siphash_rotate_left(lone_u64 x, int b)
 	return (x << b) | (b? (x >> (64 - b)) : 0);
 }
 
-#define SIPROUND do {                                                                              \
-    state->v0 += state->v1;                                                                        \
-    state->v1 = lone_hash_siphash_rotate_left(state->v1, 13);                                      \
-    state->v1 ^= state->v0;                                                                        \
-    state->v0 = lone_hash_siphash_rotate_left(state->v0, 32);                                      \
-    state->v2 += state->v3;                                                                        \
-    state->v3 = lone_hash_siphash_rotate_left(state->v3, 16);                                      \
-    state->v3 ^= state->v2;                                                                        \
-    state->v0 += state->v3;                                                                        \
-    state->v3 = lone_hash_siphash_rotate_left(state->v3, 21);                                      \
-    state->v3 ^= state->v0;                                                                        \
-    state->v2 += state->v1;                                                                        \
-    state->v1 = lone_hash_siphash_rotate_left(state->v1, 17);                                      \
-    state->v1 ^= state->v2;                                                                        \
-    state->v2 = lone_hash_siphash_rotate_left(state->v2, 32);                                      \
+#define SIPROUND(v0, v1, v2, v3) do {                                                              \
+    (v0) += (v1);                                                                                  \
+    (v1) = lone_hash_siphash_rotate_left((v1), 13);                                                \
+    (v1) ^= (v0);                                                                                  \
+    (v0) = lone_hash_siphash_rotate_left((v0), 32);                                                \
+    (v2) += (v3);                                                                                  \
+    (v3) = lone_hash_siphash_rotate_left((v3), 16);                                                \
+    (v3) ^= (v2);                                                                                  \
+    (v0) += (v3);                                                                                  \
+    (v3) = lone_hash_siphash_rotate_left((v3), 21);                                                \
+    (v3) ^= (v0);                                                                                  \
+    (v2) += (v1);                                                                                  \
+    (v1) = lone_hash_siphash_rotate_left((v1), 17);                                                \
+    (v1) ^= (v2);                                                                                  \
+    (v2) = lone_hash_siphash_rotate_left((v2), 32);                                                \
+} while (0)
+
+#define SIPROUNDS(count, v0, v1, v2, v3) do {                                                      \
+    int round_;                                                                                    \
+    for (round_ = 0; round_ < (count); ++round_) {                                                 \
+        SIPROUND(v0, v1, v2, v3);                                                                  \
+    }                                                                                              \
 } while (0)
 
 static void lone_hash_siphash_compress(struct lone_hash_siphash_state *state, lone_u64 m)
 {
 	state->v3 ^= m;
-	SIPROUND;
-	SIPROUND;
+	SIPROUNDS(LONE_HASH_SIPHASH_COMPRESSION_ROUNDS, state->v0, state->v1, state->v2, state->v3);
 	state->v0 ^= m;
 }
 
-void lone_hash_siphash_initialize(struct lone_hash_siphash_state *state,
+void lone_hash_siphash_key_initialize(struct lone_hash_siphash_key *key,
 		lone_u64 k0, lone_u64 k1)
 {
-	state->v0       = k0 ^ 0x736f6d6570736575UL;
-	state->v1       = k1 ^ 0x646f72616e646f6dUL;
-	state->v2       = k0 ^ 0x6c7967656e657261UL;
-	state->v3       = k1 ^ 0x7465646279746573UL;
+	key->v0 = k0 ^ 0x736f6d6570736575UL;
+	key->v1 = k1 ^ 0x646f72616e646f6dUL;
+	key->v2 = k0 ^ 0x6c7967656e657261UL;
+	key->v3 = k1 ^ 0x7465646279746573UL;
+}
+
+void lone_hash_siphash_initialize_from_key(struct lone_hash_siphash_state *state,
+		const struct lone_hash_siphash_key *key)
+{
+	state->v0       = key->v0;
+	state->v1       = key->v1;
+	state->v2       = key->v2;
+	state->v3       = key->v3;
 	state->buffered = 0;
 	state->total    = 0;
 }
 
+void lone_hash_siphash_initialize(struct lone_hash_siphash_state *state,
+		lone_u64 k0, lone_u64 k1)
+{
+	struct lone_hash_siphash_key key;
+
+	lone_hash_siphash_key_initialize(&key, k0, k1);
+	lone_hash_siphash_initialize_from_key(state, &key);
+}
+
 void lone_hash_siphash_update(struct lone_hash_siphash_state *state, struct lone_bytes data)
 {
 	const unsigned char *p = data.pointer;
@@ -93,14 +118,70 @@ lone_u64 lone_hash_siphash_finish(struct lone_hash_siphash_state *state)
 	lone_hash_siphash_compress(state, b);
 
 	state->v2 ^= 0xff;
-	SIPROUND;
-	SIPROUND;
-	SIPROUND;
-	SIPROUND;
+	SIPROUNDS(LONE_HASH_SIPHASH_FINALIZATION_ROUNDS, state->v0, state->v1, state->v2, state->v3);
 
 	return state->v0 ^ state->v1 ^ state->v2 ^ state->v3;
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Single shot hashing of a one byte prefix followed by a short key.   │
+   │                                                                        │
+   │    Produces the same result as initializing a state from the key,      │
+   │    updating it with the prefix byte and then with the data.            │
+   │    The message is staged in a zero padded local block so that          │
+   │    every word is read whole and the state lives in locals,             │
+   │    with no partial block bookkeeping.                                  │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+lone_u64 lone_hash_siphash_prefixed(const struct lone_hash_siphash_key *key,
+		unsigned char prefix, struct lone_bytes data)
+{
+	unsigned char block[LONE_HASH_SIPHASH_SHORT_MAXIMUM + 8];
+	lone_u64 v0, v1, v2, v3, m;
+	size_t total, words, i;
+
+	if (data.count > LONE_HASH_SIPHASH_SHORT_MAXIMUM) {
+		struct lone_hash_siphash_state state;
+		struct lone_bytes bytes = { .count = 1, .pointer = &prefix };
+
+		lone_hash_siphash_initialize_from_key(&state, key);
+		lone_hash_siphash_update(&state, bytes);
+		lone_hash_siphash_update(&state, data);
+		return lone_hash_siphash_finish(&state);
+	}
+
+	total = data.count + 1;
+	words = total / 8;
+
+	block[0] = prefix;
+	for (i = 0; i < data.count; ++i) { block[i + 1] = data.pointer[i]; }
+	for (i = total; i < (words + 1) * 8; ++i) { block[i] = 0; }
+
+	v0 = key->v0;
+	v1 = key->v1;
+	v2 = key->v2;
+	v3 = key->v3;
+
+	for (i = 0; i < words; ++i) {
+		m = lone_u64le_read(block + i * 8);
+		v3 ^= m;
+		SIPROUNDS(LONE_HASH_SIPHASH_COMPRESSION_ROUNDS, v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	m = lone_u64le_read(block + words * 8) | (((lone_u64) total & 0xff) << 56);
+	v3 ^= m;
+	SIPROUNDS(LONE_HASH_SIPHASH_COMPRESSION_ROUNDS, v0, v1, v2, v3);
+	v0 ^= m;
+
+	v2 ^= 0xff;
+	SIPROUNDS(LONE_HASH_SIPHASH_FINALIZATION_ROUNDS, v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+#undef SIPROUNDS
 #undef SIPROUND
 
 lone_u64 lone_hash_siphash(struct lone_bytes data, lone_u64 k0, lone_u64 k1)
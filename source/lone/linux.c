@@ -15,6 +15,21 @@ long linux_openat(int dirfd, unsigned char *path, int flags)
 	return linux_system_call_4(__NR_openat, dirfd, (long) path, flags, 0);
 }
 
+long linux_openat_mode(int dirfd, unsigned char *path, int flags, int mode)
+{
+	return linux_system_call_4(__NR_openat, dirfd, (long) path, flags, mode);
+}
+
+long linux_renameat(int old_dirfd, unsigned char *old_path, int new_dirfd, unsigned char *new_path)
+{
+	return linux_system_call_5(__NR_renameat2, old_dirfd, (long) old_path, new_dirfd, (long) new_path, 0);
+}
+
+long linux_unlinkat(int dirfd, unsigned char *path, int flags)
+{
+	return linux_system_call_3(__NR_unlinkat, dirfd, (long) path, flags);
+}
+
 long linux_pipe2(int fds[2], int flags)
 {
 	return linux_system_call_2(__NR_pipe2, (long) fds, flags);
@@ -25,6 +40,22 @@ long linux_close(int fd)
 	return linux_system_call_1(__NR_close, fd);
 }
 
+long linux_dup3(int old, int new, int flags)
+{
+	return linux_system_call_3(__NR_dup3, old, new, flags);
+}
+
+long linux_fork(void)
+{
+	/* fork does not exist on every architecture */
+	return linux_system_call_5(__NR_clone, SIGCHLD, 0, 0, 0, 0);
+}
+
+long linux_getpid(void)
+{
+	return linux_system_call_0(__NR_getpid);
+}
+
 long linux_fstat(int fd, struct stat *buffer)
 {
 	return linux_system_call_2(__NR_fstat, fd, (long) buffer);
@@ -41,7 +72,7 @@ ssize_t linux_read_once(int fd, struct lone_bytes buffer)
 
 	do {
 		result = linux_read(fd, buffer.pointer, buffer.count);
-	} while (result == -EINTR || result == -EAGAIN);
+	} while (result == -EINTR);
 
 	return result;
 }
@@ -97,6 +128,11 @@ ssize_t linux_write_bytes(int fd, struct lone_bytes buffer)
 	return (ssize_t) total;
 }
 
+ssize_t linux_writev(int fd, const struct iovec *vectors, int count)
+{
+	return linux_system_call_3(__NR_writev, fd, (long) vectors, (long) count);
+}
+
 off_t linux_lseek(int fd, off_t offset, int origin)
 {
 	return linux_system_call_3(__NR_lseek, fd, (long) offset, (long) origin);
@@ -117,6 +153,36 @@ int linux_munmap(void *address, size_t length)
 	return linux_system_call_2(__NR_munmap, (long) address, (long) length);
 }
 
+int linux_msync(void *address, size_t length, int flags)
+{
+	return linux_system_call_3(__NR_msync, (long) address, (long) length, flags);
+}
+
+int linux_madvise(void *address, size_t length, int advice)
+{
+	return linux_system_call_3(__NR_madvise, (long) address, (long) length, advice);
+}
+
+long linux_sendfile(int out, int in, __kernel_loff_t *offset, size_t count)
+{
+	return linux_system_call_4(__NR_sendfile, out, in, (long) offset, (long) count);
+}
+
+long linux_splice(int in, __kernel_loff_t *in_offset, int out, __kernel_loff_t *out_offset, size_t count, unsigned int flags)
+{
+	return linux_system_call_6(__NR_splice, in, (long) in_offset, out, (long) out_offset, (long) count, flags);
+}
+
+long linux_tee(int in, int out, size_t count, unsigned int flags)
+{
+	return linux_system_call_4(__NR_tee, in, out, (long) count, flags);
+}
+
+long linux_copy_file_range(int in, __kernel_loff_t *in_offset, int out, __kernel_loff_t *out_offset, size_t count, unsigned int flags)
+{
+	return linux_system_call_6(__NR_copy_file_range, in, (long) in_offset, out, (long) out_offset, (long) count, flags);
+}
+
 intptr_t linux_mremap(void *address, size_t old_length, size_t new_length, unsigned long flags, void *new_address)
 {
 	return linux_system_call_5(
@@ -144,3 +210,76 @@ long linux_dev_urandom(struct lone_bytes buffer)
 	if ((size_t) result < buffer.count) { return -EIO; }
 	return 0;
 }
+
+long linux_ioctl(int fd, unsigned long request, void *argument)
+{
+	return linux_system_call_3(__NR_ioctl, fd, (long) request, (long) argument);
+}
+
+long linux_clock_gettime(int clock, struct __kernel_timespec *time)
+{
+	return linux_system_call_2(__NR_clock_gettime, clock, (long) time);
+}
+
+long linux_rt_sigaction(int signal, const struct sigaction *action, struct sigaction *old)
+{
+	return linux_system_call_4(__NR_rt_sigaction, signal, (long) action, (long) old, sizeof(sigset_t));
+}
+
+long linux_getcpu(unsigned int *cpu, unsigned int *node)
+{
+	return linux_system_call_3(__NR_getcpu, (long) cpu, (long) node, 0);
+}
+
+long linux_timerfd_create(int clock, int flags)
+{
+	return linux_system_call_2(__NR_timerfd_create, clock, flags);
+}
+
+long linux_timerfd_settime(int fd, int flags, const struct __kernel_itimerspec *value, struct __kernel_itimerspec *old)
+{
+	return linux_system_call_4(__NR_timerfd_settime, fd, flags, (long) value, (long) old);
+}
+
+long linux_poll_one(int fd, short events, int timeout)
+{
+	struct pollfd descriptor = { .fd = fd, .events = events, .revents = 0 };
+	struct __kernel_timespec time, *pointer;
+
+	pointer = 0;
+
+	if (timeout >= 0) {
+		time.tv_sec  = timeout / 1000;
+		time.tv_nsec = (timeout % 1000) * 1000000L;
+		pointer = &time;
+	}
+
+	/* poll does not exist on every architecture */
+	return linux_system_call_5(__NR_ppoll, (long) &descriptor, 1, (long) pointer, 0, 0);
+}
+
+long linux_epoll_create1(int flags)
+{
+	return linux_system_call_1(__NR_epoll_create1, flags);
+}
+
+long linux_epoll_ctl(int epoll, int operation, int fd, struct epoll_event *event)
+{
+	return linux_system_call_4(__NR_epoll_ctl, epoll, operation, fd, (long) event);
+}
+
+long linux_epoll_wait(int epoll, struct epoll_event *events, int count, int timeout)
+{
+	/* epoll_wait does not exist on every architecture */
+	return linux_system_call_6(__NR_epoll_pwait, epoll, (long) events, count, timeout, 0, 0);
+}
+
+long linux_io_uring_setup(unsigned int entries, struct io_uring_params *parameters)
+{
+	return linux_system_call_2(__NR_io_uring_setup, entries, (long) parameters);
+}
+
+long linux_io_uring_enter(int ring, unsigned int submit, unsigned int wait, unsigned int flags)
+{
+	return linux_system_call_6(__NR_io_uring_enter, ring, submit, wait, flags, 0, 0);
+}
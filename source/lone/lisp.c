@@ -3,6 +3,10 @@
 #include <lone/lisp.h>
 #include <lone/lisp/heap.h>
 #include <lone/lisp/module.h>
+#include <lone/lisp/hash.h>
+#include <lone/lisp/names.h>
+#include <lone/lisp/hash_cons.h>
+#include <lone/lisp/output.h>
 
 #include <lone/memory/array.h>
 
@@ -14,20 +18,33 @@ void lone_lisp_initialize(struct lone_lisp *lone, struct lone_system *system, vo
 	lone->system = system;
 	lone->native_stack = native_stack;
 
+	lone_lisp_hash_initialize(lone);
 	lone_lisp_heap_initialize(lone);
+	lone_lisp_names_initialize(lone);
+	lone->symbols.packed.next = 0;
 
 	/* system, memory, stack and heap initialized
 	 * can now use lisp value creation functions
 	 */
 
-	lone->symbol_table = lone_lisp_table_create(lone, 256, lone_lisp_nil());
+	/* weak: symbols referenced by nothing else are collected */
+	lone->symbol_table = lone_lisp_table_create_weak(lone, 256, lone_lisp_nil(), true, true);
+	lone_lisp_hash_cons_initialize(lone);
+	lone_lisp_output_initialize(lone);
+	lone->print_limits.depth = LONE_LISP_PRINT_DEPTH_LIMIT;
+	lone->print_limits.length = LONE_LISP_PRINT_LENGTH_LIMIT;
 
 	lone->modules.loaded = lone_lisp_table_create(lone, 32, lone_lisp_nil());
 	lone->modules.embedded = lone_lisp_nil();
 	lone->modules.top_level_environment = lone_lisp_table_create(lone, 8, lone_lisp_nil());
 	lone->modules.path = lone_lisp_vector_create(lone, 8);
+	lone->modules.directories = lone_lisp_vector_create(lone, 8);
+	lone->modules.packages = lone_lisp_table_create(lone, 16, lone_lisp_nil());
 	lone->modules.signal_primitive = lone_lisp_nil();
 
+	lone->interrupts.handlers = lone_lisp_table_create(lone, 8, lone_lisp_nil());
+	lone->interrupts.descriptor = -1;
+
 	lone->symbols.tags.type_error             = lone_lisp_intern_c_string(lone, "type-error");
 	lone->symbols.tags.arity_error            = lone_lisp_intern_c_string(lone, "arity-error");
 	lone->symbols.tags.integer_overflow       = lone_lisp_intern_c_string(lone, "integer-overflow");
@@ -39,6 +56,7 @@ void lone_lisp_initialize(struct lone_lisp *lone, struct lone_system *system, vo
 	lone->symbols.tags.generator_exhausted    = lone_lisp_intern_c_string(lone, "generator-exhausted");
 	lone->symbols.tags.generator_reentry      = lone_lisp_intern_c_string(lone, "generator-reentry");
 	lone->symbols.tags.iteration_invalidated  = lone_lisp_intern_c_string(lone, "iteration-invalidated");
+	lone->symbols.tags.read_error             = lone_lisp_intern_c_string(lone, "read-error");
 
 	import = lone_lisp_primitive_create(lone, "import", lone_lisp_primitive_module_import, lone_lisp_nil(), flags);
 	export = lone_lisp_primitive_create(lone, "export", lone_lisp_primitive_module_export, lone_lisp_nil(), flags);
@@ -0,0 +1,578 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/cache.h>
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/hash_cons.h>
+
+#include <lone/hash/siphash.h>
+
+#include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
+
+#define LONE_LISP_CACHE_MAGIC        "\177lonelc\001"
+#define LONE_LISP_CACHE_MAGIC_SIZE   8
+#define LONE_LISP_CACHE_HEADER_SIZE  (LONE_LISP_CACHE_MAGIC_SIZE + 7 * sizeof(lone_u64))
+
+/* Fixed keys: hashes must be stable across processes. */
+#define LONE_LISP_CACHE_HASH_K0      0x6c6f6e652d6c6973UL
+#define LONE_LISP_CACHE_HASH_K1      0x702d636163686521UL
+
+enum lone_lisp_cache_tag {
+	LONE_LISP_CACHE_TAG_END = 0,
+	LONE_LISP_CACHE_TAG_NIL,
+	LONE_LISP_CACHE_TAG_INTEGER,
+	LONE_LISP_CACHE_TAG_SYMBOL,
+	LONE_LISP_CACHE_TAG_TEXT,
+	LONE_LISP_CACHE_TAG_BYTES,
+	LONE_LISP_CACHE_TAG_LIST,
+	LONE_LISP_CACHE_TAG_DOT,
+	LONE_LISP_CACHE_TAG_VECTOR,
+	LONE_LISP_CACHE_TAG_TABLE,
+};
+
+static lone_u64 lone_lisp_cache_hash(struct lone_bytes bytes)
+{
+	return lone_hash_siphash(bytes, LONE_LISP_CACHE_HASH_K0, LONE_LISP_CACHE_HASH_K1);
+}
+
+void lone_lisp_cache_source_of(struct lone_lisp_cache_source *source,
+		struct stat *status, struct lone_bytes contents)
+{
+	source->size        = (lone_u64) status->st_size;
+	source->seconds     = (lone_s64) status->st_mtime;
+	source->nanoseconds = (lone_u64) status->st_mtime_nsec;
+	source->hash        = lone_lisp_cache_hash(contents);
+}
+
+/* Appends "c" to the source path: module.ln → module.lnc
+ * The suffix argument allows naming the temporary file. */
+static unsigned char *lone_lisp_cache_path(struct lone_lisp *lone, struct lone_bytes path,
+		char *suffix, size_t *allocated)
+{
+	unsigned char *cache;
+	size_t length;
+
+	length = lone_c_string_length(suffix);
+	*allocated = path.count + length + 1;
+	cache = lone_memory_allocate(lone->system, *allocated, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+
+	lone_memory_move(path.pointer, cache, path.count);
+	lone_memory_move(suffix, cache + path.count, length);
+	cache[path.count + length] = '\0';
+
+	return cache;
+}
+
+/* Writes c.<pid>.tmp: concurrent writers never share temporary files. */
+static void lone_lisp_cache_temporary_suffix(char suffix[32])
+{
+	char digits[20];
+	size_t i, count;
+	long pid;
+
+	pid = linux_getpid();
+	count = 0;
+
+	do {
+		digits[count++] = (char) ('0' + pid % 10);
+		pid /= 10;
+	} while (pid > 0);
+
+	i = 0;
+	suffix[i++] = 'c';
+	suffix[i++] = '.';
+	while (count) { suffix[i++] = digits[--count]; }
+	lone_memory_move(".tmp", suffix + i, sizeof(".tmp"));
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Encoder.                                                            │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+void lone_lisp_cache_writer_initialize(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer)
+{
+	writer->buffer.count = LONE_LISP_BUFFER_SIZE;
+	writer->buffer.pointer = lone_memory_allocate(lone->system, writer->buffer.count, 1, 1,
+			LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+	writer->used = LONE_LISP_CACHE_HEADER_SIZE;    /* header is filled in when stored */
+	writer->forms = 0;
+	writer->depth = 0;
+	writer->failed = false;
+}
+
+void lone_lisp_cache_writer_finalize(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer)
+{
+	lone_memory_deallocate(lone->system, writer->buffer.pointer, writer->buffer.count, 1, 1);
+	writer->buffer.pointer = 0;
+	writer->buffer.count = 0;
+}
+
+static void lone_lisp_cache_emit(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		void *bytes, size_t count)
+{
+	size_t old_count, new_count;
+
+	new_count = writer->buffer.count;
+
+	while (new_count - writer->used < count) {
+		if (__builtin_mul_overflow(new_count, (size_t) 2, &new_count)) { linux_exit(-1); }
+	}
+
+	if (new_count != writer->buffer.count) {
+		old_count = writer->buffer.count;
+		writer->buffer.pointer = lone_memory_reallocate(
+			lone->system, writer->buffer.pointer,
+			old_count, 1,
+			new_count, 1,
+			1,
+			LONE_MEMORY_ALLOCATION_FLAGS_NONE
+		);
+		writer->buffer.count = new_count;
+	}
+
+	lone_memory_move(bytes, writer->buffer.pointer + writer->used, count);
+	writer->used += count;
+}
+
+static void lone_lisp_cache_emit_tag(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		enum lone_lisp_cache_tag tag)
+{
+	unsigned char byte = (unsigned char) tag;
+	lone_lisp_cache_emit(lone, writer, &byte, 1);
+}
+
+static void lone_lisp_cache_emit_unsigned(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		lone_u64 n)
+{
+	unsigned char bytes[10];
+	size_t count;
+
+	count = 0;
+
+	do {
+		bytes[count] = n & 0x7F;
+		n >>= 7;
+		if (n) { bytes[count] |= 0x80; }
+		++count;
+	} while (n);
+
+	lone_lisp_cache_emit(lone, writer, bytes, count);
+}
+
+static void lone_lisp_cache_emit_bytes(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		enum lone_lisp_cache_tag tag, struct lone_bytes bytes)
+{
+	lone_lisp_cache_emit_tag(lone, writer, tag);
+	lone_lisp_cache_emit_unsigned(lone, writer, bytes.count);
+	lone_lisp_cache_emit(lone, writer, bytes.pointer, bytes.count);
+}
+
+static void lone_lisp_cache_emit_value(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		struct lone_lisp_value value)
+{
+	struct lone_lisp_table_entry entry;
+	struct lone_lisp_value element;
+	long integer;
+	size_t i;
+
+	if (writer->failed) { return; }
+
+	if (writer->depth == LONE_LISP_CACHE_DEPTH_LIMIT) {
+		/* too deep to decode */
+		writer->failed = true;
+		return;
+	}
+
+	++writer->depth;
+
+	switch (lone_lisp_type_of(value)) {
+	case LONE_LISP_TAG_NIL:
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_NIL);
+		break;
+	case LONE_LISP_TAG_INTEGER:
+		integer = lone_lisp_integer_of(value);
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_INTEGER);
+		lone_lisp_cache_emit_unsigned(lone, writer,
+				((lone_u64) integer << 1) ^ (lone_u64) (integer >> 63));
+		break;
+	case LONE_LISP_TAG_SYMBOL:
+		lone_lisp_cache_emit_bytes(lone, writer, LONE_LISP_CACHE_TAG_SYMBOL, lone_lisp_bytes_of(lone, &value));
+		break;
+	case LONE_LISP_TAG_TEXT:
+		lone_lisp_cache_emit_bytes(lone, writer, LONE_LISP_CACHE_TAG_TEXT, lone_lisp_bytes_of(lone, &value));
+		break;
+	case LONE_LISP_TAG_BYTES:
+		lone_lisp_cache_emit_bytes(lone, writer, LONE_LISP_CACHE_TAG_BYTES, lone_lisp_bytes_of(lone, &value));
+		break;
+	case LONE_LISP_TAG_LIST:
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_LIST);
+
+		while (1) {
+			lone_lisp_cache_emit_value(lone, writer, lone_lisp_list_first(lone, value));
+			value = lone_lisp_list_rest(lone, value);
+
+			if (lone_lisp_is_nil(value)) {
+				lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_END);
+				break;
+			} else if (!lone_lisp_is_list(lone, value)) {
+				lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_DOT);
+				lone_lisp_cache_emit_value(lone, writer, value);
+				break;
+			}
+		}
+		break;
+	case LONE_LISP_TAG_VECTOR:
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_VECTOR);
+		LONE_LISP_VECTOR_FOR_EACH(lone, element, value, i) {
+			lone_lisp_cache_emit_value(lone, writer, element);
+		}
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_END);
+		break;
+	case LONE_LISP_TAG_TABLE:
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_TABLE);
+		LONE_LISP_TABLE_FOR_EACH(lone, entry, value, i) {
+			lone_lisp_cache_emit_value(lone, writer, entry.key);
+			lone_lisp_cache_emit_value(lone, writer, entry.value);
+		}
+		lone_lisp_cache_emit_tag(lone, writer, LONE_LISP_CACHE_TAG_END);
+		break;
+	default:
+		/* not produced by the reader */
+		writer->failed = true;
+		break;
+	}
+
+	--writer->depth;
+}
+
+void lone_lisp_cache_writer_append(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		struct lone_lisp_value form)
+{
+	lone_lisp_cache_emit_value(lone, writer, form);
+	++writer->forms;
+}
+
+void lone_lisp_cache_writer_store(struct lone_lisp *lone, struct lone_lisp_cache_writer *writer,
+		int directory, struct lone_bytes path, struct lone_lisp_cache_source *source)
+{
+	unsigned char *header, *cache, *temporary;
+	size_t cache_size, temporary_size;
+	char suffix[32];
+	struct lone_bytes payload;
+	ssize_t written;
+	long result;
+	int fd;
+
+	if (writer->failed) { return; }
+
+	header = writer->buffer.pointer;
+	payload = LONE_BYTES_VALUE(writer->used - LONE_LISP_CACHE_HEADER_SIZE,
+	                           header + LONE_LISP_CACHE_HEADER_SIZE);
+
+	lone_memory_move(LONE_LISP_CACHE_MAGIC, header, LONE_LISP_CACHE_MAGIC_SIZE);
+	lone_u64le_write(header +  8, source->size);
+	lone_s64le_write(header + 16, source->seconds);
+	lone_u64le_write(header + 24, source->nanoseconds);
+	lone_u64le_write(header + 32, source->hash);
+	lone_u64le_write(header + 40, payload.count);
+	lone_u64le_write(header + 48, lone_lisp_cache_hash(payload));
+	lone_u64le_write(header + 56, writer->forms);
+
+	/* write to a temporary file and rename it over the cache
+	 * so that readers never observe partially written files;
+	 * existing files and symbolic links are never written
+	 * through: the cache is simply not stored this time */
+	lone_lisp_cache_temporary_suffix(suffix);
+	cache = lone_lisp_cache_path(lone, path, "c", &cache_size);
+	temporary = lone_lisp_cache_path(lone, path, suffix, &temporary_size);
+
+	result = linux_openat_mode(directory, temporary,
+			O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+	if (result < 0) { goto deallocate; }
+	fd = (int) result;
+
+	written = linux_write_bytes(fd, LONE_BYTES_VALUE(writer->used, header));
+	linux_close(fd);
+
+	if (written != (ssize_t) writer->used
+	 || linux_renameat(directory, temporary, directory, cache) < 0) {
+		linux_unlinkat(directory, temporary, 0);
+	}
+
+deallocate:
+	lone_memory_deallocate(lone->system, temporary, temporary_size, 1, 1);
+	lone_memory_deallocate(lone->system, cache, cache_size, 1, 1);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Decoder.                                                            │
+   │                                                                        │
+   │    Every read is bounds checked. Malformed payloads fail the           │
+   │    whole load before any of the forms are evaluated.                   │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+struct lone_lisp_cache_decoder {
+	unsigned char *pointer;
+	size_t remaining;
+	size_t depth;
+	bool literals;
+	struct lone_lisp_value quote;
+};
+
+static bool lone_lisp_cache_read_byte(struct lone_lisp_cache_decoder *decoder, unsigned char *byte)
+{
+	if (decoder->remaining == 0) { return false; }
+
+	*byte = *decoder->pointer++;
+	--decoder->remaining;
+	return true;
+}
+
+static bool lone_lisp_cache_read_unsigned(struct lone_lisp_cache_decoder *decoder, lone_u64 *n)
+{
+	unsigned char byte;
+	unsigned int shift;
+
+	*n = 0;
+
+	for (shift = 0; shift < 64; shift += 7) {
+		if (!lone_lisp_cache_read_byte(decoder, &byte)) { return false; }
+		*n |= (lone_u64) (byte & 0x7F) << shift;
+		if (!(byte & 0x80)) { return true; }
+	}
+
+	return false;
+}
+
+static bool lone_lisp_cache_read_bytes(struct lone_lisp_cache_decoder *decoder, struct lone_bytes *bytes)
+{
+	lone_u64 count;
+
+	if (!lone_lisp_cache_read_unsigned(decoder, &count)) { return false; }
+	if (count > decoder->remaining) { return false; }
+
+	bytes->count = count;
+	bytes->pointer = decoder->pointer;
+	decoder->pointer += count;
+	decoder->remaining -= count;
+	return true;
+}
+
+/* Applies the reader's literal sharing to decoded values. */
+static struct lone_lisp_value lone_lisp_cache_literal(struct lone_lisp *lone,
+		struct lone_lisp_cache_decoder *decoder, struct lone_lisp_value value)
+{
+	if (!decoder->literals) { return value; }
+	return lone_lisp_hash_cons(lone, value);
+}
+
+static bool lone_lisp_cache_decode_value(struct lone_lisp *lone, struct lone_lisp_cache_decoder *decoder,
+		unsigned char tag, struct lone_lisp_value *value);
+
+static bool lone_lisp_cache_decode_next(struct lone_lisp *lone, struct lone_lisp_cache_decoder *decoder,
+		struct lone_lisp_value *value)
+{
+	unsigned char tag;
+
+	if (!lone_lisp_cache_read_byte(decoder, &tag)) { return false; }
+	return lone_lisp_cache_decode_value(lone, decoder, tag, value);
+}
+
+static bool lone_lisp_cache_decode_list(struct lone_lisp *lone, struct lone_lisp_cache_decoder *decoder,
+		struct lone_lisp_value *value)
+{
+	struct lone_lisp_value first, head, element, quoted;
+	unsigned char tag;
+
+	first = head = lone_lisp_nil();
+
+	while (1) {
+		if (!lone_lisp_cache_read_byte(decoder, &tag)) { return false; }
+
+		if (tag == LONE_LISP_CACHE_TAG_END) {
+			break;
+		} else if (tag == LONE_LISP_CACHE_TAG_DOT) {
+			if (lone_lisp_is_nil(head)) { return false; }
+			if (!lone_lisp_cache_decode_next(lone, decoder, &element)) { return false; }
+			lone_lisp_list_set_rest(lone, head, element);
+			break;
+		}
+
+		if (!lone_lisp_cache_decode_value(lone, decoder, tag, &element)) { return false; }
+		lone_lisp_list_append(lone, &first, &head, element);
+	}
+
+	if (lone_lisp_is_nil(first)) { return false; }
+
+	/* the reader shares the data quoted by 'datum */
+	if (decoder->literals
+	 && lone_lisp_is_identical(lone, lone_lisp_list_first(lone, first), decoder->quote)
+	 && lone_lisp_is_list(lone, lone_lisp_list_rest(lone, first))
+	 && lone_lisp_is_nil(lone_lisp_list_rest(lone, lone_lisp_list_rest(lone, first)))) {
+
+		quoted = lone_lisp_list_rest(lone, first);
+		lone_lisp_list_set_first(lone, quoted,
+				lone_lisp_cache_literal(lone, decoder, lone_lisp_list_first(lone, quoted)));
+	}
+
+	*value = first;
+	return true;
+}
+
+static bool lone_lisp_cache_decode_tagged(struct lone_lisp *lone, struct lone_lisp_cache_decoder *decoder,
+		unsigned char tag, struct lone_lisp_value *value)
+{
+	struct lone_lisp_value key, element;
+	struct lone_bytes bytes;
+	lone_u64 n;
+
+	switch (tag) {
+	case LONE_LISP_CACHE_TAG_NIL:
+		*value = lone_lisp_nil();
+		return true;
+	case LONE_LISP_CACHE_TAG_INTEGER:
+		if (!lone_lisp_cache_read_unsigned(decoder, &n)) { return false; }
+		*value = lone_lisp_integer_create((long) ((n >> 1) ^ -(n & 1)));
+		return true;
+	case LONE_LISP_CACHE_TAG_SYMBOL:
+		if (!lone_lisp_cache_read_bytes(decoder, &bytes)) { return false; }
+		*value = lone_lisp_intern(lone, bytes.pointer, bytes.count, true);
+		return true;
+	case LONE_LISP_CACHE_TAG_TEXT:
+		if (!lone_lisp_cache_read_bytes(decoder, &bytes)) { return false; }
+		*value = lone_lisp_cache_literal(lone, decoder, lone_lisp_text_copy(lone, bytes.pointer, bytes.count));
+		return true;
+	case LONE_LISP_CACHE_TAG_BYTES:
+		if (!lone_lisp_cache_read_bytes(decoder, &bytes)) { return false; }
+		*value = lone_lisp_bytes_copy(lone, bytes.pointer, bytes.count);
+		if (lone_lisp_is_heap_value(*value)) {
+			/* byte literals are frozen */
+			lone_lisp_heap_value_of(lone, *value)->frozen = true;
+		}
+		*value = lone_lisp_cache_literal(lone, decoder, *value);
+		return true;
+	case LONE_LISP_CACHE_TAG_LIST:
+		return lone_lisp_cache_decode_list(lone, decoder, value);
+	case LONE_LISP_CACHE_TAG_VECTOR:
+		*value = lone_lisp_vector_create(lone, 32);
+		while (1) {
+			if (!lone_lisp_cache_read_byte(decoder, &tag)) { return false; }
+			if (tag == LONE_LISP_CACHE_TAG_END) { return true; }
+			if (!lone_lisp_cache_decode_value(lone, decoder, tag, &element)) { return false; }
+			lone_lisp_vector_push(lone, *value, element);
+		}
+	case LONE_LISP_CACHE_TAG_TABLE:
+		*value = lone_lisp_table_create(lone, 32, lone_lisp_nil());
+		while (1) {
+			if (!lone_lisp_cache_read_byte(decoder, &tag)) { return false; }
+			if (tag == LONE_LISP_CACHE_TAG_END) { return true; }
+			if (!lone_lisp_cache_decode_value(lone, decoder, tag, &key)) { return false; }
+			if (!lone_lisp_cache_decode_next(lone, decoder, &element)) { return false; }
+			lone_lisp_table_set(lone, *value, key, element);
+		}
+	default:
+		return false;
+	}
+}
+
+static bool lone_lisp_cache_decode_value(struct lone_lisp *lone, struct lone_lisp_cache_decoder *decoder,
+		unsigned char tag, struct lone_lisp_value *value)
+{
+	bool decoded;
+
+	if (decoder->depth == LONE_LISP_CACHE_DEPTH_LIMIT) { return false; }
+
+	++decoder->depth;
+	decoded = lone_lisp_cache_decode_tagged(lone, decoder, tag, value);
+	--decoder->depth;
+
+	return decoded;
+}
+
+static bool lone_lisp_cache_decode(struct lone_lisp *lone, struct lone_bytes cache,
+		struct lone_lisp_cache_source *source, struct lone_lisp_value *forms)
+{
+	struct lone_lisp_cache_decoder decoder;
+	struct lone_lisp_value first, head, form;
+	struct lone_bytes payload;
+	lone_u64 count, i;
+
+	if (cache.count < LONE_LISP_CACHE_HEADER_SIZE) { return false; }
+	if (!lone_memory_is_equal(cache.pointer, LONE_LISP_CACHE_MAGIC, LONE_LISP_CACHE_MAGIC_SIZE)) { return false; }
+
+	if (lone_u64le_read(cache.pointer +  8) != source->size
+	 || lone_s64le_read(cache.pointer + 16) != source->seconds
+	 || lone_u64le_read(cache.pointer + 24) != source->nanoseconds
+	 || lone_u64le_read(cache.pointer + 32) != source->hash) {
+		/* stale */
+		return false;
+	}
+
+	payload = LONE_BYTES_VALUE(cache.count - LONE_LISP_CACHE_HEADER_SIZE,
+	                           cache.pointer + LONE_LISP_CACHE_HEADER_SIZE);
+
+	if (lone_u64le_read(cache.pointer + 40) != payload.count
+	 || lone_u64le_read(cache.pointer + 48) != lone_lisp_cache_hash(payload)) {
+		/* truncated or corrupted */
+		return false;
+	}
+
+	count = lone_u64le_read(cache.pointer + 56);
+
+	decoder.pointer = payload.pointer;
+	decoder.remaining = payload.count;
+	decoder.depth = 0;
+	decoder.literals = lone->hash_cons.literals;
+	decoder.quote = lone_lisp_intern_c_string(lone, "quote");
+
+	first = head = lone_lisp_nil();
+
+	for (i = 0; i < count; ++i) {
+		if (!lone_lisp_cache_decode_next(lone, &decoder, &form)) { return false; }
+		lone_lisp_list_append(lone, &first, &head, form);
+	}
+
+	if (decoder.remaining != 0) { return false; }
+
+	*forms = first;
+	return true;
+}
+
+bool lone_lisp_cache_load(struct lone_lisp *lone, int directory, struct lone_bytes path,
+		struct lone_lisp_cache_source *source, struct lone_lisp_value *forms)
+{
+	unsigned char *cache;
+	size_t cache_size;
+	struct stat status;
+	intptr_t mapped;
+	long result;
+	bool loaded;
+	int fd;
+
+	cache = lone_lisp_cache_path(lone, path, "c", &cache_size);
+	result = linux_openat(directory, cache, O_RDONLY | O_CLOEXEC);
+	lone_memory_deallocate(lone->system, cache, cache_size, 1, 1);
+
+	if (result < 0) { return false; }
+	fd = (int) result;
+
+	loaded = false;
+
+	if (linux_fstat(fd, &status) < 0 || !S_ISREG(status.st_mode) || status.st_size <= 0) { goto close; }
+
+	mapped = linux_mmap(0, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapped < 0) { goto close; }
+
+	loaded = lone_lisp_cache_decode(lone,
+			LONE_BYTES_VALUE((size_t) status.st_size, (void *) mapped), source, forms);
+
+	linux_munmap((void *) mapped, (size_t) status.st_size);
+
+close:
+	linux_close(fd);
+	return loaded;
+}
@@ -2,12 +2,16 @@
 
 #include <lone/lisp/garbage_collector.h>
 #include <lone/lisp/heap.h>
+#include <lone/lisp/names.h>
 #include <lone/lisp/machine/stack.h>
+#include <lone/lisp/modules/intrinsic/io_uring.h>
 
 #include <lone/memory/allocator.h>
+#include <lone/memory/array.h>
 #include <lone/memory/functions.h>
 
 #include <lone/bits.h>
+#include <lone/linux.h>
 
 #include <lone/architecture/garbage_collector.c>
 
@@ -26,6 +30,23 @@ static void lone_lisp_mark_value(struct lone_lisp *lone, struct lone_lisp_value
 	lone_lisp_mark_heap_value(lone, lone_lisp_heap_value_of(lone, value));
 }
 
+/* Weak tables are processed after marking. Remembering
+ * the reachable ones spares those passes a heap scan. */
+static void lone_lisp_remember_weak_table(struct lone_lisp *lone, size_t index)
+{
+	size_t capacity;
+
+	if (lone->heap.weak.count == lone->heap.weak.capacity) {
+		capacity = lone->heap.weak.capacity? lone->heap.weak.capacity * 2 : 16;
+		lone->heap.weak.indices = lone_memory_array(lone->system, lone->heap.weak.indices,
+				lone->heap.weak.capacity, capacity,
+				sizeof(*lone->heap.weak.indices), alignof(*lone->heap.weak.indices));
+		lone->heap.weak.capacity = capacity;
+	}
+
+	lone->heap.weak.indices[lone->heap.weak.count++] = index;
+}
+
 static void lone_lisp_mark_heap_value(struct lone_lisp *lone, struct lone_lisp_heap_value *value)
 {
 	size_t index;
@@ -87,10 +108,16 @@ static void lone_lisp_mark_heap_value(struct lone_lisp *lone, struct lone_lisp_h
 			for (size_t i = 0; i < value->as.table.count; ++i) {
 				lone_lisp_mark_value(lone, value->as.table.shaped.values[i]);
 			}
+		} else if (value->weak_keys) {
+			/* ephemerons: values are marked once their keys are */
+			lone_lisp_remember_weak_table(lone, index);
+			break;
 		} else {
+			if (value->weak_values) { lone_lisp_remember_weak_table(lone, index); }
 			for (size_t i = 0; i < value->as.table.hash.used; ++i) {
 				if (lone_lisp_is_tombstone(value->as.table.hash.entries[i].key)) { continue; }
 				lone_lisp_mark_value(lone, value->as.table.hash.entries[i].key);
+				if (value->weak_values) { continue; }
 				lone_lisp_mark_value(lone, value->as.table.hash.entries[i].value);
 			}
 		}
@@ -100,14 +127,90 @@ static void lone_lisp_mark_heap_value(struct lone_lisp *lone, struct lone_lisp_h
 			lone_lisp_mark_value(lone, value->as.shape.keys[i]);
 		}
 		break;
-	case LONE_LISP_TAG_SYMBOL:
 	case LONE_LISP_TAG_TEXT:
+		if (value->slice) { lone_lisp_mark_value(lone, value->as.text.parent); }
+		break;
 	case LONE_LISP_TAG_BYTES:
-		/* these types do not contain any other values to mark */
+		if (value->slice || value->io_uring) { lone_lisp_mark_value(lone, value->as.bytes.parent); }
+		break;
+	case LONE_LISP_TAG_SYMBOL:
+		/* symbols do not contain any other values to mark */
 		break;
 	}
 }
 
+static bool lone_lisp_is_marked_value(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	size_t index;
+
+	if (value.tagged & 1) {
+		/* non-heap values are never collected */
+		return true;
+	}
+
+	index = lone_lisp_heap_value_of(lone, value) - lone->heap.values;
+
+	return lone_bits_get(lone->heap.bits.marked, index);
+}
+
+static void lone_lisp_mark_ephemeron_values(struct lone_lisp *lone)
+{
+	struct lone_lisp_heap_value *value;
+	struct lone_lisp_table_entry *entry;
+	bool changed;
+	size_t i, j;
+
+	do {
+		changed = false;
+
+		/* marking can remember more weak tables */
+		for (i = 0; i < lone->heap.weak.count; ++i) {
+			value = &lone->heap.values[lone->heap.weak.indices[i]];
+			if (!value->weak_keys || value->weak_values) { continue; }
+
+			for (j = 0; j < value->as.table.hash.used; ++j) {
+				entry = &value->as.table.hash.entries[j];
+
+				if (lone_lisp_is_tombstone(entry->key))          { continue; }
+				if (!lone_lisp_is_marked_value(lone, entry->key)) { continue; }
+				if (lone_lisp_is_marked_value(lone, entry->value)) { continue; }
+
+				lone_lisp_mark_value(lone, entry->value);
+				changed = true;
+			}
+		}
+	} while (changed);
+}
+
+/* Deletes every entry of a reachable weak table
+ * whose weak key or weak value was not marked.
+ * Runs before the sweep so that the hashes and
+ * contents of dead keys can still be examined.
+ */
+static void lone_lisp_clear_weak_tables(struct lone_lisp *lone)
+{
+	struct lone_lisp_heap_value *value;
+	struct lone_lisp_table_entry *entry;
+	struct lone_lisp_value table;
+	size_t i, j;
+
+	for (i = 0; i < lone->heap.weak.count; ++i) {
+		value = &lone->heap.values[lone->heap.weak.indices[i]];
+		table = lone_lisp_value_from_heap_value(lone, value, LONE_LISP_TAG_TABLE);
+
+		for (j = 0; j < value->as.table.hash.used; ++j) {
+			entry = &value->as.table.hash.entries[j];
+
+			if (lone_lisp_is_tombstone(entry->key)) { continue; }
+
+			if (   (value->weak_keys   && !lone_lisp_is_marked_value(lone, entry->key))
+			    || (value->weak_values && !lone_lisp_is_marked_value(lone, entry->value))) {
+				lone_lisp_table_delete(lone, table, entry->key);
+			}
+		}
+	}
+}
+
 static void lone_lisp_pin_and_mark_heap_value(struct lone_lisp *lone, struct lone_lisp_heap_value *value)
 {
 	size_t index;
@@ -123,12 +226,16 @@ static void lone_lisp_pin_and_mark_heap_value(struct lone_lisp *lone, struct lon
 static void lone_lisp_mark_known_roots(struct lone_lisp *lone)
 {
 	lone_lisp_mark_value(lone, lone->symbol_table);
+	lone_lisp_mark_value(lone, lone->hash_cons.table);
 	lone_lisp_mark_value(lone, lone->modules.loaded);
 	lone_lisp_mark_value(lone, lone->modules.embedded);
 	lone_lisp_mark_value(lone, lone->modules.null);
 	lone_lisp_mark_value(lone, lone->modules.top_level_environment);
 	lone_lisp_mark_value(lone, lone->modules.path);
+	lone_lisp_mark_value(lone, lone->modules.directories);
+	lone_lisp_mark_value(lone, lone->modules.packages);
 	lone_lisp_mark_value(lone, lone->modules.signal_primitive);
+	lone_lisp_mark_value(lone, lone->interrupts.handlers);
 
 	lone_lisp_mark_value(lone, lone->symbols.tags.type_error);
 	lone_lisp_mark_value(lone, lone->symbols.tags.arity_error);
@@ -141,6 +248,7 @@ static void lone_lisp_mark_known_roots(struct lone_lisp *lone)
 	lone_lisp_mark_value(lone, lone->symbols.tags.generator_exhausted);
 	lone_lisp_mark_value(lone, lone->symbols.tags.generator_reentry);
 	lone_lisp_mark_value(lone, lone->symbols.tags.iteration_invalidated);
+	lone_lisp_mark_value(lone, lone->symbols.tags.read_error);
 }
 
 static bool lone_points_within_range(void *pointer, void *start, void *end)
@@ -217,17 +325,67 @@ static void lone_lisp_mark_lisp_stack_roots(struct lone_lisp *lone, struct lone_
 	lone_lisp_mark_lisp_stack_roots_of(lone, machine->stack);
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Values inherited from a forking process stay shared with it         │
+   │    for as long as nothing writes to their pages. The collector         │
+   │    keeps them alive and never moves them. They may have been           │
+   │    mutated to refer to newer values, so they are all roots.            │
+   │    Marking only writes to the separate mark bitmap.                    │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static void lone_lisp_mark_shared_roots(struct lone_lisp *lone)
+{
+	size_t i;
+
+	for (i = 0; i < lone->heap.shared && i < lone->heap.count; ++i) {
+		lone_lisp_mark_heap_value(lone, &lone->heap.values[i]);
+	}
+}
+
 static void lone_lisp_mark_all_reachable_values(struct lone_lisp *lone, struct lone_lisp_machine *machine)
 {
 	lone_registers registers;          /* stack space for registers */
 	lone_save_registers(registers);    /* spill registers on stack */
 
+	lone->heap.weak.count = 0;
+
 	/* precise */
 	lone_lisp_mark_known_roots(lone);
 	lone_lisp_mark_lisp_stack_roots(lone, machine);
+	lone_lisp_mark_shared_roots(lone);
 
 	/* conservative */
 	lone_lisp_mark_native_stack_roots(lone);
+
+	/* weak */
+	lone_lisp_mark_ephemeron_values(lone);
+}
+
+/* Releases every unreachable io_uring ring.
+ * Runs before the sweep so that the buffers
+ * of operations still in flight stay valid
+ * until the kernel is done with them.
+ */
+static void lone_lisp_finalize_io_uring_rings(struct lone_lisp *lone)
+{
+	struct lone_lisp_heap_value *value;
+	size_t i;
+
+	if (!lone->heap.rings) { return; }
+
+	for (i = 0; i < lone->heap.count; ++i) {
+		if (!lone_bits_get(lone->heap.bits.live, i))  { continue; }
+		if (lone_bits_get(lone->heap.bits.marked, i)) { continue; }
+
+		value = &lone->heap.values[i];
+
+		if (value->type == LONE_LISP_TAG_BYTES && value->io_uring) {
+			lone_lisp_io_uring_finalize(lone,
+				lone_lisp_value_from_heap_value(lone, value, LONE_LISP_TAG_BYTES));
+		}
+	}
 }
 
 static void lone_lisp_kill_all_unmarked_values(struct lone_lisp *lone)
@@ -253,7 +411,14 @@ static void lone_lisp_kill_all_unmarked_values(struct lone_lisp *lone)
 
 			switch (value->type) {
 			case LONE_LISP_TAG_BYTES:
-				if (value->should_deallocate_bytes) {
+				if (value->descriptor) {
+					lone_lisp_bytes_descriptor_close(lone,
+							lone_lisp_value_from_heap_value(lone, value, LONE_LISP_TAG_BYTES));
+				}
+
+				if (value->mapped) {
+					linux_munmap(value->as.bytes.data.pointer, value->as.bytes.data.count + 1);
+				} else if (value->should_deallocate_bytes) {
 					lone_memory_deallocate(
 						lone->system, value->as.bytes.data.pointer,
 						value->as.bytes.data.count + 1,
@@ -341,6 +506,9 @@ static void lone_lisp_kill_all_unmarked_values(struct lone_lisp *lone)
 
 	lone_memory_zero(lone->heap.bits.marked, lone_lisp_heap_bitmap_size(lone->heap.capacity));
 
+	/* dead slots among the shared values are never reused */
+	if (first_dead < lone->heap.shared) { first_dead = lone->heap.shared; }
+
 	lone->heap.first_dead = first_dead;
 	if (last_live == 0 && !lone_bits_get(lone->heap.bits.live, 0)) {
 		lone->heap.count = 0;
@@ -395,8 +563,15 @@ static bool lone_lisp_is_moveable(struct lone_lisp *lone, size_t index)
 
 static void lone_lisp_move_heap_value(struct lone_lisp *lone, size_t from, size_t to)
 {
+	struct lone_lisp_heap_value *value;
+
 	lone->heap.values[to] = lone->heap.values[from];
 
+	value = &lone->heap.values[to];
+	if (value->type == LONE_LISP_TAG_SYMBOL && lone_lisp_names_contain(lone, value->as.symbol.name.pointer)) {
+		lone_lisp_names_move(lone, value->as.symbol.name.pointer, to);
+	}
+
 	lone_bits_mark(lone->heap.bits.live, to);
 	lone_bits_clear(lone->heap.bits.live, from);
 
@@ -426,14 +601,28 @@ static struct lone_lisp_value lone_lisp_forward_value(struct lone_lisp *lone, st
 	};
 }
 
+/* References are only stored when they have actually changed.
+ * Untouched pages remain shared with the process they were
+ * inherited from even when the collector moves other values.
+ */
+static void lone_lisp_forward_in_place(struct lone_lisp *lone, struct lone_lisp_value *value)
+{
+	struct lone_lisp_value forwarded;
+
+	forwarded = lone_lisp_forward_value(lone, *value);
+
+	if (forwarded.tagged != value->tagged) { *value = forwarded; }
+}
+
 static void lone_lisp_rewrite_stack_frames(struct lone_lisp *lone,
 		struct lone_lisp_machine_stack_frame *base, struct lone_lisp_machine_stack_frame *limit)
 {
 	struct lone_lisp_machine_stack_frame *frame;
+	struct lone_lisp_value forwarded;
 
 	for (frame = base; frame < limit; ++frame) {
-		struct lone_lisp_value value = { .tagged = frame->tagged };
-		frame->tagged = lone_lisp_forward_value(lone, value).tagged;
+		forwarded = lone_lisp_forward_value(lone, (struct lone_lisp_value) { .tagged = frame->tagged });
+		if (forwarded.tagged != frame->tagged) { frame->tagged = forwarded.tagged; }
 	}
 }
 
@@ -441,19 +630,19 @@ static void lone_lisp_rewrite_heap_value_interior(struct lone_lisp *lone, struct
 {
 	switch (value->type) {
 	case LONE_LISP_TAG_MODULE:
-		value->as.module.name = lone_lisp_forward_value(lone, value->as.module.name);
-		value->as.module.environment = lone_lisp_forward_value(lone, value->as.module.environment);
-		value->as.module.exports = lone_lisp_forward_value(lone, value->as.module.exports);
+		lone_lisp_forward_in_place(lone, &value->as.module.name);
+		lone_lisp_forward_in_place(lone, &value->as.module.environment);
+		lone_lisp_forward_in_place(lone, &value->as.module.exports);
 		break;
 	case LONE_LISP_TAG_FUNCTION:
-		value->as.function.arguments = lone_lisp_forward_value(lone, value->as.function.arguments);
-		value->as.function.code = lone_lisp_forward_value(lone, value->as.function.code);
-		value->as.function.environment = lone_lisp_forward_value(lone, value->as.function.environment);
-		value->as.function.shape = lone_lisp_forward_value(lone, value->as.function.shape);
+		lone_lisp_forward_in_place(lone, &value->as.function.arguments);
+		lone_lisp_forward_in_place(lone, &value->as.function.code);
+		lone_lisp_forward_in_place(lone, &value->as.function.environment);
+		lone_lisp_forward_in_place(lone, &value->as.function.shape);
 		break;
 	case LONE_LISP_TAG_PRIMITIVE:
-		value->as.primitive.name = lone_lisp_forward_value(lone, value->as.primitive.name);
-		value->as.primitive.closure = lone_lisp_forward_value(lone, value->as.primitive.closure);
+		lone_lisp_forward_in_place(lone, &value->as.primitive.name);
+		lone_lisp_forward_in_place(lone, &value->as.primitive.closure);
 		break;
 	case LONE_LISP_TAG_CONTINUATION:
 		lone_lisp_rewrite_stack_frames(
@@ -463,7 +652,7 @@ static void lone_lisp_rewrite_heap_value_interior(struct lone_lisp *lone, struct
 		);
 		break;
 	case LONE_LISP_TAG_GENERATOR:
-		value->as.generator.function = lone_lisp_forward_value(lone, value->as.generator.function);
+		lone_lisp_forward_in_place(lone, &value->as.generator.function);
 		if (value->as.generator.stacks.caller.base) {
 			lone_lisp_rewrite_stack_frames(
 				lone,
@@ -480,37 +669,41 @@ static void lone_lisp_rewrite_heap_value_interior(struct lone_lisp *lone, struct
 		}
 		break;
 	case LONE_LISP_TAG_LIST:
-		value->as.list.first = lone_lisp_forward_value(lone, value->as.list.first);
-		value->as.list.rest = lone_lisp_forward_value(lone, value->as.list.rest);
+		lone_lisp_forward_in_place(lone, &value->as.list.first);
+		lone_lisp_forward_in_place(lone, &value->as.list.rest);
 		break;
 	case LONE_LISP_TAG_VECTOR:
 		for (size_t i = 0; i < value->as.vector.count; ++i) {
-			value->as.vector.values[i] = lone_lisp_forward_value(lone, value->as.vector.values[i]);
+			lone_lisp_forward_in_place(lone, &value->as.vector.values[i]);
 		}
 		break;
 	case LONE_LISP_TAG_TABLE:
-		value->as.table.prototype = lone_lisp_forward_value(lone, value->as.table.prototype);
+		lone_lisp_forward_in_place(lone, &value->as.table.prototype);
 		if (value->shaped) {
-			value->as.table.shaped.shape = lone_lisp_forward_value(lone, value->as.table.shaped.shape);
+			lone_lisp_forward_in_place(lone, &value->as.table.shaped.shape);
 			for (size_t i = 0; i < value->as.table.count; ++i) {
-				value->as.table.shaped.values[i] = lone_lisp_forward_value(lone, value->as.table.shaped.values[i]);
+				lone_lisp_forward_in_place(lone, &value->as.table.shaped.values[i]);
 			}
 		} else {
 			for (size_t i = 0; i < value->as.table.hash.used; ++i) {
 				if (lone_lisp_is_tombstone(value->as.table.hash.entries[i].key)) { continue; }
-				value->as.table.hash.entries[i].key = lone_lisp_forward_value(lone, value->as.table.hash.entries[i].key);
-				value->as.table.hash.entries[i].value = lone_lisp_forward_value(lone, value->as.table.hash.entries[i].value);
+				lone_lisp_forward_in_place(lone, &value->as.table.hash.entries[i].key);
+				lone_lisp_forward_in_place(lone, &value->as.table.hash.entries[i].value);
 			}
 		}
 		break;
 	case LONE_LISP_TAG_SHAPE:
 		for (size_t i = 0; i < value->as.shape.count; ++i) {
-			value->as.shape.keys[i] = lone_lisp_forward_value(lone, value->as.shape.keys[i]);
+			lone_lisp_forward_in_place(lone, &value->as.shape.keys[i]);
 		}
 		break;
-	case LONE_LISP_TAG_SYMBOL:
 	case LONE_LISP_TAG_TEXT:
+		if (value->slice) { lone_lisp_forward_in_place(lone, &value->as.text.parent); }
+		break;
 	case LONE_LISP_TAG_BYTES:
+		if (value->slice || value->io_uring) { lone_lisp_forward_in_place(lone, &value->as.bytes.parent); }
+		break;
+	case LONE_LISP_TAG_SYMBOL:
 		break;
 	}
 }
@@ -519,12 +712,16 @@ static void lone_lisp_rewrite_all_references(struct lone_lisp *lone, struct lone
 {
 	/* known roots */
 	lone->symbol_table = lone_lisp_forward_value(lone, lone->symbol_table);
+	lone->hash_cons.table = lone_lisp_forward_value(lone, lone->hash_cons.table);
 	lone->modules.loaded = lone_lisp_forward_value(lone, lone->modules.loaded);
 	lone->modules.embedded = lone_lisp_forward_value(lone, lone->modules.embedded);
 	lone->modules.null = lone_lisp_forward_value(lone, lone->modules.null);
 	lone->modules.top_level_environment = lone_lisp_forward_value(lone, lone->modules.top_level_environment);
 	lone->modules.path = lone_lisp_forward_value(lone, lone->modules.path);
+	lone->modules.directories = lone_lisp_forward_value(lone, lone->modules.directories);
+	lone->modules.packages = lone_lisp_forward_value(lone, lone->modules.packages);
 	lone->modules.signal_primitive = lone_lisp_forward_value(lone, lone->modules.signal_primitive);
+	lone->interrupts.handlers = lone_lisp_forward_value(lone, lone->interrupts.handlers);
 
 	lone->symbols.tags.type_error             = lone_lisp_forward_value(lone, lone->symbols.tags.type_error);
 	lone->symbols.tags.arity_error            = lone_lisp_forward_value(lone, lone->symbols.tags.arity_error);
@@ -537,6 +734,7 @@ static void lone_lisp_rewrite_all_references(struct lone_lisp *lone, struct lone
 	lone->symbols.tags.generator_exhausted    = lone_lisp_forward_value(lone, lone->symbols.tags.generator_exhausted);
 	lone->symbols.tags.generator_reentry      = lone_lisp_forward_value(lone, lone->symbols.tags.generator_reentry);
 	lone->symbols.tags.iteration_invalidated  = lone_lisp_forward_value(lone, lone->symbols.tags.iteration_invalidated);
+	lone->symbols.tags.read_error             = lone_lisp_forward_value(lone, lone->symbols.tags.read_error);
 
 	/* lisp machine registers */
 	machine->value = lone_lisp_forward_value(lone, machine->value);
@@ -546,6 +744,7 @@ static void lone_lisp_rewrite_all_references(struct lone_lisp *lone, struct lone
 	machine->unevaluated = lone_lisp_forward_value(lone, machine->unevaluated);
 	machine->list = lone_lisp_forward_value(lone, machine->list);
 	machine->module = lone_lisp_forward_value(lone, machine->module);
+	machine->preemption.task = lone_lisp_forward_value(lone, machine->preemption.task);
 
 	/* lisp machine stack */
 	lone_lisp_rewrite_stack_frames(lone, machine->stack.base, machine->stack.top);
@@ -562,8 +761,9 @@ static void lone_lisp_recalculate_heap_bounds(struct lone_lisp *lone)
 	struct lone_optional_size first;
 	size_t new_count;
 
-	first = lone_lisp_find_first_dead(lone, 0);
+	first = lone_lisp_find_first_dead(lone, lone->heap.shared);
 	lone->heap.first_dead = first.present? first.value : lone->heap.count;
+	if (lone->heap.first_dead < lone->heap.shared) { lone->heap.first_dead = lone->heap.shared; }
 
 	new_count = lone->heap.count;
 	while (new_count > 0 && !lone_lisp_is_alive(lone, new_count - 1)) {
@@ -619,6 +819,9 @@ zero_pinned:
 void lone_lisp_garbage_collector(struct lone_lisp *lone, struct lone_lisp_machine *machine)
 {
 	lone_lisp_mark_all_reachable_values(lone, machine);
+	lone_lisp_clear_weak_tables(lone);
+	lone_lisp_finalize_io_uring_rings(lone);
 	lone_lisp_kill_all_unmarked_values(lone);
+	lone_lisp_names_compact(lone);
 	lone_lisp_compact_heap(lone, machine);
 }
@@ -8,26 +8,14 @@
 
 #include <lone/linux.h>
 
-static void lone_lisp_hash_update_bytes(struct lone_hash_siphash_state *state,
-		void *pointer, size_t count)
-{
-	struct lone_bytes bytes;
-
-	bytes.pointer = pointer;
-	bytes.count   = count;
-
-	lone_hash_siphash_update(state, bytes);
-}
-
-static void lone_lisp_hash_initialize_from_system(struct lone_lisp *lone,
-		struct lone_hash_siphash_state *state)
+void lone_lisp_hash_initialize(struct lone_lisp *lone)
 {
 	lone_u64 k0, k1;
 
 	k0 = lone_u64le_read(lone->system->random);
 	k1 = lone_u64le_read(lone->system->random + 8);
 
-	lone_hash_siphash_initialize(state, k0, k1);
+	lone_hash_siphash_key_initialize(&lone->hash_key, k0, k1);
 }
 
 static lone_hash *hash_of(struct lone_lisp_heap_value *heap_value)
@@ -59,14 +47,7 @@ lone_hash lone_lisp_hash_of(struct lone_lisp *lone, struct lone_lisp_value value
 static lone_hash lone_lisp_hash_as_tagged_type(struct lone_lisp *lone,
 		struct lone_bytes data, enum lone_lisp_tag tag)
 {
-	struct lone_hash_siphash_state state;
-
-	lone_lisp_hash_initialize_from_system(lone, &state);
-
-	lone_lisp_hash_update_bytes(&state, &tag, sizeof(tag));
-	lone_hash_siphash_update(&state, data);
-
-	return lone_hash_siphash_finish(&state);
+	return lone_hash_siphash_prefixed(&lone->hash_key, tag, data);
 }
 
 lone_hash lone_lisp_hash_as_symbol(struct lone_lisp *lone, struct lone_bytes name)
@@ -87,11 +68,9 @@ lone_hash lone_lisp_hash_as_bytes(struct lone_lisp *lone, struct lone_bytes byte
 static lone_hash lone_lisp_hash_compute(struct lone_lisp *lone,
 		struct lone_lisp_value value)
 {
-	struct lone_hash_siphash_state state;
 	struct lone_lisp_heap_value *heap_value;
 	struct lone_bytes bytes;
-	lone_hash first_hash, rest_hash;
-	enum lone_lisp_tag tag;
+	lone_hash hashes[2];
 
 	switch (lone_lisp_type_of(value)) {
 	case LONE_LISP_TAG_SYMBOL:
@@ -111,18 +90,14 @@ static lone_hash lone_lisp_hash_compute(struct lone_lisp *lone,
 		}
 		return lone_lisp_hash_as_bytes(lone, bytes);
 	case LONE_LISP_TAG_LIST:
-		tag        = LONE_LISP_TAG_LIST;
 		heap_value = lone_lisp_heap_value_of(lone, value);
-		first_hash = lone_lisp_hash_of(lone, heap_value->as.list.first);
-		rest_hash  = lone_lisp_hash_of(lone, heap_value->as.list.rest);
-
-		lone_lisp_hash_initialize_from_system(lone, &state);
+		hashes[0]  = lone_lisp_hash_of(lone, heap_value->as.list.first);
+		hashes[1]  = lone_lisp_hash_of(lone, heap_value->as.list.rest);
 
-		lone_lisp_hash_update_bytes(&state, &tag,        sizeof(tag));
-		lone_lisp_hash_update_bytes(&state, &first_hash, sizeof(first_hash));
-		lone_lisp_hash_update_bytes(&state, &rest_hash,  sizeof(rest_hash));
+		bytes.pointer = (unsigned char *) hashes;
+		bytes.count   = sizeof(hashes);
 
-		return lone_hash_siphash_finish(&state);
+		return lone_lisp_hash_as_tagged_type(lone, bytes, LONE_LISP_TAG_LIST);
 	default:
 		/* unhashable type */ linux_exit(-1);
 	}
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/hash_cons.h>
+#include <lone/lisp/definitions.h>
+
+void lone_lisp_hash_cons_initialize(struct lone_lisp *lone)
+{
+	lone->hash_cons.table    = lone_lisp_table_create_weak(lone, 64, lone_lisp_nil(), true, true);
+	lone->hash_cons.literals = LONE_LISP_HASH_CONS_LITERALS;
+}
+
+static struct lone_lisp_value lone_lisp_hash_cons_find_or_add(struct lone_lisp *lone,
+		struct lone_lisp_value value)
+{
+	struct lone_lisp_value canonical;
+
+	canonical = lone_lisp_table_get(lone, lone->hash_cons.table, value);
+
+	if (lone_lisp_is_nil(canonical)) {
+		lone_lisp_table_set(lone, lone->hash_cons.table, value, value);
+		canonical = value;
+	}
+
+	return canonical;
+}
+
+/* Sets shareable to whether the value can be placed in
+ * the hash cons table. Lists whose elements cannot be shared
+ * still have their shareable elements canonicalized.
+ * Lists nested or continued deeper than the cache limit
+ * are left as they are so that recursion stays bounded. */
+static struct lone_lisp_value lone_lisp_hash_cons_value(struct lone_lisp *lone,
+		struct lone_lisp_value value, bool *shareable, size_t depth)
+{
+	struct lone_lisp_heap_value *heap_value;
+	bool first, rest;
+
+	switch (lone_lisp_type_of(value)) {
+	case LONE_LISP_TAG_NIL:
+	case LONE_LISP_TAG_FALSE:
+	case LONE_LISP_TAG_TRUE:
+	case LONE_LISP_TAG_INTEGER:
+	case LONE_LISP_TAG_SYMBOL:
+		/* already unique */
+		*shareable = true;
+		return value;
+	case LONE_LISP_TAG_BYTES:
+		if (!lone_lisp_is_frozen(lone, value)) { break; }
+		__attribute__((fallthrough));
+	case LONE_LISP_TAG_TEXT:
+		*shareable = true;
+		if (lone_lisp_is_inline_value(value)) { return value; }
+		return lone_lisp_hash_cons_find_or_add(lone, value);
+	case LONE_LISP_TAG_LIST:
+		if (depth == LONE_LISP_CACHE_DEPTH_LIMIT) { break; }
+
+		heap_value = lone_lisp_heap_value_of(lone, value);
+
+		/* equal elements hash equally: any cached list hash remains valid */
+		heap_value->as.list.first = lone_lisp_hash_cons_value(lone, heap_value->as.list.first, &first, depth + 1);
+		heap_value->as.list.rest  = lone_lisp_hash_cons_value(lone, heap_value->as.list.rest,  &rest,  depth + 1);
+
+		*shareable = first && rest;
+		if (!*shareable) { return value; }
+		return lone_lisp_hash_cons_find_or_add(lone, value);
+	case LONE_LISP_TAG_MODULE:
+	case LONE_LISP_TAG_FUNCTION:
+	case LONE_LISP_TAG_PRIMITIVE:
+	case LONE_LISP_TAG_CONTINUATION:
+	case LONE_LISP_TAG_GENERATOR:
+	case LONE_LISP_TAG_VECTOR:
+	case LONE_LISP_TAG_TABLE:
+	case LONE_LISP_TAG_SHAPE:
+	default:
+		break;
+	}
+
+	*shareable = false;
+	return value;
+}
+
+struct lone_lisp_value lone_lisp_hash_cons(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	bool shareable;
+	return lone_lisp_hash_cons_value(lone, value, &shareable, 0);
+}
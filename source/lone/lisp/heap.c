@@ -55,6 +55,9 @@ static intptr_t lone_lisp_heap_remap_bitmaps(struct lone_lisp_heap *heap, size_t
 	remapped = lone_lisp_heap_remap_bitmap(&heap->bits.pinned, old_size, new_size);
 	if (remapped < 0) { return remapped; }
 
+	remapped = lone_lisp_heap_remap_bitmap(&heap->bits.printing, old_size, new_size);
+	if (remapped < 0) { return remapped; }
+
 	return remapped;
 }
 
@@ -142,6 +145,11 @@ retry:
 	value->hash_cached             = false;
 	value->code_point_count_cached = false;
 	value->shaped                  = false;
+	value->weak_keys               = false;
+	value->weak_values             = false;
+	value->slice                   = false;
+	value->mapped                  = false;
+	value->descriptor              = false;
 
 	return value;
 }
@@ -186,6 +194,9 @@ static intptr_t lone_lisp_heap_initialize_bitmaps(struct lone_lisp_heap *heap, s
 	mapped = lone_lisp_heap_initialize_bitmap(&heap->bits.pinned, size);
 	if (mapped < 0) { return mapped; }
 
+	mapped = lone_lisp_heap_initialize_bitmap(&heap->bits.printing, size);
+	if (mapped < 0) { return mapped; }
+
 	return mapped;
 }
 
@@ -211,6 +222,11 @@ void lone_lisp_heap_initialize(struct lone_lisp *lone)
 	lone->heap.count = 0;
 	lone->heap.capacity = LONE_LISP_HEAP_INITIAL_CAPACITY;
 	lone->heap.first_dead = 0;
+	lone->heap.shared = 0;
+	lone->heap.rings = 0;
+	lone->heap.weak.indices = 0;
+	lone->heap.weak.count = 0;
+	lone->heap.weak.capacity = 0;
 
 	return;
 
@@ -3,6 +3,8 @@
 #include <lone/lisp/types.h>
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
+#include <lone/lisp/machine/interrupt.h>
+#include <lone/lisp/output.h>
 
 #include <lone/linux.h>
 
@@ -30,7 +32,7 @@ static bool should_evaluate_operands(struct lone_lisp *lone,
 		case LONE_LISP_TAG_TABLE:
 			return true;
 		default:
-			linux_exit(-1);
+			lone_lisp_exit(lone, -1);
 		}
 	}
 }
@@ -87,12 +89,12 @@ static void fill_shaped_values(struct lone_lisp *lone,
 	size_t i;
 
 	for (i = 0; i < shape->count; ++i) {
-		if (lone_lisp_is_nil(arguments)) { linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { lone_lisp_exit(lone, -1); }
 		values[i] = lone_lisp_list_first(lone, arguments);
 		arguments = lone_lisp_list_rest(lone, arguments);
 	}
 
-	if (!lone_lisp_is_nil(arguments)) { linux_exit(-1); }
+	if (!lone_lisp_is_nil(arguments)) { lone_lisp_exit(lone, -1); }
 }
 
 static bool should_reuse_environment(struct lone_lisp *lone,
@@ -146,7 +148,7 @@ static struct lone_lisp_value bind_arguments(struct lone_lisp *lone, struct lone
 		/* nothing to check here, just zip through them */
 		while (!lone_lisp_is_nil(names)) {
 			if (lone_lisp_is_nil(arguments)) {
-				/* argument number mismatch: ((lambda (x y) y) 10) */ linux_exit(-1);
+				/* argument number mismatch: ((lambda (x y) y) 10) */ lone_lisp_exit(lone, -1);
 			}
 
 			current = lone_lisp_list_first(lone, names);
@@ -158,7 +160,7 @@ static struct lone_lisp_value bind_arguments(struct lone_lisp *lone, struct lone
 		}
 
 		if (!lone_lisp_is_nil(arguments)) {
-			/* argument number mismatch: ((lambda (x) x) 10 20) */ linux_exit(-1);
+			/* argument number mismatch: ((lambda (x) x) 10 20) */ lone_lisp_exit(lone, -1);
 		}
 
 		return new_environment;
@@ -181,7 +183,7 @@ static struct lone_lisp_value bind_arguments(struct lone_lisp *lone, struct lone
 						lone_lisp_list_first(lone, arguments)
 					);
 				} else {
-					/* argument number mismatch: ((lambda (x y) y) 10) */ linux_exit(-1);
+					/* argument number mismatch: ((lambda (x y) y) 10) */ lone_lisp_exit(lone, -1);
 				}
 
 				break;
@@ -189,9 +191,9 @@ static struct lone_lisp_value bind_arguments(struct lone_lisp *lone, struct lone
 				/* variadic argument passing: (lambda ((arguments))), (lambda (x y (rest))) */
 
 				if (!lone_lisp_is_symbol(lone, lone_lisp_list_first(lone, current))) {
-					/* no name given: (lambda (x y ())) */ linux_exit(-1);
+					/* no name given: (lambda (x y ())) */ lone_lisp_exit(lone, -1);
 				} else if (lone_lisp_list_has_rest(lone, current)) {
-					/* too many names given: (lambda (x y (rest extra))) */ linux_exit(-1);
+					/* too many names given: (lambda (x y (rest extra))) */ lone_lisp_exit(lone, -1);
 				} else {
 					/* match list of remaining arguments to name */
 					lone_lisp_table_set(
@@ -205,14 +207,14 @@ static struct lone_lisp_value bind_arguments(struct lone_lisp *lone, struct lone
 				}
 
 			default:
-				/* unexpected value */ linux_exit(-1);
+				/* unexpected value */ lone_lisp_exit(lone, -1);
 			}
 
 			names = lone_lisp_list_rest(lone, names);
 			arguments = lone_lisp_list_rest(lone, arguments);
 
 		} else if (!lone_lisp_is_nil(arguments)) {
-			/* argument number mismatch: ((lambda (x) x) 10 20) */ linux_exit(-1);
+			/* argument number mismatch: ((lambda (x) x) 10 20) */ lone_lisp_exit(lone, -1);
 		} else {
 			/* matching number of arguments */
 			break;
@@ -227,6 +229,8 @@ void lone_lisp_machine_initialize(struct lone_lisp_machine *machine, struct lone
 {
 	machine->stack = stack;
 	machine->initial_stack_count = initial_stack_count;
+	machine->preemption.task = lone_lisp_nil();
+	machine->preemption.budget = 0;
 }
 
 void lone_lisp_machine_reset(struct lone_lisp *lone, struct lone_lisp_machine *machine,
@@ -238,6 +242,8 @@ void lone_lisp_machine_reset(struct lone_lisp *lone, struct lone_lisp_machine *m
 	machine->step = LONE_LISP_MACHINE_STEP_EVALUATE;
 	lone_lisp_machine_push_step(lone, machine, LONE_LISP_MACHINE_STEP_HALT);
 	machine->primitive.step = 0;
+	machine->preemption.task = lone_lisp_nil();
+	machine->preemption.budget = 0;
 
 	machine->expression = expression;
 	machine->module = module;
@@ -309,11 +315,25 @@ bool lone_lisp_machine_cycle(struct lone_lisp *lone, struct lone_lisp_machine *m
 			machine->value = machine->expression;
 			lone_lisp_machine_restore_step(lone, machine);
 			break;
+		case LONE_LISP_TAG_PACKED_SYMBOL_8:
+		case LONE_LISP_TAG_PACKED_SYMBOL_9:
+		case LONE_LISP_TAG_PACKED_SYMBOL_10:
+		case LONE_LISP_TAG_PACKED_SYMBOL_11:
 		case LONE_LISP_TAG_SYMBOL:
 			machine->value = lone_lisp_table_get(lone, machine->environment, machine->expression);
 			lone_lisp_machine_restore_step(lone, machine);
 			break;
 		case LONE_LISP_TAG_LIST:
+			/* safe point: apply signal handlers and preempt tasks */
+			if (__atomic_load_n(&lone_lisp_machine_interrupts, __ATOMIC_RELAXED) &&
+			    lone_lisp_machine_interrupt(lone, machine)) {
+				return true;
+			}
+			if (machine->preemption.budget && --machine->preemption.budget == 0 &&
+			    lone_lisp_machine_preempt(lone, machine)) {
+				return true;
+			}
+		evaluate_list:
 			lone_lisp_machine_save_step(lone, machine);
 			lone_lisp_machine_push_value(lone, machine, machine->environment);
 			lone_lisp_machine_push_value(lone, machine, lone_lisp_list_rest(lone, machine->expression));
@@ -634,6 +654,19 @@ bool lone_lisp_machine_cycle(struct lone_lisp *lone, struct lone_lisp_machine *m
 		machine->list = lone_lisp_machine_pop_value(lone, machine);
 		lone_lisp_machine_restore_step(lone, machine);
 		return true;
+	case LONE_LISP_MACHINE_STEP_INTERRUPT_RETURN:
+		/* Result of the signal handler is discarded.
+		 * The interrupted list has already passed the safe point:
+		 * it is evaluated without being interrupted again.
+		 * Stack:
+		 * 	expression
+		 * 	environment
+		 * 	next-step
+		 */
+		machine->expression = lone_lisp_machine_pop_value(lone, machine);
+		machine->environment = lone_lisp_machine_pop_value(lone, machine);
+		machine->step = LONE_LISP_MACHINE_STEP_EVALUATE;
+		goto evaluate_list;
 	case LONE_LISP_MACHINE_STEP_HALT:
 		return false;
 	}
@@ -648,5 +681,5 @@ signal:
 	return true;
 
 operator_not_applicable:
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
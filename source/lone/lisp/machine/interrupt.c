@@ -0,0 +1,231 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/definitions.h>
+#include <lone/lisp/types.h>
+#include <lone/lisp/machine/interrupt.h>
+#include <lone/lisp/machine/stack.h>
+
+#include <lone/linux.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Signal handlers receive nothing but the signal number.              │
+   │    The pending word and the write end of the self-pipe are the         │
+   │    only state they can reach, so they must be global variables.        │
+   │    Bit n - 1 of the pending word is set when signal n arrives.         │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+lone_u64 lone_lisp_machine_interrupts;
+static int lone_lisp_machine_interrupt_writer = -1;
+
+static void lone_lisp_machine_interrupt_handler(int signal)
+{
+	unsigned char byte;
+
+	__atomic_fetch_or(&lone_lisp_machine_interrupts, 1ULL << (signal - 1), __ATOMIC_RELAXED);
+
+	/* nonblocking: a full pipe is already readable */
+	byte = (unsigned char) signal;
+	linux_write(lone_lisp_machine_interrupt_writer, &byte, 1);
+}
+
+long lone_lisp_machine_interrupt_descriptor(struct lone_lisp *lone)
+{
+	int fds[2];
+	long result;
+
+	if (lone->interrupts.descriptor >= 0) { return lone->interrupts.descriptor; }
+
+	result = linux_pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+	if (result < 0) { return result; }
+
+	lone->interrupts.descriptor = fds[0];
+	lone_lisp_machine_interrupt_writer = fds[1];
+
+	return fds[0];
+}
+
+/* A forked process must not share the self-pipe with its parent:
+ * each would consume signals delivered to the other. The child gets
+ * a pipe of its own on the same descriptors. Signals pending in the
+ * parent are not the child's.
+ */
+long lone_lisp_machine_interrupt_forked(struct lone_lisp *lone)
+{
+	int fds[2];
+	long result;
+
+	__atomic_store_n(&lone_lisp_machine_interrupts, 0, __ATOMIC_RELAXED);
+
+	if (lone->interrupts.descriptor < 0) { return 0; }
+
+	result = linux_pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+	if (result < 0) { return result; }
+
+	result = linux_dup3(fds[0], lone->interrupts.descriptor, O_CLOEXEC);
+	if (result >= 0) { result = linux_dup3(fds[1], lone_lisp_machine_interrupt_writer, O_CLOEXEC); }
+
+	linux_close(fds[0]);
+	linux_close(fds[1]);
+
+	return result < 0? result : 0;
+}
+
+long lone_lisp_machine_interrupt_handle(struct lone_lisp *lone, long signal, struct lone_lisp_value handler)
+{
+	struct lone_lisp_value number;
+	struct sigaction action = { 0 };
+	long result;
+
+	if (signal < 1 || signal > (long) (sizeof(lone_lisp_machine_interrupts) * 8)) { return -EINVAL; }
+
+	switch (signal) {
+	case SIGSEGV:
+	case SIGBUS:
+	case SIGILL:
+	case SIGFPE:
+	case SIGTRAP:
+	case SIGSYS:
+		/* synchronous faults: the deferred handler would return
+		 * to the faulting instruction which would fault forever */
+		if (!lone_lisp_is_nil(handler)) { return -EINVAL; }
+		break;
+	default:
+		break;
+	}
+
+	number = lone_lisp_integer_create(signal);
+
+	if (lone_lisp_is_nil(handler)) {
+		action.sa_handler = SIG_DFL;
+
+		result = linux_rt_sigaction((int) signal, &action, 0);
+		if (result < 0) { return result; }
+
+		lone_lisp_table_delete(lone, lone->interrupts.handlers, number);
+		__atomic_fetch_and(&lone_lisp_machine_interrupts, ~(1ULL << (signal - 1)), __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	result = lone_lisp_machine_interrupt_descriptor(lone);
+	if (result < 0) { return result; }
+
+	/* the handler must be in place before the signal can arrive */
+	lone_lisp_table_set(lone, lone->interrupts.handlers, number, handler);
+
+	action.sa_handler = lone_lisp_machine_interrupt_handler;
+	/* not restarted: blocked system calls fail with EINTR so handlers run */
+	action.sa_flags = SA_RESTORER;
+	action.sa_restorer = linux_rt_sigreturn;
+
+	result = linux_rt_sigaction((int) signal, &action, 0);
+	if (result < 0) {
+		lone_lisp_table_delete(lone, lone->interrupts.handlers, number);
+		return result;
+	}
+
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Called with an expression about to be evaluated.                    │
+   │    Stack:                                                              │
+   │        next-step                                                       │
+   │                                                                        │
+   │    Pending signals are consumed one at a time, lowest number first.    │
+   │    When the signal has a handler, the machine is set up to apply       │
+   │    it and the evaluation is resumed by INTERRUPT_RETURN:               │
+   │        expression                                                      │
+   │        environment                                                     │
+   │        next-step                                                       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+bool lone_lisp_machine_interrupt(struct lone_lisp *lone, struct lone_lisp_machine *machine)
+{
+	unsigned char buffer[64];
+	struct lone_lisp_value number, handler;
+	lone_u64 pending;
+	int signal;
+
+	/* drained first: signals delivered afterwards write to it again */
+	if (lone->interrupts.descriptor >= 0) {
+		while (linux_read(lone->interrupts.descriptor, buffer, sizeof(buffer)) > 0);
+	}
+
+	pending = __atomic_load_n(&lone_lisp_machine_interrupts, __ATOMIC_RELAXED);
+	if (!pending) { return false; }
+
+	signal = __builtin_ctzll(pending) + 1;
+	__atomic_fetch_and(&lone_lisp_machine_interrupts, ~(1ULL << (signal - 1)), __ATOMIC_RELAXED);
+
+	number = lone_lisp_integer_create(signal);
+	handler = lone_lisp_table_get(lone, lone->interrupts.handlers, number);
+	if (lone_lisp_is_nil(handler)) { return false; }
+
+	lone_lisp_machine_push_value(lone, machine, machine->environment);
+	lone_lisp_machine_push_value(lone, machine, machine->expression);
+	lone_lisp_machine_push_step(lone, machine, LONE_LISP_MACHINE_STEP_INTERRUPT_RETURN);
+
+	machine->applicable = handler;
+	machine->list = lone_lisp_list_create(lone, number, lone_lisp_nil());
+	machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+
+	return true;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Called with an expression about to be evaluated once the task       │
+   │    has used up its budget. The task is suspended exactly as if it      │
+   │    had yielded nil: its stack is saved and the caller's stack is       │
+   │    restored. Resuming it evaluates the expression. Other generators    │
+   │    the task is running are not preempted, the task is suspended at     │
+   │    the first safe point reached after they have yielded.               │
+   │    Resumed tasks do not count the expression they resume with,         │
+   │    otherwise a budget of one would never let them make progress.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+bool lone_lisp_machine_preempt(struct lone_lisp *lone, struct lone_lisp_machine *machine)
+{
+	struct lone_lisp_machine_stack_frame delimiter;
+	struct lone_lisp_generator *generator;
+
+	delimiter = machine->stack.base[0];
+
+	if ((delimiter.tagged & LONE_LISP_TAG_MASK) != LONE_LISP_TAG_GENERATOR_DELIMITER ||
+	    lone_lisp_retag_frame(delimiter, LONE_LISP_TAG_GENERATOR).tagged != machine->preemption.task.tagged) {
+		machine->preemption.budget = 1;
+		return false;
+	}
+
+	generator = &lone_lisp_heap_value_of(lone, machine->preemption.task)->as.generator;
+
+	/* Resumed generators continue at AFTER_APPLICATION, which restores
+	 * the two steps that yield's own application left on the stack.
+	 * The second one restored is the one that runs: INTERRUPT_RETURN.
+	 * Stack:
+	 * 	INTERRUPT_RETURN    overwritten by the step below it
+	 * 	INTERRUPT_RETURN
+	 * 	expression
+	 * 	environment
+	 * 	next-step
+	 */
+	lone_lisp_machine_push_value(lone, machine, machine->environment);
+	lone_lisp_machine_push_value(lone, machine, machine->expression);
+	lone_lisp_machine_push_step(lone, machine, LONE_LISP_MACHINE_STEP_INTERRUPT_RETURN);
+	lone_lisp_machine_push_step(lone, machine, LONE_LISP_MACHINE_STEP_INTERRUPT_RETURN);
+
+	generator->stacks.own = machine->stack;
+	machine->stack = generator->stacks.caller;
+	generator->stacks.caller = (struct lone_lisp_machine_stack) { 0 };
+
+	/* return nil to the caller of the generator, as yield would */
+	machine->value = lone_lisp_nil();
+	machine->step = LONE_LISP_MACHINE_STEP_AFTER_APPLICATION;
+
+	return true;
+}
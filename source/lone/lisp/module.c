@@ -3,13 +3,16 @@
 #include <lone/lisp/module.h>
 
 #include <lone/lisp/reader.h>
+#include <lone/lisp/cache.h>
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
 
 #include <lone/lisp/garbage_collector.h>
+#include <lone/lisp/output.h>
 #include <lone/lisp/utilities.h>
 
 #include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
 
 #include <lone/linux.h>
 
@@ -58,20 +61,20 @@ static struct lone_lisp_value lone_lisp_module_name_to_key(struct lone_lisp *lon
 	case LONE_LISP_TAG_FALSE:
 	case LONE_LISP_TAG_TRUE:
 	case LONE_LISP_TAG_INTEGER:
-		/* invalid module name component */ linux_exit(-1);
+		/* invalid module name component */ lone_lisp_exit(lone, -1);
 	case LONE_LISP_TAG_SYMBOL:
 		if (!lone_lisp_module_name_is_valid_component(lone, name)) {
-			/* invalid module name component */ linux_exit(-1);
+			/* invalid module name component */ lone_lisp_exit(lone, -1);
 		}
 		return lone_lisp_list_create(lone, name, lone_lisp_nil());
 	case LONE_LISP_TAG_LIST:
 		for (head = name; !lone_lisp_is_nil(head); head = lone_lisp_list_rest(lone, head)) {
 			component = lone_lisp_list_first(lone, head);
 			if (!lone_lisp_is_symbol(lone, component)) {
-				/* not a symbol */ linux_exit(-1);
+				/* not a symbol */ lone_lisp_exit(lone, -1);
 			}
 			if (!lone_lisp_module_name_is_valid_component(lone, component)) {
-				/* invalid module name component */ linux_exit(-1);
+				/* invalid module name component */ lone_lisp_exit(lone, -1);
 			}
 		}
 		return name;
@@ -87,7 +90,7 @@ static struct lone_lisp_value lone_lisp_module_name_to_key(struct lone_lisp *lon
 	case LONE_LISP_TAG_TABLE:
 	case LONE_LISP_TAG_SHAPE:
 	default:
-		/* invalid module name component */ linux_exit(-1);
+		/* invalid module name component */ lone_lisp_exit(lone, -1);
 	}
 }
 
@@ -100,7 +103,7 @@ static bool lone_lisp_module_try_to_load_embedded(struct lone_lisp *lone,
 
 	embedded_module = lone_lisp_table_get(lone, lone->modules.embedded, name);
 	if (lone_lisp_is_nil(embedded_module)) { /* embedded module not found */ return false; }
-	if (!lone_lisp_has_bytes(lone, embedded_module)) { /* invalid embedded module */ linux_exit(-1); }
+	if (!lone_lisp_has_bytes(lone, embedded_module)) { /* invalid embedded module */ lone_lisp_exit(lone, -1); }
 
 	lone_lisp_module_load_from_bytes(lone, module, lone_lisp_bytes_of(lone, &embedded_module));
 	lone_lisp_table_delete(lone, lone->modules.embedded, name);
@@ -138,37 +141,130 @@ struct lone_lisp_value lone_lisp_module_for_name(struct lone_lisp *lone, struct
 	return lone_lisp_module_get_or_create(lone, name, 0);
 }
 
-static int lone_lisp_module_search(struct lone_lisp *lone, struct lone_lisp_value symbols)
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Module search path directories are opened as O_PATH file            │
+   │    descriptors once, when they are pushed onto the path.               │
+   │    Package directories are opened relative to them the first           │
+   │    time a module from that package is searched for and are             │
+   │    remembered along with the ones that could not be opened.            │
+   │    Later searches skip directories known not to contain the            │
+   │    package and open the module file relative to the package            │
+   │    directory descriptor with a single system call. Only package        │
+   │    directories are cached: module files are opened on every search     │
+   │    and a module that is not found anywhere is a fatal error.           │
+   │                                                                        │
+   │        (greeting)    directory/greeting/greeting.ln                    │
+   │        (a b c)       directory/a/a/b/c.ln                              │
+   │                                                                        │
+   │    Paths are built in fixed size buffers on the stack.                 │
+   │    Relative directories are resolved against the working               │
+   │    directory at the time they were pushed onto the path.               │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define LONE_LISP_MODULE_DIRECTORY_MISSING (-1)
+
+static bool lone_lisp_module_path_append(unsigned char *buffer, size_t *used, struct lone_bytes bytes)
 {
-	struct lone_lisp_value arguments, package, search_path;
-	struct lone_lisp_value slash, ln;
-	struct lone_bytes path;
+	/* always leave room for the null terminator */
+	if (bytes.count >= LONE_LISP_MODULE_PATH_SIZE - *used) { return false; }
+
+	lone_memory_move(bytes.pointer, buffer + *used, bytes.count);
+	*used += bytes.count;
+	buffer[*used] = '\0';
+
+	return true;
+}
+
+static int lone_lisp_module_open_directory(struct lone_lisp *lone, int directory, unsigned char *path)
+{
+	long result;
+
+	result = linux_openat(directory, path, O_PATH | O_DIRECTORY | O_CLOEXEC);
+
+	if (result < 0) {
+		switch (result) {
+		case -ENOMEM: case -EFAULT:
+			lone_lisp_exit(lone, -1);
+		default:
+			return LONE_LISP_MODULE_DIRECTORY_MISSING;
+		}
+	}
+
+	return (int) result;
+}
+
+static int lone_lisp_module_package_directory(struct lone_lisp *lone,
+		struct lone_lisp_value package, size_t i)
+{
+	unsigned char buffer[LONE_LISP_MODULE_PATH_SIZE];
+	struct lone_lisp_value descriptors, descriptor;
+	int directory, result;
+	size_t used;
+
+	descriptors = lone_lisp_table_get(lone, lone->modules.packages, package);
+
+	if (lone_lisp_is_nil(descriptors)) {
+		descriptors = lone_lisp_vector_create(lone, lone_lisp_vector_count(lone, lone->modules.directories));
+		lone_lisp_table_set(lone, lone->modules.packages, package, descriptors);
+	}
+
+	descriptor = lone_lisp_vector_get_value_at(lone, descriptors, i);
+	if (!lone_lisp_is_nil(descriptor)) { /* already resolved */ return (int) lone_lisp_integer_of(descriptor); }
+
+	directory = (int) lone_lisp_integer_of(lone_lisp_vector_get_value_at(lone, lone->modules.directories, i));
+	result = LONE_LISP_MODULE_DIRECTORY_MISSING;
+	used = 0;
+
+	if (directory >= 0 && lone_lisp_module_path_append(buffer, &used, lone_lisp_bytes_of(lone, &package))) {
+		result = lone_lisp_module_open_directory(lone, directory, buffer);
+	}
+
+	lone_lisp_vector_set_value_at(lone, descriptors, i, lone_lisp_integer_create(result));
+
+	return result;
+}
+
+/* Returns the file descriptor of the module file found on the search path.
+ * Its path relative to the returned directory is built in the given buffer. */
+static int lone_lisp_module_search(struct lone_lisp *lone, struct lone_lisp_value symbols,
+		unsigned char *buffer, struct lone_bytes *path, int *directory)
+{
+	struct lone_lisp_value package, head, component;
 	struct stat status;
+	size_t used, i, count;
 	long result;
-	size_t i;
 	int fd;
 
 	symbols = lone_lisp_module_name_to_key(lone, symbols);
 	package = lone_lisp_list_first(lone, symbols);
 
-	slash = lone_lisp_intern_c_string(lone, "/");
-	ln = lone_lisp_intern_c_string(lone, ".ln");
+	for (used = 0, head = symbols; !lone_lisp_is_nil(head); head = lone_lisp_list_rest(lone, head)) {
+		component = lone_lisp_list_first(lone, head);
 
-	LONE_LISP_VECTOR_FOR_EACH(lone, search_path, lone->modules.path, i) {
-		arguments = lone_lisp_list_build(lone, 3, &search_path, &package, &symbols);
-		arguments = lone_lisp_list_flatten(lone, arguments);
-		arguments = lone_lisp_text_transfer_bytes(lone, lone_lisp_join(lone, slash, arguments, lone_lisp_has_bytes), true);
-		arguments = lone_lisp_list_build(lone, 2, &arguments, &ln);
-		path = lone_lisp_concatenate(lone, arguments, lone_lisp_has_bytes);
+		if ((used && !lone_lisp_module_path_append(buffer, &used, LONE_BYTES_VALUE_FROM_LITERAL("/")))
+		 || !lone_lisp_module_path_append(buffer, &used, lone_lisp_bytes_of(lone, &component))) {
+			/* module name too long */ lone_lisp_exit(lone, -1);
+		}
+	}
 
-		result = linux_openat(AT_FDCWD, path.pointer, O_RDONLY | O_CLOEXEC);
+	if (!lone_lisp_module_path_append(buffer, &used, LONE_BYTES_VALUE_FROM_LITERAL(".ln"))) {
+		/* module name too long */ lone_lisp_exit(lone, -1);
+	}
 
-		lone_memory_deallocate(lone->system, path.pointer, path.count + 1, 1, 1);
+	count = lone_lisp_vector_count(lone, lone->modules.directories);
+
+	for (i = 0; i < count; ++i) {
+		*directory = lone_lisp_module_package_directory(lone, package, i);
+		if (*directory == LONE_LISP_MODULE_DIRECTORY_MISSING) { continue; }
+
+		result = linux_openat(*directory, buffer, O_RDONLY | O_CLOEXEC);
 
 		if (result < 0) {
 			switch (result) {
 			case -ENOMEM: case -EFAULT:
-				linux_exit(-1);
+				lone_lisp_exit(lone, -1);
 			default:
 				continue;
 			}
@@ -186,14 +282,26 @@ static int lone_lisp_module_search(struct lone_lisp *lone, struct lone_lisp_valu
 			continue;
 		}
 
+		*path = LONE_BYTES_VALUE(used, buffer);
 		return fd;
 	}
 
-	linux_exit(-1); /* module not found */
+	lone_lisp_exit(lone, -1); /* module not found */
+}
+
+static void lone_lisp_module_evaluate(struct lone_lisp *lone, struct lone_lisp_machine *machine,
+		struct lone_lisp_value module, struct lone_lisp_value value)
+{
+	lone_lisp_machine_reset(lone, machine, module, value);
+	while (lone_lisp_machine_cycle(lone, machine));
+	lone_lisp_output_flush_all(lone);
+	lone_lisp_garbage_collector(lone, machine);
 }
 
+/* Forms read are also appended to the cache writer if one is given. */
 static void lone_lisp_module_load_from_reader(struct lone_lisp *lone,
-		struct lone_lisp_value module, struct lone_lisp_reader *reader)
+		struct lone_lisp_value module, struct lone_lisp_reader *reader,
+		struct lone_lisp_cache_writer *cache)
 {
 	struct lone_lisp_machine machine;
 	struct lone_lisp_value value;
@@ -204,26 +312,44 @@ static void lone_lisp_module_load_from_reader(struct lone_lisp *lone,
 
 	while (1) {
 		value = lone_lisp_read(lone, reader);
-		if (reader->status.error) { linux_exit(-1); }
+		if (reader->status.error) { lone_lisp_exit(lone, -1); }
 		if (reader->status.end_of_input) { break; }
 
-		lone_lisp_machine_reset(lone, &machine, module, value);
-		while (lone_lisp_machine_cycle(lone, &machine));
-		lone_lisp_garbage_collector(lone, &machine);
+		if (cache) { lone_lisp_cache_writer_append(lone, cache, value); }
+
+		lone_lisp_module_evaluate(lone, &machine, module, value);
 	}
 
+	lone_lisp_output_flush_all(lone);
 	lone_lisp_reader_finalize(lone, reader);
 	lone_lisp_garbage_collector(lone, &machine);
 	lone_lisp_machine_deallocate_stack(lone, machine.stack);
 }
 
+static void lone_lisp_module_load_from_forms(struct lone_lisp *lone,
+		struct lone_lisp_value module, struct lone_lisp_value forms)
+{
+	struct lone_lisp_machine machine;
+
+	lone_lisp_machine_initialize(&machine,
+		lone_lisp_machine_allocate_stack(lone, LONE_LISP_MACHINE_STACK_INITIAL_SIZE),
+		LONE_LISP_MACHINE_STACK_INITIAL_SIZE);
+
+	for (/* forms */; !lone_lisp_is_nil(forms); forms = lone_lisp_list_rest(lone, forms)) {
+		lone_lisp_module_evaluate(lone, &machine, module, lone_lisp_list_first(lone, forms));
+	}
+
+	lone_lisp_garbage_collector(lone, &machine);
+	lone_lisp_machine_deallocate_stack(lone, machine.stack);
+}
+
 void lone_lisp_module_load_from_bytes(struct lone_lisp *lone,
 		struct lone_lisp_value module, struct lone_bytes bytes)
 {
 	struct lone_lisp_reader reader;
 
 	lone_lisp_reader_for_bytes(lone, &reader, bytes);
-	lone_lisp_module_load_from_reader(lone, module, &reader);
+	lone_lisp_module_load_from_reader(lone, module, &reader, 0);
 }
 
 static void lone_lisp_module_load_from_file_descriptor(struct lone_lisp *lone,
@@ -232,20 +358,79 @@ static void lone_lisp_module_load_from_file_descriptor(struct lone_lisp *lone,
 	struct lone_lisp_reader reader;
 
 	lone_lisp_reader_for_file_descriptor(lone, &reader, LONE_LISP_BUFFER_SIZE, file_descriptor);
-	lone_lisp_module_load_from_reader(lone, module, &reader);
+	lone_lisp_module_load_from_reader(lone, module, &reader, 0);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Module files are mapped into memory and read in place.              │
+   │    No read system calls are made and no buffer is copied.              │
+   │                                                                        │
+   │    The mapping is read only and owned by mapped bytes which            │
+   │    the texts read from it reference. It is unmapped once they          │
+   │    have all been collected. Truncating a module file while it          │
+   │    is still mapped makes accessing those texts fault.                  │
+   │                                                                        │
+   │    The forms read are cached next to the module file and               │
+   │    decoded from there instead on subsequent loads.                     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static bool lone_lisp_module_load_from_mapping(struct lone_lisp *lone,
+		struct lone_lisp_value module, int file_descriptor, int directory, struct lone_bytes path)
+{
+	struct lone_lisp_cache_source source;
+	struct lone_lisp_cache_writer cache;
+	struct lone_lisp_reader reader;
+	struct lone_lisp_value mapping, forms;
+	struct stat status;
+
+	if (linux_fstat(file_descriptor, &status) < 0) { return false; }
+	if (!S_ISREG(status.st_mode) || status.st_size <= 0) { return false; }
+
+	mapping = lone_lisp_bytes_mmap(lone, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, true);
+
+	if (lone_lisp_is_integer(lone, mapping)) { return false; }
+
+	if (!LONE_LISP_MODULE_CACHE) {
+		lone_lisp_reader_for_mapped_bytes(lone, &reader, mapping);
+		lone_lisp_module_load_from_reader(lone, module, &reader, 0);
+		return true;
+	}
+
+	lone_lisp_cache_source_of(&source, &status, lone_lisp_heap_value_of(lone, mapping)->as.bytes.data);
+
+	if (lone_lisp_cache_load(lone, directory, path, &source, &forms)) {
+		/* nothing references the mapping, the collector unmaps it */
+		lone_lisp_module_load_from_forms(lone, module, forms);
+		return true;
+	}
+
+	lone_lisp_cache_writer_initialize(lone, &cache);
+	lone_lisp_reader_for_mapped_bytes(lone, &reader, mapping);
+	lone_lisp_module_load_from_reader(lone, module, &reader, &cache);
+	lone_lisp_cache_writer_store(lone, &cache, directory, path, &source);
+	lone_lisp_cache_writer_finalize(lone, &cache);
+
+	return true;
 }
 
 struct lone_lisp_value lone_lisp_module_load(struct lone_lisp *lone, struct lone_lisp_value name)
 {
+	unsigned char buffer[LONE_LISP_MODULE_PATH_SIZE];
 	struct lone_lisp_value module;
+	struct lone_bytes path;
+	int file_descriptor, directory;
 	bool not_found;
-	int file_descriptor;
 
 	module = lone_lisp_module_get_or_create(lone, name, &not_found);
 
 	if (not_found) {
-		file_descriptor = lone_lisp_module_search(lone, name);
-		lone_lisp_module_load_from_file_descriptor(lone, module, file_descriptor);
+		file_descriptor = lone_lisp_module_search(lone, name, buffer, &path, &directory);
+
+		if (!lone_lisp_module_load_from_mapping(lone, module, file_descriptor, directory, path)) {
+			/* empty or unmappable file */
+			lone_lisp_module_load_from_file_descriptor(lone, module, file_descriptor);
+		}
 
 		/* On Linux, close releases the file descriptor
 		   even when it returns an error such as EINTR.
@@ -270,7 +455,7 @@ void lone_lisp_module_load_null_from_standard_input(struct lone_lisp *lone)
 void lone_lisp_module_export(struct lone_lisp *lone,
 		struct lone_lisp_value module, struct lone_lisp_value symbol)
 {
-	if (!lone_lisp_is_symbol(lone, symbol)) { /* only symbols can be exported */ linux_exit(-1); }
+	if (!lone_lisp_is_symbol(lone, symbol)) { /* only symbols can be exported */ lone_lisp_exit(lone, -1); }
 	lone_lisp_table_set(lone, lone_lisp_heap_value_of(lone, module)->as.module.exports, symbol, symbol);
 }
 
@@ -342,10 +527,10 @@ static void lone_lisp_import_symbol(struct lone_lisp *lone,
 {
 	struct lone_lisp_value value;
 
-	if (!lone_lisp_is_symbol(lone, symbol)) { /* name not a symbol: (import (module 10)) */ linux_exit(-1); }
+	if (!lone_lisp_is_symbol(lone, symbol)) { /* name not a symbol: (import (module 10)) */ lone_lisp_exit(lone, -1); }
 
 	if (lone_lisp_is_nil(lone_lisp_table_get(lone, exports, symbol))) {
-		/* attempt to import private symbol */ linux_exit(-1);
+		/* attempt to import private symbol */ lone_lisp_exit(lone, -1);
 	}
 
 	value = lone_lisp_table_get(lone, lone_lisp_heap_value_of(lone, spec->module)->as.module.environment, symbol);
@@ -385,11 +570,11 @@ static void lone_lisp_primitive_import_form(struct lone_lisp *lone,
 
 	switch (lone_lisp_type_of(argument)) {
 	case LONE_LISP_TAG_NIL:
-		/* nothing to import: (import ()) */ linux_exit(-1);
+		/* nothing to import: (import ()) */ lone_lisp_exit(lone, -1);
 	case LONE_LISP_TAG_FALSE:
 	case LONE_LISP_TAG_TRUE:
 	case LONE_LISP_TAG_INTEGER:
-		/* not a supported import argument type */ linux_exit(-1);
+		/* not a supported import argument type */ lone_lisp_exit(lone, -1);
 	case LONE_LISP_TAG_SYMBOL:
 		/* (import module) */
 		name = argument;
@@ -411,11 +596,11 @@ static void lone_lisp_primitive_import_form(struct lone_lisp *lone,
 	case LONE_LISP_TAG_TABLE:
 	case LONE_LISP_TAG_SHAPE:
 	default:
-		/* not a supported import argument type */ linux_exit(-1);
+		/* not a supported import argument type */ lone_lisp_exit(lone, -1);
 	}
 
 	spec->module = lone_lisp_module_load(lone, name);
-	if (lone_lisp_is_nil(spec->module)) { /* module not found: (import (non-existent)) */ linux_exit(-1); }
+	if (lone_lisp_is_nil(spec->module)) { /* module not found: (import (non-existent)) */ lone_lisp_exit(lone, -1); }
 
 	spec->symbols = lone_lisp_is_nil(argument)?
 		lone_lisp_nil() : lone_lisp_list_to_vector(lone, argument);
@@ -430,7 +615,7 @@ LONE_LISP_PRIMITIVE(module_import)
 
 	arguments = lone_lisp_machine_pop_value(lone, machine);
 
-	if (lone_lisp_is_nil(arguments)) { /* nothing to import: (import) */ linux_exit(-1); }
+	if (lone_lisp_is_nil(arguments)) { /* nothing to import: (import) */ lone_lisp_exit(lone, -1); }
 
 	prefixed = lone_lisp_intern_c_string(lone, "prefixed");
 	unprefixed = lone_lisp_intern_c_string(lone, "unprefixed");
@@ -446,7 +631,7 @@ LONE_LISP_PRIMITIVE(module_import)
 			if (lone_lisp_is_equivalent(lone, argument, prefixed)) { spec.prefixed = true; }
 			else if (lone_lisp_is_equivalent(lone, argument, unprefixed)) { spec.prefixed = false; }
 		} else {
-			/* invalid import argument */ linux_exit(-1);
+			/* invalid import argument */ lone_lisp_exit(lone, -1);
 		}
 	}
 
@@ -456,7 +641,21 @@ LONE_LISP_PRIMITIVE(module_import)
 
 void lone_lisp_module_path_push(struct lone_lisp *lone, struct lone_lisp_value directory)
 {
+	unsigned char buffer[LONE_LISP_MODULE_PATH_SIZE];
+	int descriptor;
+	size_t used;
+
+	if (!lone_lisp_has_bytes(lone, directory)) { /* directory not text or bytes */ lone_lisp_exit(lone, -1); }
+
+	descriptor = LONE_LISP_MODULE_DIRECTORY_MISSING;
+	used = 0;
+
+	if (lone_lisp_module_path_append(buffer, &used, lone_lisp_bytes_of(lone, &directory))) {
+		descriptor = lone_lisp_module_open_directory(lone, AT_FDCWD, buffer);
+	}
+
 	lone_lisp_vector_push(lone, lone->modules.path, directory);
+	lone_lisp_vector_push(lone, lone->modules.directories, lone_lisp_integer_create(descriptor));
 }
 
 void lone_lisp_module_path_push_c_string(struct lone_lisp *lone, char *directory)
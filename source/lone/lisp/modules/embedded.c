@@ -4,6 +4,7 @@
 
 #include <lone/lisp/module.h>
 #include <lone/lisp/segment.h>
+#include <lone/lisp/output.h>
 
 #include <lone/lisp/reader.h>
 
@@ -32,7 +33,7 @@ static struct lone_bytes slice(struct lone_lisp *lone, struct lone_bytes bytes,
 	if (__builtin_add_overflow(start, size, &end)) { goto overflow; }
 
 	if (start >= bytes.count || end > bytes.count) {
-		/* segment overrun */ linux_exit(-1);
+		/* segment overrun */ lone_lisp_exit(lone, -1);
 	}
 
 	return (struct lone_bytes) {
@@ -43,7 +44,7 @@ static struct lone_bytes slice(struct lone_lisp *lone, struct lone_bytes bytes,
 unexpected_value_type:
 negative_offset_or_size:
 overflow:
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 void lone_lisp_modules_embedded_load(struct lone_lisp *lone, lone_elf_native_segment *segment)
@@ -58,7 +59,7 @@ void lone_lisp_modules_embedded_load(struct lone_lisp *lone, lone_elf_native_seg
 
 	symbol = lone_lisp_intern_c_string(lone, "data");
 	data = lone_lisp_table_get(lone, descriptor, symbol);
-	if (lone_lisp_is_nil(data) || !lone_lisp_is_bytes(lone, data)) { linux_exit(-1); }
+	if (lone_lisp_is_nil(data) || !lone_lisp_is_bytes(lone, data)) { lone_lisp_exit(lone, -1); }
 	bytes = lone_lisp_heap_value_of(lone, data)->as.bytes.data;
 
 	symbol = lone_lisp_intern_c_string(lone, "modules");
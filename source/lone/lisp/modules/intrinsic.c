@@ -10,6 +10,11 @@
 #include <lone/lisp/modules/intrinsic/list.h>
 #include <lone/lisp/modules/intrinsic/vector.h>
 #include <lone/lisp/modules/intrinsic/table.h>
+#include <lone/lisp/modules/intrinsic/output.h>
+#include <lone/lisp/modules/intrinsic/reader.h>
+#include <lone/lisp/modules/intrinsic/event.h>
+#include <lone/lisp/modules/intrinsic/io_uring.h>
+#include <lone/lisp/modules/intrinsic/time.h>
 
 void lone_lisp_modules_intrinsic_initialize(struct lone_lisp *lone,
 		int argc, char **argv, char **envp,
@@ -23,4 +28,9 @@ void lone_lisp_modules_intrinsic_initialize(struct lone_lisp *lone,
 	lone_lisp_modules_intrinsic_list_initialize(lone);
 	lone_lisp_modules_intrinsic_vector_initialize(lone);
 	lone_lisp_modules_intrinsic_table_initialize(lone);
+	lone_lisp_modules_intrinsic_output_initialize(lone);
+	lone_lisp_modules_intrinsic_reader_initialize(lone);
+	lone_lisp_modules_intrinsic_event_initialize(lone);
+	lone_lisp_modules_intrinsic_io_uring_initialize(lone);
+	lone_lisp_modules_intrinsic_time_initialize(lone, auxv);
 }
@@ -6,6 +6,7 @@
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
 #include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
 
 #include <lone/memory/allocator.h>
 
@@ -27,6 +28,21 @@ void lone_lisp_modules_intrinsic_bytes_initialize(struct lone_lisp *lone)
 	lone_lisp_module_export_primitive(lone, module, "zero?",
 			"bytes_is_zero", lone_lisp_primitive_bytes_is_zero, module, flags);
 
+	lone_lisp_module_export_primitive(lone, module, "slice",
+			"bytes_slice", lone_lisp_primitive_bytes_slice, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "map-file",
+			"bytes_map_file", lone_lisp_primitive_bytes_map_file, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "map-memory",
+			"bytes_map_memory", lone_lisp_primitive_bytes_map_memory, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "sync",
+			"bytes_sync", lone_lisp_primitive_bytes_sync, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "advise",
+			"bytes_advise", lone_lisp_primitive_bytes_advise, module, flags);
+
 #define LONE_LISP_EXPORT_BYTES_READER_PRIMITIVE(sign, bits, endian) \
 	lone_lisp_module_export_primitive(lone, module, "read-" #sign #bits #endian, \
 			"bytes_read_" #sign #bits #endian, \
@@ -124,7 +140,7 @@ LONE_LISP_PRIMITIVE(bytes_new)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 
 destructure:
 
@@ -198,7 +214,7 @@ LONE_LISP_PRIMITIVE(bytes_is_zero)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 
 destructure:
 
@@ -234,6 +250,503 @@ validate_bytes:
 	return 0;
 }
 
+/* (slice bytes start)
+ * (slice bytes start end)
+ *
+ * Returns the bytes from start up to but not including end
+ * without copying them. The slice shares the memory of the
+ * bytes and keeps them alive. */
+LONE_LISP_PRIMITIVE(bytes_slice)
+{
+	struct lone_lisp_value arguments, bytes, start, end;
+	size_t count;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with a replacement arguments list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	end = lone_lisp_nil();
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &bytes, &start)
+	 && lone_lisp_list_destructure(lone, arguments, 3, &bytes, &start, &end)) {
+		/* wrong number of arguments: (slice b) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_bytes(lone, bytes)
+	 || !lone_lisp_is_integer(lone, start)
+	 || !(lone_lisp_is_nil(end) || lone_lisp_is_integer(lone, end))) {
+		/* wrong types: (slice "text" 0) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	count = lone_lisp_bytes_of(lone, &bytes).count;
+
+	if (lone_lisp_is_nil(end)) { end = lone_lisp_integer_create((lone_lisp_integer) count); }
+
+	if (lone_lisp_integer_of(start) < 0
+	 || lone_lisp_integer_of(end) < lone_lisp_integer_of(start)
+	 || (size_t) lone_lisp_integer_of(end) > count) {
+		/* out of bounds: (slice (bytes new 2) 1 3) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.index_error,
+				arguments
+			);
+	}
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_bytes_slice(lone, bytes,
+				(size_t) lone_lisp_integer_of(start),
+				(size_t) (lone_lisp_integer_of(end) - lone_lisp_integer_of(start))));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Memory mapped bytes.                                                │
+   │                                                                        │
+   │        (map-file fd)             read only, frozen                     │
+   │        (map-file fd 'private)    writable, changes stay private        │
+   │        (map-file fd 'shared)     writable, changes reach the file      │
+   │        (map-memory count)        zero filled private memory            │
+   │        (map-memory count 'shared)                                      │
+   │                                                                        │
+   │    The whole file is mapped. Files without contents like pipes,        │
+   │    procfs files or empty files cannot be mapped. Shared memory is      │
+   │    inherited by child processes and can be used to communicate with    │
+   │    them. Errors are returned as negative error numbers like system     │
+   │    calls do.                                                           │
+   │                                                                        │
+   │        (sync bytes)                                                    │
+   │        (advise bytes advice)                                           │
+   │                                                                        │
+   │    Flush changes to the file and advise the kernel about the           │
+   │    expected access pattern of mapped bytes or slices of them.          │
+   │    Advice is one of normal, random, sequential, will-need or           │
+   │    dont-need, or an integer.                                           │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(bytes_map_file)
+{
+	struct lone_lisp_value arguments, fd, mode;
+	struct stat status;
+	int protection, flags;
+	long result;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with a replacement arguments list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	mode = lone_lisp_nil();
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &fd)
+	 && lone_lisp_list_destructure(lone, arguments, 2, &fd, &mode)) {
+		/* wrong number of arguments: (map-file) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_is_nil(mode)) {
+		protection = PROT_READ;
+		flags = MAP_PRIVATE;
+	} else if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "private"))) {
+		protection = PROT_READ | PROT_WRITE;
+		flags = MAP_PRIVATE;
+	} else if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "shared"))) {
+		protection = PROT_READ | PROT_WRITE;
+		flags = MAP_SHARED;
+	} else {
+		goto type_error;
+	}
+
+	if (!lone_lisp_is_integer(lone, fd)
+	 || lone_lisp_integer_of(fd) < 0 || lone_lisp_integer_of(fd) > 0x7FFFFFFF) {
+		goto type_error;
+	}
+
+	result = linux_fstat((int) lone_lisp_integer_of(fd), &status);
+
+	if (result < 0) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+		return 0;
+	}
+
+	if (status.st_size <= 0) {
+		/* empty or unsized like pipes and most procfs files */
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(-EINVAL));
+		return 0;
+	}
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_bytes_mmap(lone, (size_t) status.st_size, protection, flags,
+					(int) lone_lisp_integer_of(fd), lone_lisp_is_nil(mode)));
+	return 0;
+
+type_error:
+	/* wrong types: (map-file "file") */
+	return
+		lone_lisp_signal_emit(
+			lone,
+			machine,
+			1,
+			lone->symbols.tags.type_error,
+			arguments
+		);
+}
+
+LONE_LISP_PRIMITIVE(bytes_map_memory)
+{
+	struct lone_lisp_value arguments, count, mode;
+	int flags;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with a replacement arguments list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	mode = lone_lisp_nil();
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &count)
+	 && lone_lisp_list_destructure(lone, arguments, 2, &count, &mode)) {
+		/* wrong number of arguments: (map-memory) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_is_nil(mode)) {
+		flags = MAP_PRIVATE | MAP_ANONYMOUS;
+	} else if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "shared"))) {
+		flags = MAP_SHARED | MAP_ANONYMOUS;
+	} else {
+		flags = 0;
+	}
+
+	if (!flags || !lone_lisp_is_integer(lone, count)) {
+		/* wrong types: (map-memory "4096") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_integer_of(count) <= 0) {
+		/* nothing to map: (map-memory 0) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.range_error,
+				arguments
+			);
+	}
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_bytes_mmap(lone, (size_t) lone_lisp_integer_of(count),
+					PROT_READ | PROT_WRITE, flags, -1, false));
+	return 0;
+}
+
+/* Computes the page aligned range covered by
+ * mapped bytes or by a slice of mapped bytes. */
+static bool lone_lisp_bytes_mapped_range(struct lone_lisp *lone,
+		struct lone_lisp_value bytes, void **address, size_t *length)
+{
+	struct lone_lisp_heap_value *actual, *root;
+	uintptr_t start, end, page_size;
+
+	if (!lone_lisp_is_bytes(lone, bytes) || lone_lisp_is_inline_value(bytes)) { return false; }
+
+	actual = lone_lisp_heap_value_of(lone, bytes);
+	root = actual->slice? lone_lisp_heap_value_of(lone, actual->as.bytes.parent) : actual;
+
+	if (!root->mapped) { return false; }
+
+	page_size = lone->system->allocator.page_size;
+	start = (uintptr_t) actual->as.bytes.data.pointer;
+	end = start + actual->as.bytes.data.count;
+	start &= ~(page_size - 1);
+
+	*address = (void *) start;
+	*length = end - start;
+	return true;
+}
+
+LONE_LISP_PRIMITIVE(bytes_sync)
+{
+	struct lone_lisp_value arguments, bytes;
+	size_t length;
+	void *address;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with a replacement arguments list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &bytes)) {
+		/* wrong number of arguments: (sync) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_bytes_mapped_range(lone, bytes, &address, &length)) {
+		/* not mapped: (sync (new 4096)) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_integer_create(linux_msync(address, length, MS_SYNC)));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(bytes_advise)
+{
+	struct lone_lisp_value arguments, bytes, advice;
+	size_t length;
+	void *address;
+	int number;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with a replacement arguments list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &bytes, &advice)) {
+		/* wrong number of arguments: (advise bytes) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_is_integer(lone, advice)) {
+		number = (int) lone_lisp_integer_of(advice);
+	} else if (lone_lisp_is_identical(lone, advice, lone_lisp_intern_c_string(lone, "normal"))) {
+		number = MADV_NORMAL;
+	} else if (lone_lisp_is_identical(lone, advice, lone_lisp_intern_c_string(lone, "random"))) {
+		number = MADV_RANDOM;
+	} else if (lone_lisp_is_identical(lone, advice, lone_lisp_intern_c_string(lone, "sequential"))) {
+		number = MADV_SEQUENTIAL;
+	} else if (lone_lisp_is_identical(lone, advice, lone_lisp_intern_c_string(lone, "will-need"))) {
+		number = MADV_WILLNEED;
+	} else if (lone_lisp_is_identical(lone, advice, lone_lisp_intern_c_string(lone, "dont-need"))) {
+		number = MADV_DONTNEED;
+	} else {
+		goto type_error;
+	}
+
+	if (!lone_lisp_bytes_mapped_range(lone, bytes, &address, &length)) { goto type_error; }
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_integer_create(linux_madvise(address, length, number)));
+	return 0;
+
+type_error:
+	/* wrong types: (advise (new 4096) 'sequential) */
+	return
+		lone_lisp_signal_emit(
+			lone,
+			machine,
+			1,
+			lone->symbols.tags.type_error,
+			arguments
+		);
+}
+
 #define LONE_LISP_BYTES_INTEGER_OVERFLOW_GUARD_8(sign)
 #define LONE_LISP_BYTES_INTEGER_OVERFLOW_GUARD_16(sign)
 #define LONE_LISP_BYTES_INTEGER_OVERFLOW_GUARD_32(sign)
@@ -311,7 +824,7 @@ LONE_LISP_PRIMITIVE(bytes_read_##sign##bits##endian)
 		break;                                                                             \
 	}                                                                                          \
                                                                                                    \
-	linux_exit(-1);                                                                            \
+	lone_lisp_exit(lone, -1);                                                                  \
                                                                                                    \
 destructure:                                                                                       \
                                                                                                    \
@@ -458,7 +971,7 @@ LONE_LISP_PRIMITIVE(bytes_write_##sign##bits##endian)
 		break;                                                                             \
 	}                                                                                          \
                                                                                                    \
-	linux_exit(-1);                                                                            \
+	lone_lisp_exit(lone, -1);                                                                  \
                                                                                                    \
 destructure:                                                                                       \
                                                                                                    \
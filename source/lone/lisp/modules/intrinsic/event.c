@@ -0,0 +1,636 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/modules/intrinsic/event.h>
+#include <lone/lisp/modules/intrinsic/lone.h>
+
+#include <lone/lisp/machine.h>
+#include <lone/lisp/machine/stack.h>
+#include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
+
+#include <lone/linux.h>
+
+void lone_lisp_modules_intrinsic_event_initialize(struct lone_lisp *lone)
+{
+	struct lone_lisp_value name, module, yield, quantum;
+	struct lone_lisp_function_flags flags;
+
+	name = lone_lisp_intern_c_string(lone, "event");
+	module = lone_lisp_module_for_name(lone, name);
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	/* requests are yielded to the scheduler through the yield primitive */
+	yield = lone_lisp_primitive_create(lone, "yield", lone_lisp_primitive_lone_yield, lone_lisp_nil(), flags);
+
+	/* number of lists a task may begin to evaluate before it is preempted */
+	quantum = lone_lisp_vector_create(lone, 1);
+	lone_lisp_vector_push(lone, quantum, lone_lisp_integer_create(LONE_LISP_EVENT_QUANTUM));
+
+	lone_lisp_module_export_primitive(lone, module, "run",
+			"event_run", lone_lisp_primitive_event_run, quantum, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "quantum",
+			"event_quantum", lone_lisp_primitive_event_quantum, quantum, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "readable",
+			"event_readable", lone_lisp_primitive_event_readable, yield, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "writable",
+			"event_writable", lone_lisp_primitive_event_writable, yield, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "spawn",
+			"event_spawn", lone_lisp_primitive_event_spawn, yield, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "sleep",
+			"event_sleep", lone_lisp_primitive_event_sleep, yield, flags);
+}
+
+static bool lone_lisp_event_is_file_descriptor(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_integer(lone, value)
+	    && lone_lisp_integer_of(value) >= 0
+	    && lone_lisp_integer_of(value) <= 0x7FFFFFFF;
+}
+
+static bool lone_lisp_event_is_finished(struct lone_lisp *lone, struct lone_lisp_value task)
+{
+	return !lone_lisp_heap_value_of(lone, task)->as.generator.stacks.own.top;
+}
+
+static void lone_lisp_event_schedule(struct lone_lisp *lone, struct lone_lisp_value runnable,
+		struct lone_lisp_value task, struct lone_lisp_value value)
+{
+	lone_lisp_vector_push(lone, runnable, task);
+	lone_lisp_vector_push(lone, runnable, value);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Tasks wait for readiness by yielding (fd events) requests.          │
+   │    The file descriptor is registered as a one shot event so that       │
+   │    it is disarmed as soon as it is reported and cannot wake the        │
+   │    scheduler again until its task asks for it once more. It is         │
+   │    added the first time and modified after that. Closing it            │
+   │    removes it from the epoll instance.                                 │
+   │                                                                        │
+   │    Tasks which cannot wait are resumed immediately with the error.     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static void lone_lisp_event_wait_for(struct lone_lisp *lone, int epoll,
+		struct lone_lisp_value runnable, struct lone_lisp_value waiting,
+		struct lone_lisp_value task, struct lone_lisp_value fd, struct lone_lisp_value events)
+{
+	struct epoll_event event;
+	long result;
+
+	if (!lone_lisp_is_nil(lone_lisp_table_get(lone, waiting, fd))) {
+		lone_lisp_event_schedule(lone, runnable, task, lone_lisp_integer_create(-EEXIST));
+		return;
+	}
+
+	event.events = (__poll_t) lone_lisp_integer_of(events) | EPOLLONESHOT;
+	event.data = (__u64) lone_lisp_integer_of(fd);
+
+	result = linux_epoll_ctl(epoll, EPOLL_CTL_MOD, (int) lone_lisp_integer_of(fd), &event);
+
+	if (result == -ENOENT) {
+		result = linux_epoll_ctl(epoll, EPOLL_CTL_ADD, (int) lone_lisp_integer_of(fd), &event);
+	}
+
+	if (result < 0) {
+		lone_lisp_event_schedule(lone, runnable, task, lone_lisp_integer_create(result));
+		return;
+	}
+
+	lone_lisp_table_set(lone, waiting, fd, task);
+}
+
+static void lone_lisp_event_dispatch(struct lone_lisp *lone, int epoll,
+		struct lone_lisp_value runnable, struct lone_lisp_value waiting,
+		struct lone_lisp_value task, struct lone_lisp_value request)
+{
+	struct lone_lisp_value fd, events;
+
+	if (lone_lisp_event_is_finished(lone, task)) {
+		/* the request is the task's return value */
+		return;
+	}
+
+	if (lone_lisp_is_generator(lone, request)) {
+		lone_lisp_event_schedule(lone, runnable, request, lone_lisp_nil());
+		lone_lisp_event_schedule(lone, runnable, task, lone_lisp_nil());
+		return;
+	}
+
+	if (lone_lisp_is_list(lone, request)
+	 && !lone_lisp_list_destructure(lone, request, 2, &fd, &events)
+	 && lone_lisp_event_is_file_descriptor(lone, fd)
+	 && lone_lisp_is_integer(lone, events)) {
+		lone_lisp_event_wait_for(lone, epoll, runnable, waiting, task, fd, events);
+		return;
+	}
+
+	lone_lisp_event_schedule(lone, runnable, task, lone_lisp_nil());
+}
+
+/* Blocks until some waiting tasks can run again.
+ * Returns zero or a negative error number. */
+static long lone_lisp_event_poll(struct lone_lisp *lone, int epoll,
+		struct lone_lisp_value runnable, struct lone_lisp_value waiting)
+{
+	struct epoll_event events[LONE_LISP_EVENT_BATCH_SIZE];
+	struct lone_lisp_value fd, task;
+	long count, i;
+
+	/* tasks' output must not wait for events which may never come */
+	lone_lisp_output_flush_all(lone);
+
+	do {
+		count = linux_epoll_wait(epoll, events, LONE_LISP_EVENT_BATCH_SIZE, -1);
+	} while (count == -EINTR);
+
+	if (count < 0) { return count; }
+
+	for (i = 0; i < count; ++i) {
+		fd = lone_lisp_integer_create((lone_lisp_integer) events[i].data);
+		task = lone_lisp_table_get(lone, waiting, fd);
+		lone_lisp_table_delete(lone, waiting, fd);
+		lone_lisp_event_schedule(lone, runnable, task, lone_lisp_integer_create(events[i].events));
+	}
+
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    The scheduler keeps its state on the lisp machine stack while       │
+   │    a task runs:                                                        │
+   │                                                                        │
+   │        epoll runnable head waiting task                                │
+   │                                                                        │
+   │    Runnable is a vector of tasks, each followed by the value to        │
+   │    resume it with. Head is the index of the next task to run. The      │
+   │    vector is emptied once every task in it has run. Waiting is a       │
+   │    table of tasks indexed by the file descriptor they wait for.        │
+   │    Task is the one which is currently running.                         │
+   │                                                                        │
+   │    The epoll instance is held by descriptor bytes. Tasks may escape    │
+   │    the scheduler through signals, abandoning its state: the epoll      │
+   │    instance is then closed by the garbage collector.                   │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(event_run)
+{
+	struct lone_lisp_value arguments, runnable, waiting, task, value, descriptor;
+	long epoll, result;
+	size_t head;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto validate;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot iterate */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto validate;
+
+	case 2: /* resumed after a task yielded, was preempted or finished */
+
+		machine->preemption.task = lone_lisp_nil();
+		machine->preemption.budget = 0;
+
+		task     = lone_lisp_machine_pop_value(lone, machine);
+		waiting  = lone_lisp_machine_pop_value(lone, machine);
+		head     = (size_t) lone_lisp_machine_pop_integer(lone, machine);
+		runnable   = lone_lisp_machine_pop_value(lone, machine);
+		descriptor = lone_lisp_machine_pop_value(lone, machine);
+
+		epoll = lone_lisp_bytes_descriptor_of(lone, descriptor);
+
+		lone_lisp_event_dispatch(lone, (int) epoll, runnable, waiting, task, machine->value);
+
+		goto schedule;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+validate:
+
+	for (value = arguments; !lone_lisp_is_nil(value); value = lone_lisp_list_rest(lone, value)) {
+		if (!lone_lisp_is_generator(lone, lone_lisp_list_first(lone, value))) {
+			/* not a task: (run 10) */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+	}
+
+	epoll = linux_epoll_create1(EPOLL_CLOEXEC);
+
+	if (epoll < 0) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(epoll));
+		return 0;
+	}
+
+	descriptor = lone_lisp_bytes_descriptor(lone, (int) epoll);
+	runnable = lone_lisp_vector_create(lone, 16);
+	waiting = lone_lisp_table_create(lone, 16, lone_lisp_nil());
+	head = 0;
+
+	for (value = arguments; !lone_lisp_is_nil(value); value = lone_lisp_list_rest(lone, value)) {
+		lone_lisp_event_schedule(lone, runnable, lone_lisp_list_first(lone, value), lone_lisp_nil());
+	}
+
+schedule:
+
+	if (head < lone_lisp_vector_count(lone, runnable)) {
+		task  = lone_lisp_vector_get_value_at(lone, runnable, head++);
+		value = lone_lisp_vector_get_value_at(lone, runnable, head++);
+
+		lone_lisp_machine_push_value(lone, machine, descriptor);
+		lone_lisp_machine_push_value(lone, machine, runnable);
+		lone_lisp_machine_push_integer(lone, machine, (lone_lisp_integer) head);
+		lone_lisp_machine_push_value(lone, machine, waiting);
+		lone_lisp_machine_push_value(lone, machine, task);
+
+		machine->preemption.task = task;
+		machine->preemption.budget = lone_lisp_integer_of(lone_lisp_vector_get_value_at(lone,
+				lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure, 0));
+
+		machine->applicable = task;
+		machine->list = lone_lisp_list_create(lone, value, lone_lisp_nil());
+		machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+		return 2;
+	}
+
+	lone_lisp_heap_value_of(lone, runnable)->as.vector.count = 0;
+	head = 0;
+
+	if (lone_lisp_table_count(lone, waiting) == 0) {
+		/* every task has finished */
+		lone_lisp_bytes_descriptor_close(lone, descriptor);
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+		return 0;
+	}
+
+	result = lone_lisp_event_poll(lone, (int) epoll, runnable, waiting);
+
+	if (result < 0) {
+		lone_lisp_bytes_descriptor_close(lone, descriptor);
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+		return 0;
+	}
+
+	goto schedule;
+}
+
+static long lone_lisp_event_request(struct lone_lisp *lone, struct lone_lisp_machine *machine,
+		long step, __poll_t events)
+{
+	struct lone_lisp_value arguments, fd, request;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	case 2: /* resumed by the scheduler */
+
+		lone_lisp_machine_push_value(lone, machine, machine->value);
+		return 0;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &fd)) {
+		/* wrong number of arguments: (readable) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_event_is_file_descriptor(lone, fd)) {
+		/* not a file descriptor: (readable "0") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	request = lone_lisp_integer_create((lone_lisp_integer) events);
+	request = lone_lisp_list_build(lone, 2, &fd, &request);
+
+	machine->applicable = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+	machine->list = lone_lisp_list_create(lone, request, lone_lisp_nil());
+	machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+	return 2;
+}
+
+LONE_LISP_PRIMITIVE(event_readable)
+{
+	return lone_lisp_event_request(lone, machine, step, EPOLLIN | EPOLLRDHUP);
+}
+
+LONE_LISP_PRIMITIVE(event_writable)
+{
+	return lone_lisp_event_request(lone, machine, step, EPOLLOUT);
+}
+
+LONE_LISP_PRIMITIVE(event_spawn)
+{
+	struct lone_lisp_value arguments, task;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	case 2: /* resumed by the scheduler */
+
+		lone_lisp_machine_push_value(lone, machine, machine->value);
+		return 0;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &task)) {
+		/* wrong number of arguments: (spawn) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_generator(lone, task)) {
+		/* not a task: (spawn 10) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	machine->applicable = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+	machine->list = lone_lisp_list_create(lone, task, lone_lisp_nil());
+	machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+	return 2;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Sleeping tasks wait for a one shot timer file descriptor to         │
+   │    become readable just like any other file descriptor. It is held     │
+   │    by descriptor bytes kept on the stack while the task waits and      │
+   │    closed afterwards. Tasks may escape: the collector closes it then.  │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(event_sleep)
+{
+	struct lone_lisp_value arguments, milliseconds, fd, request, descriptor;
+	struct __kernel_itimerspec timer = { 0 };
+	lone_lisp_integer duration;
+	long timerfd, result;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	case 2: /* resumed by the scheduler */
+
+		descriptor = lone_lisp_machine_pop_value(lone, machine);
+		lone_lisp_bytes_descriptor_close(lone, descriptor);
+		lone_lisp_machine_push_value(lone, machine, machine->value);
+		return 0;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &milliseconds)) {
+		/* wrong number of arguments: (sleep) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_integer(lone, milliseconds) || lone_lisp_integer_of(milliseconds) < 0) {
+		/* not a duration: (sleep -1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	timerfd = linux_timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (timerfd < 0) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(timerfd));
+		return 0;
+	}
+
+	duration = lone_lisp_integer_of(milliseconds);
+	timer.it_value.tv_sec  = duration / 1000;
+	timer.it_value.tv_nsec = (duration % 1000) * 1000000;
+
+	/* a zero expiration disarms the timer instead */
+	if (duration == 0) { timer.it_value.tv_nsec = 1; }
+
+	result = linux_timerfd_settime((int) timerfd, 0, &timer, 0);
+
+	if (result < 0) {
+		linux_close((int) timerfd);
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+		return 0;
+	}
+
+	descriptor = lone_lisp_bytes_descriptor(lone, (int) timerfd);
+	lone_lisp_machine_push_value(lone, machine, descriptor);
+
+	fd = lone_lisp_integer_create(timerfd);
+	request = lone_lisp_integer_create(EPOLLIN);
+	request = lone_lisp_list_build(lone, 2, &fd, &request);
+
+	machine->applicable = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+	machine->list = lone_lisp_list_create(lone, request, lone_lisp_nil());
+	machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+	return 2;
+}
+
+LONE_LISP_PRIMITIVE(event_quantum)
+{
+	struct lone_lisp_value quantum, arguments, lists;
+
+	quantum = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+
+	switch (step) {
+	case 0:
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+		break;
+	case 1: /* resumed with replacement argument list */
+		arguments = machine->value;
+		break;
+	default:
+		lone_lisp_exit(lone, -1);
+	}
+
+	if (lone_lisp_is_nil(arguments)) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_vector_get_value_at(lone, quantum, 0));
+		return 0;
+	}
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &lists)) {
+		/* wrong number of arguments: (quantum 1 2) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_integer(lone, lists) || lone_lisp_integer_of(lists) < 0) {
+		/* not a number of lists: (quantum -1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	lone_lisp_vector_set_value_at(lone, quantum, 0, lists);
+	lone_lisp_machine_push_value(lone, machine, lists);
+	return 0;
+}
@@ -0,0 +1,862 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/modules/intrinsic/io_uring.h>
+#include <lone/lisp/modules/intrinsic/lone.h>
+
+#include <lone/lisp/machine.h>
+#include <lone/lisp/machine/stack.h>
+#include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
+
+#include <lone/memory/functions.h>
+
+#include <lone/linux.h>
+
+void lone_lisp_modules_intrinsic_io_uring_initialize(struct lone_lisp *lone)
+{
+	struct lone_lisp_value name, module;
+	struct lone_lisp_function_flags flags;
+
+	name = lone_lisp_intern_c_string(lone, "io-uring");
+	module = lone_lisp_module_for_name(lone, name);
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	lone_lisp_module_export_primitive(lone, module, "setup",
+			"io_uring_setup", lone_lisp_primitive_io_uring_setup, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "read",
+			"io_uring_read", lone_lisp_primitive_io_uring_read, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "write",
+			"io_uring_write", lone_lisp_primitive_io_uring_write, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "accept",
+			"io_uring_accept", lone_lisp_primitive_io_uring_accept, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "openat",
+			"io_uring_openat", lone_lisp_primitive_io_uring_openat, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "close",
+			"io_uring_close", lone_lisp_primitive_io_uring_close, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "timeout",
+			"io_uring_timeout", lone_lisp_primitive_io_uring_timeout, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "submit",
+			"io_uring_submit", lone_lisp_primitive_io_uring_submit, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "complete",
+			"io_uring_complete", lone_lisp_primitive_io_uring_complete, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "release",
+			"io_uring_release", lone_lisp_primitive_io_uring_release, module, flags);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Rings are frozen bytes containing the ring structure which          │
+   │    points to the memory shared with the kernel. Lisp code cannot       │
+   │    change them. Their parent is the in-flight table which maps the     │
+   │    user data of every submitted operation to a list of its tag and     │
+   │    the values which must outlive it. The garbage collector keeps       │
+   │    it alive along with the ring and finalizes rings which become       │
+   │    unreachable before they are released.                               │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static struct lone_lisp_io_uring *lone_lisp_io_uring_of(struct lone_lisp *lone, struct lone_lisp_value ring)
+{
+	struct lone_lisp_heap_value *actual;
+
+	if (!lone_lisp_is_bytes(lone, ring) || lone_lisp_is_inline_value(ring)) { return 0; }
+
+	actual = lone_lisp_heap_value_of(lone, ring);
+	if (!actual->io_uring) { /* not a ring or released */ return 0; }
+
+	return (struct lone_lisp_io_uring *) actual->as.bytes.data.pointer;
+}
+
+static struct lone_lisp_value lone_lisp_io_uring_in_flight(struct lone_lisp *lone, struct lone_lisp_value ring)
+{
+	return lone_lisp_heap_value_of(lone, ring)->as.bytes.parent;
+}
+
+static void lone_lisp_io_uring_unmap(struct lone_lisp_io_uring *io_uring)
+{
+	if (io_uring->submission.sqes) {
+		linux_munmap(io_uring->submission.sqes, io_uring->submission.sqes_size);
+	}
+
+	if (io_uring->completion.ring && io_uring->completion.ring != io_uring->submission.ring) {
+		linux_munmap(io_uring->completion.ring, io_uring->completion.size);
+	}
+
+	if (io_uring->submission.ring) {
+		linux_munmap(io_uring->submission.ring, io_uring->submission.size);
+	}
+}
+
+static long lone_lisp_io_uring_map(struct lone_lisp_io_uring *io_uring, struct io_uring_params *parameters)
+{
+	unsigned char *submission, *completion;
+	intptr_t result;
+
+	io_uring->submission.size = parameters->sq_off.array + parameters->sq_entries * sizeof(unsigned int);
+	io_uring->completion.size = parameters->cq_off.cqes + parameters->cq_entries * sizeof(struct io_uring_cqe);
+
+	if (parameters->features & IORING_FEAT_SINGLE_MMAP) {
+		if (io_uring->completion.size > io_uring->submission.size) {
+			io_uring->submission.size = io_uring->completion.size;
+		}
+		io_uring->completion.size = io_uring->submission.size;
+	}
+
+	result = linux_mmap(0, io_uring->submission.size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, io_uring->fd, IORING_OFF_SQ_RING);
+	if (result < 0) { return result; }
+	io_uring->submission.ring = (void *) result;
+
+	if (parameters->features & IORING_FEAT_SINGLE_MMAP) {
+		io_uring->completion.ring = io_uring->submission.ring;
+	} else {
+		result = linux_mmap(0, io_uring->completion.size, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, io_uring->fd, IORING_OFF_CQ_RING);
+		if (result < 0) { return result; }
+		io_uring->completion.ring = (void *) result;
+	}
+
+	io_uring->submission.sqes_size = parameters->sq_entries * sizeof(struct io_uring_sqe);
+	result = linux_mmap(0, io_uring->submission.sqes_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, io_uring->fd, IORING_OFF_SQES);
+	if (result < 0) { return result; }
+	io_uring->submission.sqes = (struct io_uring_sqe *) result;
+
+	submission = io_uring->submission.ring;
+	io_uring->submission.head    = (unsigned int *) (submission + parameters->sq_off.head);
+	io_uring->submission.tail    = (unsigned int *) (submission + parameters->sq_off.tail);
+	io_uring->submission.mask    = (unsigned int *) (submission + parameters->sq_off.ring_mask);
+	io_uring->submission.entries = (unsigned int *) (submission + parameters->sq_off.ring_entries);
+	io_uring->submission.array   = (unsigned int *) (submission + parameters->sq_off.array);
+
+	completion = io_uring->completion.ring;
+	io_uring->completion.head    = (unsigned int *) (completion + parameters->cq_off.head);
+	io_uring->completion.tail    = (unsigned int *) (completion + parameters->cq_off.tail);
+	io_uring->completion.mask    = (unsigned int *) (completion + parameters->cq_off.ring_mask);
+	io_uring->completion.cqes    = (struct io_uring_cqe *) (completion + parameters->cq_off.cqes);
+
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(io_uring_setup)
+{
+	struct lone_lisp_value arguments, entries, ring, in_flight;
+	struct lone_lisp_heap_value *actual;
+	struct lone_lisp_io_uring *io_uring;
+	struct io_uring_params parameters;
+	long result;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &entries)) {
+		/* wrong number of arguments: (setup) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_integer(lone, entries)) {
+		/* not a number of entries: (setup "8") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_integer_of(entries) <= 0 || lone_lisp_integer_of(entries) > 32768) {
+		/* the kernel's limit on submission ring entries */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.range_error,
+				arguments
+			);
+	}
+
+	ring = lone_lisp_bytes_create(lone, sizeof(*io_uring));
+	io_uring = (struct lone_lisp_io_uring *) lone_lisp_heap_value_of(lone, ring)->as.bytes.data.pointer;
+	lone_memory_zero(io_uring, sizeof(*io_uring));
+	lone_memory_zero(&parameters, sizeof(parameters));
+
+	result = linux_io_uring_setup((unsigned int) lone_lisp_integer_of(entries), &parameters);
+
+	if (result < 0) { goto error; }
+
+	io_uring->fd = (int) result;
+	result = lone_lisp_io_uring_map(io_uring, &parameters);
+
+	if (result < 0) {
+		lone_lisp_io_uring_unmap(io_uring);
+		linux_close(io_uring->fd);
+		goto error;
+	}
+
+	in_flight = lone_lisp_table_create(lone, parameters.sq_entries, lone_lisp_nil());
+
+	actual = lone_lisp_heap_value_of(lone, ring);
+	actual->as.bytes.parent = in_flight;
+	actual->frozen = true;
+	actual->io_uring = true;
+	++lone->heap.rings;
+
+	lone_lisp_machine_push_value(lone, machine, ring);
+	return 0;
+
+error:
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Entries are written at the tail of the submission ring which        │
+   │    only the kernel consumes. The new tail is published with release    │
+   │    semantics so that the kernel never sees it before the entry.        │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static struct io_uring_sqe *lone_lisp_io_uring_next(struct lone_lisp_io_uring *io_uring)
+{
+	unsigned int head, tail, index;
+	struct io_uring_sqe *sqe;
+
+	head = __atomic_load_n(io_uring->submission.head, __ATOMIC_ACQUIRE);
+	tail = *io_uring->submission.tail;
+
+	if (tail - head >= *io_uring->submission.entries) { /* full */ return 0; }
+
+	index = tail & *io_uring->submission.mask;
+	sqe = &io_uring->submission.sqes[index];
+	lone_memory_zero(sqe, sizeof(*sqe));
+	io_uring->submission.array[index] = index;
+
+	return sqe;
+}
+
+static void lone_lisp_io_uring_queue(struct lone_lisp *lone, struct lone_lisp_value ring,
+		struct lone_lisp_io_uring *io_uring, struct io_uring_sqe *sqe, struct lone_lisp_value in_flight)
+{
+	struct lone_lisp_value key;
+
+	sqe->user_data = ++io_uring->next_tag;
+	key = lone_lisp_integer_create((lone_lisp_integer) (sqe->user_data & LONE_LISP_INTEGER_MAX));
+	lone_lisp_table_set(lone, lone_lisp_io_uring_in_flight(lone, ring), key, in_flight);
+
+	__atomic_store_n(io_uring->submission.tail, *io_uring->submission.tail + 1, __ATOMIC_RELEASE);
+	++io_uring->queued;
+}
+
+static bool lone_lisp_io_uring_is_file_descriptor(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_integer(lone, value)
+	    && lone_lisp_integer_of(value) >= -100 /* AT_FDCWD */
+	    && lone_lisp_integer_of(value) <= 0x7FFFFFFF;
+}
+
+static long lone_lisp_io_uring_operation(struct lone_lisp *lone, struct lone_lisp_machine *machine,
+		long step, enum io_uring_op operation)
+{
+	struct lone_lisp_value arguments, ring, fd, buffer, offset, flags, mode, tag, in_flight;
+	struct lone_lisp_io_uring *io_uring;
+	struct __kernel_timespec *time;
+	struct io_uring_sqe *sqe;
+	struct lone_bytes bytes;
+	lone_lisp_integer nanoseconds;
+	int failed;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	fd = buffer = offset = flags = mode = lone_lisp_integer_create(0);
+
+	switch (operation) {
+	case IORING_OP_READ:
+	case IORING_OP_WRITE:
+		failed = lone_lisp_list_destructure(lone, arguments, 5, &ring, &fd, &buffer, &offset, &tag);
+		break;
+	case IORING_OP_OPENAT:
+		failed = lone_lisp_list_destructure(lone, arguments, 6, &ring, &fd, &buffer, &flags, &mode, &tag);
+		break;
+	case IORING_OP_TIMEOUT:
+		failed = lone_lisp_list_destructure(lone, arguments, 3, &ring, &offset, &tag);
+		break;
+	case IORING_OP_ACCEPT:
+	case IORING_OP_CLOSE:
+	default:
+		failed = lone_lisp_list_destructure(lone, arguments, 3, &ring, &fd, &tag);
+		break;
+	}
+
+	if (failed) {
+		/* wrong number of arguments: (close ring) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	io_uring = lone_lisp_io_uring_of(lone, ring);
+
+	switch (operation) {
+	case IORING_OP_READ:
+		failed = !lone_lisp_is_bytes(lone, buffer);
+		break;
+	case IORING_OP_WRITE:
+		failed = !lone_lisp_is_bytes(lone, buffer) && !lone_lisp_is_text(lone, buffer);
+		break;
+	case IORING_OP_OPENAT:
+		failed = !lone_lisp_is_text(lone, buffer);
+		break;
+	default:
+		failed = false;
+		break;
+	}
+
+	if (!io_uring || failed
+	 || !lone_lisp_io_uring_is_file_descriptor(lone, fd)
+	 || !lone_lisp_is_integer(lone, offset) || lone_lisp_integer_of(offset) < -1
+	 || (operation == IORING_OP_TIMEOUT && lone_lisp_integer_of(offset) < 0)
+	 || !lone_lisp_is_integer(lone, flags)
+	 || !lone_lisp_is_integer(lone, mode)) {
+		/* wrong types: (read ring 0 "text" 0 'tag) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	if (operation == IORING_OP_READ && lone_lisp_is_frozen(lone, buffer)) {
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.frozen_error,
+				arguments
+			);
+	}
+
+	if (operation == IORING_OP_TIMEOUT) {
+		/* the kernel reads the time when the operation is submitted */
+		buffer = lone_lisp_bytes_create(lone, sizeof(*time));
+		time = (struct __kernel_timespec *) lone_lisp_heap_value_of(lone, buffer)->as.bytes.data.pointer;
+		nanoseconds = lone_lisp_integer_of(offset);
+		time->tv_sec = nanoseconds / 1000000000;
+		time->tv_nsec = nanoseconds % 1000000000;
+	} else if (operation == IORING_OP_OPENAT && lone_lisp_is_heap_value(buffer)
+	           && lone_lisp_heap_value_of(lone, buffer)->slice) {
+		/* paths must be null terminated: slices are copied */
+		bytes = lone_lisp_bytes_of(lone, &buffer);
+		buffer = lone_lisp_text_copy(lone, bytes.pointer, bytes.count);
+	}
+
+	sqe = lone_lisp_io_uring_next(io_uring);
+
+	if (!sqe) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_false());
+		return 0;
+	}
+
+	sqe->opcode = (__u8) operation;
+	sqe->fd = (__s32) lone_lisp_integer_of(fd);
+
+	switch (operation) {
+	case IORING_OP_READ:
+	case IORING_OP_WRITE:
+		bytes = lone_lisp_bytes_of(lone, &buffer);
+		if (lone_lisp_is_inline_value(buffer)) {
+			/* inline values live in the argument list which may move, copy them out */
+			buffer = lone_lisp_bytes_create(lone, bytes.count);
+			lone_memory_move(bytes.pointer,
+					lone_lisp_heap_value_of(lone, buffer)->as.bytes.data.pointer, bytes.count);
+			bytes = lone_lisp_heap_value_of(lone, buffer)->as.bytes.data;
+		}
+		sqe->addr = (__u64) bytes.pointer;
+		sqe->len = (__u32) bytes.count;
+		sqe->off = (__u64) lone_lisp_integer_of(offset);
+		break;
+	case IORING_OP_OPENAT:
+		sqe->addr = (__u64) lone_lisp_bytes_of(lone, &buffer).pointer;
+		sqe->len = (__u32) lone_lisp_integer_of(mode);
+		sqe->open_flags = (__u32) lone_lisp_integer_of(flags);
+		break;
+	case IORING_OP_TIMEOUT:
+		sqe->fd = -1;
+		sqe->addr = (__u64) lone_lisp_heap_value_of(lone, buffer)->as.bytes.data.pointer;
+		sqe->len = 1;
+		break;
+	case IORING_OP_ACCEPT:
+		sqe->accept_flags = O_CLOEXEC;
+		break;
+	case IORING_OP_CLOSE:
+	default:
+		break;
+	}
+
+	in_flight = lone_lisp_list_build(lone, 2, &tag, &buffer);
+	lone_lisp_io_uring_queue(lone, ring, io_uring, sqe, in_flight);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_true());
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(io_uring_read)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_READ);
+}
+
+LONE_LISP_PRIMITIVE(io_uring_write)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_WRITE);
+}
+
+LONE_LISP_PRIMITIVE(io_uring_accept)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_ACCEPT);
+}
+
+LONE_LISP_PRIMITIVE(io_uring_openat)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_OPENAT);
+}
+
+LONE_LISP_PRIMITIVE(io_uring_close)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_CLOSE);
+}
+
+LONE_LISP_PRIMITIVE(io_uring_timeout)
+{
+	return lone_lisp_io_uring_operation(lone, machine, step, IORING_OP_TIMEOUT);
+}
+
+static long lone_lisp_io_uring_enter(struct lone_lisp_io_uring *io_uring, unsigned int wait)
+{
+	long result;
+
+	do {
+		result = linux_io_uring_enter(io_uring->fd, io_uring->queued, wait,
+				wait? IORING_ENTER_GETEVENTS : 0);
+	} while (result == -EINTR);
+
+	if (result > 0) { io_uring->queued -= (unsigned int) result; }
+
+	return result;
+}
+
+/* (submit ring) (submit ring wait)
+ * Returns the number of operations submitted
+ * or a negative error number. */
+LONE_LISP_PRIMITIVE(io_uring_submit)
+{
+	struct lone_lisp_value arguments, ring, wait;
+	struct lone_lisp_io_uring *io_uring;
+	long result;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	wait = lone_lisp_integer_create(0);
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &ring)
+	 && lone_lisp_list_destructure(lone, arguments, 2, &ring, &wait)) {
+		/* wrong number of arguments: (submit) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	io_uring = lone_lisp_io_uring_of(lone, ring);
+
+	if (!io_uring || !lone_lisp_is_integer(lone, wait) || lone_lisp_integer_of(wait) < 0) {
+		/* wrong types: (submit ring "1") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	/* submitted writes must not overtake buffered output */
+	lone_lisp_output_flush_all(lone);
+
+	result = lone_lisp_io_uring_enter(io_uring, (unsigned int) lone_lisp_integer_of(wait));
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Completions are consumed from the head of the completion ring.      │
+   │    They are read back to front so that the list is built in order      │
+   │    without reversing it. The new head is published afterwards so       │
+   │    that the kernel does not reuse the entries while they are read.     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(io_uring_complete)
+{
+	struct lone_lisp_value arguments, ring, in_flight, key, entry, result, completions;
+	struct lone_lisp_io_uring *io_uring;
+	struct io_uring_cqe *cqe;
+	unsigned int head, tail, i;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &ring)) {
+		/* wrong number of arguments: (complete) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	io_uring = lone_lisp_io_uring_of(lone, ring);
+
+	if (!io_uring) {
+		/* not a ring: (complete 10) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	in_flight = lone_lisp_io_uring_in_flight(lone, ring);
+	head = *io_uring->completion.head;
+	tail = __atomic_load_n(io_uring->completion.tail, __ATOMIC_ACQUIRE);
+	completions = lone_lisp_nil();
+
+	for (i = tail; i != head; --i) {
+		cqe = &io_uring->completion.cqes[(i - 1) & *io_uring->completion.mask];
+
+		key = lone_lisp_integer_create((lone_lisp_integer) (cqe->user_data & LONE_LISP_INTEGER_MAX));
+		entry = lone_lisp_table_get(lone, in_flight, key);
+		lone_lisp_table_delete(lone, in_flight, key);
+
+		result = lone_lisp_integer_create(cqe->res);
+		entry = lone_lisp_list_is_proper(lone, entry)? lone_lisp_list_first(lone, entry) : lone_lisp_nil();
+		entry = lone_lisp_list_build(lone, 2, &entry, &result);
+		completions = lone_lisp_list_create(lone, entry, completions);
+	}
+
+	__atomic_store_n(io_uring->completion.head, tail, __ATOMIC_RELEASE);
+
+	lone_lisp_machine_push_value(lone, machine, completions);
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Released rings cancel every operation still in flight and wait      │
+   │    for all of them to complete before the shared memory is unmapped.   │
+   │    Their buffers remain reachable through the in-flight table until    │
+   │    the kernel is done with them. Cancellations are tagged with zero    │
+   │    which is never the user data of an operation. Unreachable rings     │
+   │    are finalized the same way before any of their buffers are swept.   │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static void lone_lisp_io_uring_reap(struct lone_lisp *lone,
+		struct lone_lisp_io_uring *io_uring, struct lone_lisp_value in_flight)
+{
+	struct io_uring_cqe *cqe;
+	unsigned int head, tail;
+
+	head = *io_uring->completion.head;
+	tail = __atomic_load_n(io_uring->completion.tail, __ATOMIC_ACQUIRE);
+
+	for (; head != tail; ++head) {
+		cqe = &io_uring->completion.cqes[head & *io_uring->completion.mask];
+		if (cqe->user_data == 0) { /* cancellation */ continue; }
+		lone_lisp_table_delete(lone, in_flight,
+				lone_lisp_integer_create((lone_lisp_integer) (cqe->user_data & LONE_LISP_INTEGER_MAX)));
+	}
+
+	__atomic_store_n(io_uring->completion.head, tail, __ATOMIC_RELEASE);
+}
+
+static void lone_lisp_io_uring_drain(struct lone_lisp *lone,
+		struct lone_lisp_io_uring *io_uring, struct lone_lisp_value in_flight)
+{
+	struct lone_lisp_table_entry entry;
+	struct io_uring_sqe *sqe;
+	long result;
+	size_t i;
+
+	LONE_LISP_TABLE_FOR_EACH(lone, entry, in_flight, i) {
+		while (!(sqe = lone_lisp_io_uring_next(io_uring))) {
+			if (lone_lisp_io_uring_enter(io_uring, 0) < 0) { return; }
+		}
+
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = (__u64) lone_lisp_integer_of(entry.key);
+		sqe->user_data = 0;
+
+		__atomic_store_n(io_uring->submission.tail, *io_uring->submission.tail + 1, __ATOMIC_RELEASE);
+		++io_uring->queued;
+	}
+
+	while (lone_lisp_table_count(lone, in_flight) > 0) {
+		result = lone_lisp_io_uring_enter(io_uring, 1);
+		if (result < 0 && result != -EBUSY) { /* closing the ring cancels the rest */ return; }
+		lone_lisp_io_uring_reap(lone, io_uring, in_flight);
+	}
+}
+
+void lone_lisp_io_uring_finalize(struct lone_lisp *lone, struct lone_lisp_value ring)
+{
+	struct lone_lisp_heap_value *actual;
+	struct lone_lisp_io_uring *io_uring;
+
+	io_uring = lone_lisp_io_uring_of(lone, ring);
+	if (!io_uring) { return; }
+
+	lone_lisp_io_uring_drain(lone, io_uring, lone_lisp_io_uring_in_flight(lone, ring));
+	lone_lisp_io_uring_unmap(io_uring);
+	linux_close(io_uring->fd);
+	io_uring->fd = -1;
+
+	actual = lone_lisp_heap_value_of(lone, ring);
+	actual->as.bytes.parent = lone_lisp_nil();
+	actual->io_uring = false;
+	--lone->heap.rings;
+}
+
+LONE_LISP_PRIMITIVE(io_uring_release)
+{
+	struct lone_lisp_value arguments, ring;
+	struct lone_lisp_io_uring *io_uring;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &ring)) {
+		/* wrong number of arguments: (release) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	io_uring = lone_lisp_io_uring_of(lone, ring);
+
+	if (!io_uring) {
+		/* not a ring or already released: (release 10) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	lone_lisp_io_uring_finalize(lone, ring);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+	return 0;
+}
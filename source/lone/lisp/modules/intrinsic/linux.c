@@ -5,7 +5,13 @@
 
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
+#include <lone/lisp/machine/interrupt.h>
+#include <lone/lisp/garbage_collector.h>
 #include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
+
+#include <lone/memory/array.h>
+#include <lone/memory/allocator.h>
 
 #include <lone/linux.h>
 
@@ -284,11 +290,59 @@ static void lone_lisp_fill_linux_system_call_table(struct lone_lisp *lone, struc
 	}
 }
 
+static void lone_lisp_fill_linux_signal_table(struct lone_lisp *lone, struct lone_lisp_value linux_signal_table)
+{
+	size_t i;
+
+	static struct linux_signal {
+		char *symbol;
+		lone_lisp_integer number;
+	} linux_signals[] = {
+		{ "SIGHUP",    SIGHUP    },
+		{ "SIGINT",    SIGINT    },
+		{ "SIGQUIT",   SIGQUIT   },
+		{ "SIGILL",    SIGILL    },
+		{ "SIGTRAP",   SIGTRAP   },
+		{ "SIGABRT",   SIGABRT   },
+		{ "SIGBUS",    SIGBUS    },
+		{ "SIGFPE",    SIGFPE    },
+		{ "SIGKILL",   SIGKILL   },
+		{ "SIGUSR1",   SIGUSR1   },
+		{ "SIGSEGV",   SIGSEGV   },
+		{ "SIGUSR2",   SIGUSR2   },
+		{ "SIGPIPE",   SIGPIPE   },
+		{ "SIGALRM",   SIGALRM   },
+		{ "SIGTERM",   SIGTERM   },
+		{ "SIGCHLD",   SIGCHLD   },
+		{ "SIGCONT",   SIGCONT   },
+		{ "SIGSTOP",   SIGSTOP   },
+		{ "SIGTSTP",   SIGTSTP   },
+		{ "SIGTTIN",   SIGTTIN   },
+		{ "SIGTTOU",   SIGTTOU   },
+		{ "SIGURG",    SIGURG    },
+		{ "SIGXCPU",   SIGXCPU   },
+		{ "SIGXFSZ",   SIGXFSZ   },
+		{ "SIGVTALRM", SIGVTALRM },
+		{ "SIGPROF",   SIGPROF   },
+		{ "SIGWINCH",  SIGWINCH  },
+		{ "SIGIO",     SIGIO     },
+		{ "SIGPWR",    SIGPWR    },
+		{ "SIGSYS",    SIGSYS    },
+	};
+
+	for (i = 0; i < (sizeof(linux_signals)/sizeof(linux_signals[0])); ++i) {
+		lone_lisp_table_set(lone, linux_signal_table,
+				lone_lisp_intern_c_string(lone, linux_signals[i].symbol),
+				lone_lisp_integer_create(linux_signals[i].number));
+	}
+}
+
 void lone_lisp_modules_intrinsic_linux_initialize(struct lone_lisp *lone,
 		int argc, char **argv, char **envp,
 		struct lone_auxiliary_vector *auxv)
 {
-	struct lone_lisp_value name, module, linux_system_call_table, count, arguments, environment, auxiliary_vector;
+	struct lone_lisp_value name, module, linux_system_call_table, linux_signal_table,
+	                       count, arguments, environment, auxiliary_vector;
 	struct lone_lisp_function_flags flags;
 
 	name = lone_lisp_intern_c_string(lone, "linux");
@@ -297,6 +351,9 @@ void lone_lisp_modules_intrinsic_linux_initialize(struct lone_lisp *lone,
 
 	lone_lisp_fill_linux_system_call_table(lone, linux_system_call_table);
 
+	linux_signal_table = lone_lisp_table_create(lone, 64, lone_lisp_nil());
+	lone_lisp_fill_linux_signal_table(lone, linux_signal_table);
+
 	count = lone_lisp_integer_create(argc);
 	arguments = lone_lisp_arguments_to_vector(lone, argc, argv);
 	environment = lone_lisp_environment_to_table(lone, envp);
@@ -308,10 +365,32 @@ void lone_lisp_modules_intrinsic_linux_initialize(struct lone_lisp *lone,
 	lone_lisp_module_set_and_export_c_string(lone, module, "auxiliary-vector", auxiliary_vector);
 
 	lone_lisp_module_set_and_export_c_string(lone, module, "system-call-table", linux_system_call_table);
+	lone_lisp_module_set_and_export_c_string(lone, module, "signal-table", linux_signal_table);
 
 	flags = (struct lone_lisp_function_flags) { .evaluate_arguments = true, .evaluate_result = false };
 	lone_lisp_module_export_primitive(lone, module, "system-call",
 			"linux_system_call", lone_lisp_primitive_linux_system_call, linux_system_call_table, flags);
+	lone_lisp_module_export_primitive(lone, module, "system-call-batch",
+			"linux_system_call_batch", lone_lisp_primitive_linux_system_call_batch, linux_system_call_table, flags);
+	lone_lisp_module_export_primitive(lone, module, "system-call-function",
+			"linux_system_call_function", lone_lisp_primitive_linux_system_call_function, linux_system_call_table, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "sendfile",
+			"linux_sendfile", lone_lisp_primitive_linux_sendfile, module, flags);
+	lone_lisp_module_export_primitive(lone, module, "splice",
+			"linux_splice", lone_lisp_primitive_linux_splice, module, flags);
+	lone_lisp_module_export_primitive(lone, module, "tee",
+			"linux_tee", lone_lisp_primitive_linux_tee, module, flags);
+	lone_lisp_module_export_primitive(lone, module, "copy-file-range",
+			"linux_copy_file_range", lone_lisp_primitive_linux_copy_file_range, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "handle-signal",
+			"linux_handle_signal", lone_lisp_primitive_linux_handle_signal, linux_signal_table, flags);
+	lone_lisp_module_export_primitive(lone, module, "signal-descriptor",
+			"linux_signal_descriptor", lone_lisp_primitive_linux_signal_descriptor, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "prefork",
+			"linux_prefork", lone_lisp_primitive_linux_prefork, module, flags);
 }
 
 static inline struct lone_lisp_optional_value
@@ -355,6 +434,8 @@ static inline bool
 lone_lisp_value_to_linux_system_call_argument(struct lone_lisp *lone,
 		struct lone_lisp_value *value, long *number)
 {
+	struct lone_bytes bytes;
+
 	switch (lone_lisp_type_of(*value)) {
 	case LONE_LISP_TAG_NIL:
 	case LONE_LISP_TAG_FALSE:
@@ -366,8 +447,16 @@ lone_lisp_value_to_linux_system_call_argument(struct lone_lisp *lone,
 	case LONE_LISP_TAG_INTEGER:
 		*number = (long) lone_lisp_integer_of(*value);
 		return true;
-	case LONE_LISP_TAG_BYTES:
 	case LONE_LISP_TAG_TEXT:
+		/* the kernel reads text as null terminated strings but text
+		 * slices are not terminated: the call gets a temporary copy */
+		if (lone_lisp_is_heap_value(*value) && lone_lisp_heap_value_of(lone, *value)->slice) {
+			bytes = lone_lisp_bytes_of(lone, value);
+			*value = lone_lisp_text_copy(lone, bytes.pointer, bytes.count);
+		}
+		__attribute__((fallthrough));
+	case LONE_LISP_TAG_BYTES:
+		/* bytes are passed in place so that reads fill the caller's memory */
 	case LONE_LISP_TAG_SYMBOL:
 		*number = (long) lone_lisp_bytes_of(lone, value).pointer;
 		return true;
@@ -388,6 +477,29 @@ lone_lisp_value_to_linux_system_call_argument(struct lone_lisp *lone,
 	}
 }
 
+/* Output streams belong to files, not to file descriptor numbers.
+ * Streams are forgotten when their descriptors are closed or replaced
+ * so that unrelated files opened later do not inherit them.
+ */
+static void lone_lisp_linux_system_call_finished(struct lone_lisp *lone, long number, long *args, long result)
+{
+	if (result < 0) { return; }
+
+	switch (number) {
+	case __NR_close:
+		lone_lisp_output_close(lone, (int) args[0]);
+		break;
+#ifdef __NR_dup2
+	case __NR_dup2:
+#endif
+	case __NR_dup3:
+		if (args[0] != args[1]) { lone_lisp_output_close(lone, (int) args[1]); }
+		break;
+	default:
+		break;
+	}
+}
+
 LONE_LISP_PRIMITIVE(linux_system_call)
 {
 	struct lone_lisp_value linux_system_call_table, arguments, number_value;
@@ -541,8 +653,858 @@ check_extra_arguments:
 
 	number = lone_lisp_integer_of(number_value);
 
+	/* the system call could touch any buffered file descriptor */
+	lone_lisp_output_flush_all(lone);
+
 	result = linux_system_call_6(number, args[0], args[1], args[2], args[3], args[4], args[5]);
+	lone_lisp_linux_system_call_finished(lone, number, args, result);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Batched system calls.                                               │
+   │                                                                        │
+   │        (system-call-batch calls)                                       │
+   │        (system-call-batch calls stop-on-error)                         │
+   │                                                                        │
+   │    Calls is a vector or list of call descriptions. Each description    │
+   │    is a list or vector with the same elements as the arguments of      │
+   │    system-call. Every description is validated and its number is       │
+   │    resolved before any call is made so that an invalid batch has no    │
+   │    effect. The calls are then made in order and a vector with their    │
+   │    results is returned. When stop-on-error is true, the first          │
+   │    negative result ends the batch and is the last result returned.     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static bool lone_lisp_linux_system_call_description(struct lone_lisp *lone,
+		struct lone_lisp_value description, struct lone_lisp_value values[7], unsigned char *count)
+{
+	size_t i;
+
+	*count = 0;
+
+	switch (lone_lisp_type_of(description)) {
+	case LONE_LISP_TAG_LIST:
+		while (!lone_lisp_is_nil(description)) {
+			if (*count >= 7 || !lone_lisp_is_list(lone, description)) { return false; }
+			values[(*count)++] = lone_lisp_list_first(lone, description);
+			description = lone_lisp_list_rest(lone, description);
+		}
+		break;
+	case LONE_LISP_TAG_VECTOR:
+		if (lone_lisp_vector_count(lone, description) > 7) { return false; }
+		for (i = 0; i < lone_lisp_vector_count(lone, description); ++i) {
+			values[(*count)++] = lone_lisp_vector_get_value_at(lone, description, i);
+		}
+		break;
+	default:
+		return false;
+	}
+
+	for (i = *count; i < 7; ++i) { values[i] = lone_lisp_nil(); }
+
+	return *count > 0;
+}
+
+/* Validated calls. Arguments converted from inline values point
+ * into the values kept here, which must outlive the calls. */
+struct lone_lisp_linux_system_call {
+	long number;
+	long args[6];
+	struct lone_lisp_value values[6];
+};
+
+static struct lone_lisp_value lone_lisp_linux_system_call_batch_at(struct lone_lisp *lone,
+		struct lone_lisp_value *calls, size_t i)
+{
+	struct lone_lisp_value call;
+
+	if (lone_lisp_is_vector(lone, *calls)) {
+		return lone_lisp_vector_get_value_at(lone, *calls, i);
+	}
+
+	/* lists are consumed as they are walked */
+	call = lone_lisp_list_first(lone, *calls);
+	*calls = lone_lisp_list_rest(lone, *calls);
+	return call;
+}
+
+LONE_LISP_PRIMITIVE(linux_system_call_batch)
+{
+	struct lone_lisp_value linux_system_call_table, arguments, calls, remaining, stop_on_error, results;
+	struct lone_lisp_linux_system_call *batch, *call;
+	struct lone_lisp_optional_value number;
+	struct lone_lisp_value values[7];
+	unsigned char count, j;
+	size_t i, n;
+	long result;
+
+	linux_system_call_table = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_list_is_proper(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	stop_on_error = lone_lisp_false();
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &calls)
+	 && lone_lisp_list_destructure(lone, arguments, 2, &calls, &stop_on_error)) {
+		/* wrong number of arguments: (system-call-batch) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_is_vector(lone, calls)) {
+		n = lone_lisp_vector_count(lone, calls);
+	} else if (lone_lisp_list_is_proper(lone, calls)) {
+		for (n = 0, remaining = calls; !lone_lisp_is_nil(remaining); ++n) {
+			remaining = lone_lisp_list_rest(lone, remaining);
+		}
+	} else {
+		/* not a batch: (system-call-batch 10) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	/* validate everything before making any calls */
+	batch = n? lone_memory_array(lone->system, 0, 0, n, sizeof(*batch), alignof(*batch)) : 0;
+
+	for (i = 0, remaining = calls; i < n; ++i) {
+		call = &batch[i];
+
+		if (!lone_lisp_linux_system_call_description(lone,
+				lone_lisp_linux_system_call_batch_at(lone, &remaining, i), values, &count)) {
+			goto invalid;
+		}
+
+		number = lone_lisp_value_to_linux_system_call_number(lone, linux_system_call_table, values[0]);
+		if (!number.present) { goto invalid; }
+		call->number = lone_lisp_integer_of(number.value);
+
+		for (j = 0; j < 6; ++j) {
+			call->values[j] = values[j + 1];
+			if (!lone_lisp_value_to_linux_system_call_argument(lone, &call->values[j], &call->args[j])) {
+				goto invalid;
+			}
+		}
+	}
+
+	results = lone_lisp_vector_create(lone, n);
+
+	/* the system calls could touch any buffered file descriptor */
+	lone_lisp_output_flush_all(lone);
+
+	for (i = 0; i < n; ++i) {
+		call = &batch[i];
+
+		/* packed symbols decode into a small ring of buffers
+		 * which later conversions reuse: convert again right
+		 * before the call so that its pointers are still valid */
+		for (j = 0; j < 6; ++j) {
+			lone_lisp_value_to_linux_system_call_argument(lone, &call->values[j], &call->args[j]);
+		}
+
+		result = linux_system_call_6(call->number,
+				call->args[0], call->args[1], call->args[2], call->args[3], call->args[4], call->args[5]);
+		lone_lisp_linux_system_call_finished(lone, call->number, call->args, result);
+
+		lone_lisp_vector_push(lone, results, lone_lisp_integer_create(result));
+
+		if (result < 0 && lone_lisp_is_truthy(stop_on_error)) { break; }
+	}
+
+	if (batch) { lone_memory_deallocate(lone->system, batch, n, sizeof(*batch), alignof(*batch)); }
+
+	lone_lisp_machine_push_value(lone, machine, results);
+	return 0;
+
+invalid:
+	/* no call has been made */
+	if (batch) { lone_memory_deallocate(lone->system, batch, n, sizeof(*batch), alignof(*batch)); }
+
+	return
+		lone_lisp_signal_emit(
+			lone,
+			machine,
+			1,
+			lone->symbols.tags.type_error,
+			arguments
+		);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Pre-bound system calls.                                             │
+   │                                                                        │
+   │        (system-call-function number-or-name arity)                     │
+   │                                                                        │
+   │    Returns a primitive which makes the given system call with          │
+   │    exactly arity arguments. The number is resolved once and stored     │
+   │    together with the arity in the closure of the new primitive so      │
+   │    that calling it needs neither a table lookup nor argument padding.  │
+   │                                                                        │
+   │        (set write (system-call-function 'write 3))                     │
+   │        (write 1 "hello" 5)                                             │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define LONE_LISP_LINUX_SYSTEM_CALL_ARITY_BITS 3
+
+/* The symbol naming a system call, looked up when given its number. */
+static struct lone_lisp_value lone_lisp_linux_system_call_name(struct lone_lisp *lone,
+		struct lone_lisp_value linux_system_call_table, struct lone_lisp_value value,
+		struct lone_lisp_value number)
+{
+	struct lone_lisp_table_entry entry;
+	size_t i;
+
+	if (lone_lisp_is_symbol(lone, value)) { return value; }
+	if (lone_lisp_is_text(lone, value)) { return lone_lisp_text_to_symbol(lone, value); }
+
+	LONE_LISP_TABLE_FOR_EACH(lone, entry, linux_system_call_table, i) {
+		if (entry.value.tagged == number.tagged) { return entry.key; }
+	}
+
+	/* unknown to this build */
+	return lone_lisp_intern_c_string(lone, "system-call");
+}
+
+LONE_LISP_PRIMITIVE(linux_system_call_function)
+{
+	struct lone_lisp_value linux_system_call_table, arguments, number_value, arity, closure, name;
+	struct lone_lisp_optional_value number;
+	struct lone_lisp_function_flags flags;
+
+	linux_system_call_table = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_list_is_proper(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &number_value, &arity)) {
+		/* wrong number of arguments: (system-call-function 'write) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	number = lone_lisp_value_to_linux_system_call_number(lone, linux_system_call_table, number_value);
+
+	if (!number.present || !lone_lisp_is_integer(lone, arity)
+	 || lone_lisp_integer_of(number.value) < 0
+	 || lone_lisp_integer_of(arity) < 0 || lone_lisp_integer_of(arity) > 6) {
+		/* unknown system call or impossible arity: (system-call-function 'write 7) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	/* number and arity packed into a single inline integer */
+	closure = lone_lisp_integer_create(
+		(lone_lisp_integer_of(number.value) << LONE_LISP_LINUX_SYSTEM_CALL_ARITY_BITS)
+		| lone_lisp_integer_of(arity)
+	);
+
+	name = lone_lisp_linux_system_call_name(lone, linux_system_call_table, number_value, number.value);
+	flags = (struct lone_lisp_function_flags) { .evaluate_arguments = true, .evaluate_result = false };
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_primitive_create_named(lone, name,
+					lone_lisp_primitive_linux_system_call_bound, closure, flags));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(linux_system_call_bound)
+{
+	struct lone_lisp_value arguments, list;
+	struct lone_lisp_value values[6]; /* must outlive args[] for inline symbol pointers */
+	lone_lisp_integer closure;
+	long number, result, args[6];
+	unsigned char arity, i;
+
+	closure = lone_lisp_integer_of(lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure);
+	number = (long) (closure >> LONE_LISP_LINUX_SYSTEM_CALL_ARITY_BITS);
+	arity = (unsigned char) (closure & ((1 << LONE_LISP_LINUX_SYSTEM_CALL_ARITY_BITS) - 1));
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto convert;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		goto convert;
+
+	default:
+		__builtin_trap();
+	}
+
+convert:
+
+	for (i = 0, list = arguments; i < arity; ++i) {
+		if (lone_lisp_is_nil(list) || !lone_lisp_is_list(lone, list)) {
+			/* too few arguments or improper list */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.arity_error,
+					arguments
+				);
+		}
+
+		values[i] = lone_lisp_list_first(lone, list);
+
+		if (!lone_lisp_value_to_linux_system_call_argument(lone, &values[i], &args[i])) {
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		list = lone_lisp_list_rest(lone, list);
+	}
+
+	if (!lone_lisp_is_nil(list)) {
+		/* too many arguments given */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	/* the system call could touch any buffered file descriptor */
+	lone_lisp_output_flush_all(lone);
+
+	switch (arity) {
+	case 0: result = linux_system_call_0(number); break;
+	case 1: result = linux_system_call_1(number, args[0]); break;
+	case 2: result = linux_system_call_2(number, args[0], args[1]); break;
+	case 3: result = linux_system_call_3(number, args[0], args[1], args[2]); break;
+	case 4: result = linux_system_call_4(number, args[0], args[1], args[2], args[3]); break;
+	case 5: result = linux_system_call_5(number, args[0], args[1], args[2], args[3], args[4]); break;
+	case 6: result = linux_system_call_6(number, args[0], args[1], args[2], args[3], args[4], args[5]); break;
+	default: __builtin_trap();
+	}
+
+	lone_lisp_linux_system_call_finished(lone, number, args, result);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Transfers between file descriptors inside the kernel.               │
+   │                                                                        │
+   │        (sendfile out in count)  (sendfile out in count offset)         │
+   │        (splice in out count)                                           │
+   │        (tee in out count)                                              │
+   │        (copy-file-range in out count)                                  │
+   │        (copy-file-range in out count in-offset out-offset)             │
+   │                                                                        │
+   │    The data never passes through lone's memory. Partial transfers      │
+   │    are continued until count bytes have been transferred, the end      │
+   │    of the input is reached or an error occurs. The number of bytes     │
+   │    transferred is returned, or the negative error number if the        │
+   │    very first transfer failed. Reads start at the offsets if given     │
+   │    without moving the file positions. Tee duplicates the contents      │
+   │    of one pipe into another without consuming them, so it is never     │
+   │    repeated: doing so would only duplicate the same bytes again.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#ifndef SPLICE_F_MOVE
+	#define SPLICE_F_MOVE 1
+#endif
+
+enum lone_lisp_linux_transfer {
+	LONE_LISP_LINUX_TRANSFER_SENDFILE,
+	LONE_LISP_LINUX_TRANSFER_SPLICE,
+	LONE_LISP_LINUX_TRANSFER_TEE,
+	LONE_LISP_LINUX_TRANSFER_COPY_FILE_RANGE,
+};
+
+static long lone_lisp_linux_transfer_loop(enum lone_lisp_linux_transfer transfer,
+		int in, int out, size_t count, __kernel_loff_t *in_offset, __kernel_loff_t *out_offset)
+{
+	long result, total;
+
+	total = 0;
+
+	while ((size_t) total < count) {
+		switch (transfer) {
+		case LONE_LISP_LINUX_TRANSFER_SENDFILE:
+			result = linux_sendfile(out, in, in_offset, count - (size_t) total);
+			break;
+		case LONE_LISP_LINUX_TRANSFER_SPLICE:
+			result = linux_splice(in, 0, out, 0, count - (size_t) total, SPLICE_F_MOVE);
+			break;
+		case LONE_LISP_LINUX_TRANSFER_TEE:
+			result = linux_tee(in, out, count, 0);
+			break;
+		case LONE_LISP_LINUX_TRANSFER_COPY_FILE_RANGE:
+			result = linux_copy_file_range(in, in_offset, out, out_offset, count - (size_t) total, 0);
+			break;
+		default:
+			__builtin_trap();
+		}
+
+		if (result == -EINTR) { continue; }
+		if (result < 0) { return total > 0? total : result; }
+		if (result == 0) { /* end of input */ break; }
+
+		total += result;
+
+		if (transfer == LONE_LISP_LINUX_TRANSFER_TEE) { break; }
+	}
+
+	return total;
+}
+
+static bool lone_lisp_linux_is_file_descriptor(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_integer(lone, value)
+	    && lone_lisp_integer_of(value) >= 0
+	    && lone_lisp_integer_of(value) <= 0x7FFFFFFF;
+}
+
+static bool lone_lisp_linux_is_offset(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_nil(value)
+	    || (lone_lisp_is_integer(lone, value) && lone_lisp_integer_of(value) >= 0);
+}
+
+static long lone_lisp_linux_transfer(struct lone_lisp *lone, struct lone_lisp_machine *machine,
+		long step, enum lone_lisp_linux_transfer transfer)
+{
+	struct lone_lisp_value arguments, in, out, count, in_offset, out_offset;
+	__kernel_loff_t in_position, out_position;
+	bool failed;
+	long result;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_list_is_proper(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	in_offset = out_offset = lone_lisp_nil();
+
+	switch (transfer) {
+	case LONE_LISP_LINUX_TRANSFER_SENDFILE:
+		failed = lone_lisp_list_destructure(lone, arguments, 3, &out, &in, &count)
+		      && lone_lisp_list_destructure(lone, arguments, 4, &out, &in, &count, &in_offset);
+		break;
+	case LONE_LISP_LINUX_TRANSFER_COPY_FILE_RANGE:
+		failed = lone_lisp_list_destructure(lone, arguments, 3, &in, &out, &count)
+		      && lone_lisp_list_destructure(lone, arguments, 5, &in, &out, &count, &in_offset, &out_offset);
+		break;
+	case LONE_LISP_LINUX_TRANSFER_SPLICE:
+	case LONE_LISP_LINUX_TRANSFER_TEE:
+	default:
+		failed = lone_lisp_list_destructure(lone, arguments, 3, &in, &out, &count);
+		break;
+	}
+
+	if (failed) {
+		/* wrong number of arguments: (splice in out) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_linux_is_file_descriptor(lone, in)
+	 || !lone_lisp_linux_is_file_descriptor(lone, out)
+	 || !lone_lisp_is_integer(lone, count) || lone_lisp_integer_of(count) < 0
+	 || !lone_lisp_linux_is_offset(lone, in_offset)
+	 || !lone_lisp_linux_is_offset(lone, out_offset)) {
+		/* wrong types: (sendfile 1 "file" 100) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	in_position  = lone_lisp_is_nil(in_offset)?  0 : lone_lisp_integer_of(in_offset);
+	out_position = lone_lisp_is_nil(out_offset)? 0 : lone_lisp_integer_of(out_offset);
+
+	/* the output could be a buffered file descriptor */
+	lone_lisp_output_flush_all(lone);
+
+	result = lone_lisp_linux_transfer_loop(transfer,
+			(int) lone_lisp_integer_of(in),
+			(int) lone_lisp_integer_of(out),
+			(size_t) lone_lisp_integer_of(count),
+			lone_lisp_is_nil(in_offset)?  0 : &in_position,
+			lone_lisp_is_nil(out_offset)? 0 : &out_position);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(linux_sendfile)
+{
+	return lone_lisp_linux_transfer(lone, machine, step, LONE_LISP_LINUX_TRANSFER_SENDFILE);
+}
+
+LONE_LISP_PRIMITIVE(linux_splice)
+{
+	return lone_lisp_linux_transfer(lone, machine, step, LONE_LISP_LINUX_TRANSFER_SPLICE);
+}
+
+LONE_LISP_PRIMITIVE(linux_tee)
+{
+	return lone_lisp_linux_transfer(lone, machine, step, LONE_LISP_LINUX_TRANSFER_TEE);
+}
+
+LONE_LISP_PRIMITIVE(linux_copy_file_range)
+{
+	return lone_lisp_linux_transfer(lone, machine, step, LONE_LISP_LINUX_TRANSFER_COPY_FILE_RANGE);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    (handle-signal signal handler)                                      │
+   │    (handle-signal signal nil)                                          │
+   │    (signal-descriptor)                                                 │
+   │                                                                        │
+   │    Signals are numbers or names found in the signal table.             │
+   │    Handlers are applied to the signal number by the machine            │
+   │    as soon as it begins evaluating the next list after delivery.       │
+   │    Interrupted system calls are not restarted: they fail with EINTR    │
+   │    so that handlers run instead of waiting for the call to finish.     │
+   │    The default action is restored when the handler is nil. Faults      │
+   │    like SIGSEGV cannot be handled since their handlers would only      │
+   │    run too late.                                                       │
+   │                                                                        │
+   │    The descriptor becomes readable whenever signals are delivered.     │
+   │    Event loop tasks can wait for it so that handlers get to run.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(linux_handle_signal)
+{
+	struct lone_lisp_value linux_signal_table, arguments, signal, handler;
+	struct lone_lisp_optional_value number;
+	long result;
+
+	linux_signal_table = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+
+	switch (step) {
+	case 0:
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+		break;
+	case 1: /* resumed with replacement argument list */
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		break;
+	default:
+		__builtin_trap();
+	}
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &signal, &handler)) {
+		/* wrong number of arguments: (handle-signal 'SIGTERM) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	/* signal names are looked up just like system call names */
+	number = lone_lisp_value_to_linux_system_call_number(lone, linux_signal_table, signal);
+
+	if (!number.present || (!lone_lisp_is_nil(handler) && !lone_lisp_is_applicable(lone, handler))) {
+		/* unknown signal or handler that cannot be applied: (handle-signal 'SIGFOO 1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	/* numbers which are not signals are rejected when handled */
+	result = lone_lisp_machine_interrupt_handle(lone, lone_lisp_integer_of(number.value), handler);
 
 	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
 	return 0;
 }
+
+LONE_LISP_PRIMITIVE(linux_signal_descriptor)
+{
+	struct lone_lisp_value arguments;
+
+	switch (step) {
+	case 0:
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+		break;
+	case 1: /* resumed with replacement argument list */
+		arguments = machine->value;
+		break;
+	default:
+		__builtin_trap();
+	}
+
+	if (!lone_lisp_is_nil(arguments)) {
+		/* no arguments expected: (signal-descriptor 1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	lone_lisp_machine_push_value(lone, machine,
+			lone_lisp_integer_create(lone_lisp_machine_interrupt_descriptor(lone)));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    (prefork count)                                                     │
+   │                                                                        │
+   │    Collects garbage and forks count workers. Each worker returns       │
+   │    its index, starting from zero. The master returns a vector of       │
+   │    the workers' process identifiers, negative error numbers in         │
+   │    place of the workers that could not be forked. Workers inherit      │
+   │    every open descriptor, listening sockets too.                       │
+   │                                                                        │
+   │    Workers share the heap with the master copy-on-write. Every         │
+   │    value that existed at the time of the fork becomes immortal in      │
+   │    all of them and is never moved by the collectors. Values are        │
+   │    not frozen: mutating one copies its page in that process only.      │
+   │    Marks and printer state are kept in separate bitmaps so that        │
+   │    collecting garbage and printing never write to shared values.       │
+   │    Buffered output is flushed before forking.                          │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(linux_prefork)
+{
+	struct lone_lisp_value arguments, count, workers;
+	lone_lisp_integer i, n;
+	long pid;
+
+	switch (step) {
+	case 0:
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+		break;
+	case 1: /* resumed with replacement argument list */
+		arguments = machine->value;
+
+		if (!lone_lisp_list_is_proper(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		break;
+	default:
+		__builtin_trap();
+	}
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &count)) {
+		/* wrong number of arguments: (prefork) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_integer(lone, count) || lone_lisp_integer_of(count) < 0) {
+		/* worker count must be a natural number: (prefork 'four) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	n = lone_lisp_integer_of(count);
+
+	lone_lisp_garbage_collector(lone, machine);
+	lone_lisp_output_flush_all(lone);
+
+	/* rounded up: allocation scans whole bytes of the live bitmap */
+	lone->heap.shared = (lone->heap.count + CHAR_BIT - 1) / CHAR_BIT * CHAR_BIT;
+	lone->heap.first_dead = lone->heap.shared;
+
+	workers = lone_lisp_vector_create(lone, (size_t) n);
+
+	for (i = 0; i < n; ++i) {
+		pid = linux_fork();
+
+		if (pid == 0) {
+			if (lone_lisp_machine_interrupt_forked(lone) < 0) { lone_lisp_exit(lone, -1); }
+			lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(i));
+			return 0;
+		}
+
+		lone_lisp_vector_push(lone, workers, lone_lisp_integer_create(pid));
+	}
+
+	lone_lisp_machine_push_value(lone, machine, workers);
+	return 0;
+}
@@ -6,6 +6,7 @@
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
 #include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
 
 #include <lone/linux.h>
 
@@ -60,7 +61,7 @@ LONE_LISP_PRIMITIVE(list_construct)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 
 destructure:
 
@@ -107,7 +108,7 @@ static long list_unary(struct lone_lisp *lone, struct lone_lisp_machine *machine
 		goto destructure;
 
 	default:
-		linux_exit(-1);
+		lone_lisp_exit(lone, -1);
 	}
 
 destructure:
@@ -217,7 +218,7 @@ LONE_LISP_PRIMITIVE(list_map)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 
 destructure:
 
@@ -335,7 +336,7 @@ LONE_LISP_PRIMITIVE(list_reduce)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 
 destructure:
 
@@ -5,6 +5,8 @@
 #include <lone/lisp/machine.h>
 #include <lone/lisp/machine/stack.h>
 #include <lone/lisp/module.h>
+#include <lone/lisp/hash_cons.h>
+#include <lone/lisp/output.h>
 #include <lone/lisp/printer.h>
 #include <lone/lisp/utilities.h>
 
@@ -86,6 +88,9 @@ void lone_lisp_modules_intrinsic_lone_initialize(struct lone_lisp *lone)
 	lone_lisp_module_export_primitive(lone, module, "print",
 			"print", lone_lisp_primitive_lone_print, module, flags);
 
+	lone_lisp_module_export_primitive(lone, module, "print-limits",
+			"print_limits", lone_lisp_primitive_lone_print_limits, module, flags);
+
 	lone_lisp_module_export_primitive(lone, module, "nil?",
 			"is_nil", lone_lisp_primitive_lone_is_nil, module, flags);
 
@@ -127,6 +132,12 @@ void lone_lisp_modules_intrinsic_lone_initialize(struct lone_lisp *lone)
 
 	lone_lisp_module_export_primitive(lone, module, "frozen?",
 			"is_frozen", lone_lisp_primitive_lone_is_frozen, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "intern",
+			"intern", lone_lisp_primitive_lone_intern, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "intern-literals",
+			"intern_literals", lone_lisp_primitive_lone_intern_literals, module, flags);
 }
 
 
@@ -162,7 +173,7 @@ LONE_LISP_PRIMITIVE(lone_begin)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_when)
@@ -174,7 +185,7 @@ LONE_LISP_PRIMITIVE(lone_when)
 
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
-		if (lone_lisp_is_nil(arguments)) { /* condition not specified: (when) */ linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { /* condition not specified: (when) */ lone_lisp_exit(lone, -1); }
 		condition = lone_lisp_list_first(lone, arguments);
 		body = lone_lisp_list_rest(lone, arguments);
 
@@ -218,7 +229,7 @@ LONE_LISP_PRIMITIVE(lone_when)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_unless)
@@ -230,7 +241,7 @@ LONE_LISP_PRIMITIVE(lone_unless)
 
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
-		if (lone_lisp_is_nil(arguments)) { /* condition not specified: (unless) */ linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { /* condition not specified: (unless) */ lone_lisp_exit(lone, -1); }
 		condition = lone_lisp_list_first(lone, arguments);
 		body = lone_lisp_list_rest(lone, arguments);
 
@@ -273,7 +284,7 @@ LONE_LISP_PRIMITIVE(lone_unless)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_if)
@@ -285,11 +296,11 @@ LONE_LISP_PRIMITIVE(lone_if)
 
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
-		if (lone_lisp_is_nil(arguments)) { /* test not specified: (if) */ linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { /* test not specified: (if) */ lone_lisp_exit(lone, -1); }
 		condition = lone_lisp_list_first(lone, arguments);
 		arguments = lone_lisp_list_rest(lone, arguments);
 
-		if (lone_lisp_is_nil(arguments)) { /* consequent not specified: (if test) */ linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { /* consequent not specified: (if test) */ lone_lisp_exit(lone, -1); }
 		consequent = lone_lisp_list_first(lone, arguments);
 		arguments = lone_lisp_list_rest(lone, arguments);
 
@@ -299,7 +310,7 @@ LONE_LISP_PRIMITIVE(lone_if)
 			alternative = lone_lisp_list_first(lone, arguments);
 			arguments = lone_lisp_list_rest(lone, arguments);
 			if (!lone_lisp_is_nil(arguments)) {
-				/* too many values (if test consequent alternative extra) */ linux_exit(-1);
+				/* too many values (if test consequent alternative extra) */ lone_lisp_exit(lone, -1);
 			}
 		}
 
@@ -322,7 +333,7 @@ LONE_LISP_PRIMITIVE(lone_if)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_let)
@@ -335,11 +346,11 @@ LONE_LISP_PRIMITIVE(lone_let)
 	case 0: /* unpack and check arguments, evaluate values and bind them to variables */
 
 		arguments = lone_lisp_machine_pop_value(lone, machine);
-		if (lone_lisp_is_nil(arguments)) { /* no variables to bind: (let) */ linux_exit(-1); }
+		if (lone_lisp_is_nil(arguments)) { /* no variables to bind: (let) */ lone_lisp_exit(lone, -1); }
 
 		bindings = lone_lisp_list_first(lone, arguments);
 		if (!lone_lisp_is_list(lone, bindings)) {
-			/* expected list but got something else: (let 10) */ linux_exit(-1);
+			/* expected list but got something else: (let 10) */ lone_lisp_exit(lone, -1);
 		}
 
 		body = lone_lisp_list_rest(lone, arguments);
@@ -351,12 +362,12 @@ LONE_LISP_PRIMITIVE(lone_let)
 
 			first = lone_lisp_list_first(lone, bindings);
 			if (!lone_lisp_is_symbol(lone, first)) {
-				/* variable names must be symbols: (let ("x")) */ linux_exit(-1);
+				/* variable names must be symbols: (let ("x")) */ lone_lisp_exit(lone, -1);
 			}
 
 			rest = lone_lisp_list_rest(lone, bindings);
 			if (lone_lisp_is_nil(rest)) {
-				/* incomplete variable/value list: (let (x 10 y)) */ linux_exit(-1);
+				/* incomplete variable/value list: (let (x 10 y)) */ lone_lisp_exit(lone, -1);
 			}
 
 			second = lone_lisp_list_first(lone, rest);
@@ -419,7 +430,7 @@ LONE_LISP_PRIMITIVE(lone_let)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_set)
@@ -432,13 +443,13 @@ LONE_LISP_PRIMITIVE(lone_set)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 		if (lone_lisp_is_nil(arguments)) {
 			/* no variable to set: (set) */
-			linux_exit(-1);
+			lone_lisp_exit(lone, -1);
 		}
 
 		variable = lone_lisp_list_first(lone, arguments);
 		if (!lone_lisp_is_symbol(lone, variable)) {
 			/* variable names must be symbols: (set 10) */
-			linux_exit(-1);
+			lone_lisp_exit(lone, -1);
 		}
 
 		arguments = lone_lisp_list_rest(lone, arguments);
@@ -452,7 +463,7 @@ LONE_LISP_PRIMITIVE(lone_set)
 			arguments = lone_lisp_list_rest(lone, arguments);
 		}
 
-		if (!lone_lisp_is_nil(arguments)) { /* too many arguments */ linux_exit(-1); }
+		if (!lone_lisp_is_nil(arguments)) { /* too many arguments */ lone_lisp_exit(lone, -1); }
 
 		lone_lisp_machine_push_value(lone, machine, variable);
 
@@ -474,7 +485,7 @@ LONE_LISP_PRIMITIVE(lone_set)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_quote)
@@ -484,7 +495,7 @@ LONE_LISP_PRIMITIVE(lone_quote)
 	arguments = lone_lisp_machine_pop_value(lone, machine);
 
 	if (lone_lisp_list_destructure(lone, arguments, 1, &argument)) {
-		/* wrong number of arguments: (quote), (quote x y) */ linux_exit(-1);
+		/* wrong number of arguments: (quote), (quote x y) */ lone_lisp_exit(lone, -1);
 	}
 
 	lone_lisp_machine_push_value(lone, machine, argument);
@@ -503,7 +514,7 @@ LONE_LISP_PRIMITIVE(lone_quasiquote)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
 		if (lone_lisp_list_destructure(lone, arguments, 1, &form)) {
-			/* wrong number of arguments: (quasiquote), (quasiquote x y) */ linux_exit(-1);
+			/* wrong number of arguments: (quasiquote), (quasiquote x y) */ lone_lisp_exit(lone, -1);
 		}
 
 		unquote = lone_lisp_intern_c_string(lone, "unquote");
@@ -535,7 +546,7 @@ LONE_LISP_PRIMITIVE(lone_quasiquote)
 
 					if (!lone_lisp_is_nil(rest)) {
 						/* too many arguments: (quasiquote (unquote x y) (unquote* x y)) */
-						linux_exit(-1);
+						lone_lisp_exit(lone, -1);
 					}
 
 					lone_lisp_machine_push_integer(lone, machine, count);
@@ -624,7 +635,7 @@ LONE_LISP_PRIMITIVE(lone_quasiquote)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 static struct lone_lisp_value lone_lisp_primitive_lambda_with_flags(struct lone_lisp *lone, struct lone_lisp_value environment, struct lone_lisp_value arguments, struct lone_lisp_function_flags flags)
@@ -632,7 +643,7 @@ static struct lone_lisp_value lone_lisp_primitive_lambda_with_flags(struct lone_
 	struct lone_lisp_value bindings, code;
 
 	bindings = lone_lisp_list_first(lone, arguments);
-	if (!lone_lisp_is_list(lone, bindings)) { /* parameters not a list: (lambda 10) */ linux_exit(-1); }
+	if (!lone_lisp_is_list(lone, bindings)) { /* parameters not a list: (lambda 10) */ lone_lisp_exit(lone, -1); }
 
 	code = lone_lisp_list_rest(lone, arguments);
 
@@ -692,7 +703,7 @@ LONE_LISP_PRIMITIVE(lone_control)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
 		if (lone_lisp_list_destructure(lone, arguments, 2, &body, &handler)) {
-			/* wrong number of arguments: (control), (control body handler extra) */ linux_exit(-1);
+			/* wrong number of arguments: (control), (control body handler extra) */ lone_lisp_exit(lone, -1);
 		}
 
 		lone_lisp_machine_push_value(lone, machine, handler);
@@ -713,7 +724,7 @@ LONE_LISP_PRIMITIVE(lone_control)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_transfer)
@@ -728,7 +739,7 @@ LONE_LISP_PRIMITIVE(lone_transfer)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
 		if (lone_lisp_list_destructure(lone, arguments, 1, &value)) {
-			/* wrong number of arguments: (transfer), (transfer value extra) */ linux_exit(-1);
+			/* wrong number of arguments: (transfer), (transfer value extra) */ lone_lisp_exit(lone, -1);
 		}
 
 		/* stack.top - 1 is the topmost frame
@@ -746,7 +757,7 @@ LONE_LISP_PRIMITIVE(lone_transfer)
 			case LONE_LISP_TAG_GENERATOR_DELIMITER:
 				/* continuation capture across generator boundaries
 				   is not supported: disjoint stacks cannot be spliced */
-				linux_exit(-1);
+				lone_lisp_exit(lone, -1);
 			default:
 				continue;
 			}
@@ -754,7 +765,7 @@ LONE_LISP_PRIMITIVE(lone_transfer)
 
 		/* reached stack base without finding a continuation delimiter:
 		   transfer called without a matching control */
-		linux_exit(-1);
+		lone_lisp_exit(lone, -1);
 
 	found:
 
@@ -807,13 +818,35 @@ LONE_LISP_PRIMITIVE(lone_transfer)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
+}
+
+struct lone_lisp_value lone_lisp_generator_prepare(struct lone_lisp *lone,
+		struct lone_lisp_value function, struct lone_lisp_value arguments)
+{
+	struct lone_lisp_value generator;
+	struct lone_lisp_machine_stack *stack;
+
+	generator = lone_lisp_generator_create(lone, function, LONE_LISP_GENERATOR_STACK_INITIAL_SIZE);
+	stack = &lone_lisp_heap_value_of(lone, generator)->as.generator.stacks.own;
+
+	lone_lisp_machine_stack_push(lone, stack, (struct lone_lisp_machine_stack_frame) {
+		.tagged = lone_lisp_retag(generator, LONE_LISP_TAG_GENERATOR_DELIMITER).tagged,
+	});
+	lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_GENERATOR_RETURN);
+	lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_APPLY);
+	lone_lisp_machine_stack_push_value(lone, stack, function);
+	lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_APPLICABLE);
+	lone_lisp_machine_stack_push_value(lone, stack, arguments);
+	lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_LIST);
+	lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_LIST); /* ignored by the machine */
+
+	return generator;
 }
 
 LONE_LISP_PRIMITIVE(lone_generator)
 {
 	struct lone_lisp_value arguments, function, generator;
-	struct lone_lisp_machine_stack *stack;
 
 	switch (step) {
 	case 0: /* create generator and pre-load its stack */
@@ -821,29 +854,16 @@ LONE_LISP_PRIMITIVE(lone_generator)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
 		if (lone_lisp_is_nil(arguments)) {
-			/* need at least the function: (generator) */ linux_exit(-1);
+			/* need at least the function: (generator) */ lone_lisp_exit(lone, -1);
 		}
 
 		function = lone_lisp_list_first(lone, arguments);
 
 		if (!lone_lisp_is_applicable(lone, function)) {
-			/* not passed a function: (generator 10) */ linux_exit(-1);
+			/* not passed a function: (generator 10) */ lone_lisp_exit(lone, -1);
 		}
 
-		generator = lone_lisp_generator_create(lone, function, LONE_LISP_GENERATOR_STACK_INITIAL_SIZE);
-		stack = &lone_lisp_heap_value_of(lone, generator)->as.generator.stacks.own;
-		arguments = lone_lisp_list_rest(lone, arguments);
-
-		lone_lisp_machine_stack_push(lone, stack, (struct lone_lisp_machine_stack_frame) {
-			.tagged = lone_lisp_retag(generator, LONE_LISP_TAG_GENERATOR_DELIMITER).tagged,
-		});
-		lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_GENERATOR_RETURN);
-		lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_APPLY);
-		lone_lisp_machine_stack_push_value(lone, stack, function);
-		lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_APPLICABLE);
-		lone_lisp_machine_stack_push_value(lone, stack, arguments);
-		lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_LIST);
-		lone_lisp_machine_stack_push_step(lone,  stack, LONE_LISP_MACHINE_STEP_LOAD_LIST); /* ignored by the machine */
+		generator = lone_lisp_generator_prepare(lone, function, lone_lisp_list_rest(lone, arguments));
 
 		lone_lisp_machine_push_value(lone, machine, generator);
 		return 0;
@@ -852,7 +872,7 @@ LONE_LISP_PRIMITIVE(lone_generator)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_yield)
@@ -869,13 +889,13 @@ LONE_LISP_PRIMITIVE(lone_yield)
 		if (lone_lisp_is_nil(arguments)) {
 			value = lone_lisp_nil();
 		} else if (lone_lisp_list_destructure(lone, arguments, 1, &value)) {
-			/* wrong number of arguments: (yield a b c) */ linux_exit(-1);
+			/* wrong number of arguments: (yield a b c) */ lone_lisp_exit(lone, -1);
 		}
 
 		/* generator delimiter is in a fixed position on the generator's stack */
 		delimiter = &machine->stack.base[0];
 		if ((delimiter->tagged & LONE_LISP_TAG_MASK) != LONE_LISP_TAG_GENERATOR_DELIMITER) {
-			/* not inside a generator */ linux_exit(-1);
+			/* not inside a generator */ lone_lisp_exit(lone, -1);
 		}
 		generator = &lone_lisp_heap_value_of(
 			lone,
@@ -899,7 +919,7 @@ LONE_LISP_PRIMITIVE(lone_yield)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_intercept)
@@ -912,14 +932,14 @@ LONE_LISP_PRIMITIVE(lone_intercept)
 		arguments = lone_lisp_machine_pop_value(lone, machine);
 
 		if (lone_lisp_is_nil(arguments)) {
-			/* no arguments: (intercept) */ linux_exit(-1);
+			/* no arguments: (intercept) */ lone_lisp_exit(lone, -1);
 		}
 
 		clauses = lone_lisp_list_first(lone, arguments);
 		body = lone_lisp_list_rest(lone, arguments);
 
 		if (lone_lisp_is_nil(body)) {
-			/* no body: (intercept clauses) */ linux_exit(-1);
+			/* no body: (intercept clauses) */ lone_lisp_exit(lone, -1);
 		}
 
 		/* set up the stack so that signal can find
@@ -968,7 +988,7 @@ LONE_LISP_PRIMITIVE(lone_intercept)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 /* Scan the machine stack downward from the given position looking for
@@ -1163,7 +1183,7 @@ static void lone_lisp_signal_dispatch(struct lone_lisp *lone,
 	long delimiter_index;
 
 	if (lone_lisp_is_nil(tag)) {
-		linux_exit(-1);
+		lone_lisp_exit(lone, -1);
 	}
 
 	delimiter = lone_lisp_signal_find_interceptor_delimiter(
@@ -1174,7 +1194,7 @@ static void lone_lisp_signal_dispatch(struct lone_lisp *lone,
 
 	while (!delimiter) {
 		if (!generator) {
-			linux_exit(-1);
+			lone_lisp_exit(lone, -1);
 		}
 
 		lone_lisp_signal_terminate_generator(lone, machine, generator);
@@ -1262,7 +1282,7 @@ LONE_LISP_PRIMITIVE(lone_signal)
 				if (!generator) {
 					/* no interceptor or generator delimiter found
 					 signal cannot be handled */
-					linux_exit(-1);
+					lone_lisp_exit(lone, -1);
 				}
 
 				/* save tag and value before switching stacks */
@@ -1356,7 +1376,7 @@ LONE_LISP_PRIMITIVE(lone_signal)
 		}
 
 		if (!lone_lisp_is_symbol(lone, matcher)) {
-			/* matcher must be nil, applicable, or symbol */ linux_exit(-1);
+			/* matcher must be nil, applicable, or symbol */ lone_lisp_exit(lone, -1);
 		}
 
 		/* symbol matcher, exact comparison */
@@ -1432,7 +1452,7 @@ LONE_LISP_PRIMITIVE(lone_signal)
 		} else if (lone_lisp_is_primitive(lone, handler)) {
 			arity = 1;
 		} else {
-			linux_exit(-1);
+			lone_lisp_exit(lone, -1);
 		}
 		intercept_environment = lone_lisp_machine_pop_value(lone, machine);
 		delimiter_offset = lone_lisp_machine_pop_integer(lone, machine);
@@ -1514,7 +1534,7 @@ LONE_LISP_PRIMITIVE(lone_signal)
 		break;
 	}
 
-	linux_exit(-1);
+	lone_lisp_exit(lone, -1);
 }
 
 static bool lone_lisp_is_nil_predicate(struct lone_lisp *lone, struct lone_lisp_value value)
@@ -1639,7 +1659,7 @@ LONE_LISP_PRIMITIVE(lone_freeze)
 	arguments = lone_lisp_machine_pop_value(lone, machine);
 
 	if (lone_lisp_list_destructure(lone, arguments, 1, &value)) {
-		/* wrong number of arguments */ linux_exit(-1);
+		/* wrong number of arguments */ lone_lisp_exit(lone, -1);
 	}
 
 	if (lone_lisp_is_inline_bytes(value)) {
@@ -1649,13 +1669,17 @@ LONE_LISP_PRIMITIVE(lone_freeze)
 	}
 
 	if (lone_lisp_type_of(value) == LONE_LISP_TAG_BYTES) {
+		if (!lone_lisp_is_frozen(lone, value)) {
+			/* a slice of mutable bytes could still change through them */
+			lone_lisp_slice_detach(lone, value);
+		}
 		heap_value = lone_lisp_heap_value_of(lone, value);
 		heap_value->frozen = true;
 		lone_lisp_machine_push_value(lone, machine, value);
 		return 0;
 	}
 
-	/* not a freezable type */ linux_exit(-1);
+	/* not a freezable type */ lone_lisp_exit(lone, -1);
 }
 
 LONE_LISP_PRIMITIVE(lone_is_frozen)
@@ -1666,6 +1690,134 @@ LONE_LISP_PRIMITIVE(lone_is_frozen)
 	return 0;
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    (intern value)                                                      │
+   │                                                                        │
+   │    Returns the canonical value equal to the given value.               │
+   │    Texts, frozen bytes and lists of them that are equal                │
+   │    share the same canonical value and are identical.                   │
+   │    Other values are returned unchanged.                                │
+   │                                                                        │
+   │        (identical? (intern (join "a" "b")) (intern "ab"))  ; true      │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+LONE_LISP_PRIMITIVE(lone_intern)
+{
+	struct lone_lisp_value arguments, value;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &value)) {
+		/* wrong number of arguments: (intern), (intern "a" "b") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_hash_cons(lone, value));
+	return 0;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    (intern-literals enable)                                            │
+   │                                                                        │
+   │    Enables or disables interning of literals by the reader.            │
+   │    While enabled, text and bytes literals and quoted data in           │
+   │    forms read afterwards are interned as if by intern.                 │
+   │    Returns whether it was previously enabled.                          │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+LONE_LISP_PRIMITIVE(lone_intern_literals)
+{
+	struct lone_lisp_value arguments, enable;
+	bool previous;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &enable)) {
+		/* wrong number of arguments: (intern-literals), (intern-literals true false) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	previous = lone->hash_cons.literals;
+	lone->hash_cons.literals = lone_lisp_is_truthy(enable);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_boolean_for(previous));
+	return 0;
+}
+
 LONE_LISP_PRIMITIVE(lone_is_finished)
 {
 	struct lone_lisp_value arguments, value;
@@ -1691,7 +1843,7 @@ LONE_LISP_PRIMITIVE(lone_is_finished)
 		goto check_type;
 
 	default:
-		linux_exit(-1);
+		lone_lisp_exit(lone, -1);
 	}
 
 destructure:
@@ -1719,15 +1871,15 @@ LONE_LISP_PRIMITIVE(lone_apply)
 	arguments = lone_lisp_machine_pop_value(lone, machine);
 
 	if (lone_lisp_list_destructure(lone, arguments, 2, &function, &list)) {
-		/* wrong number of arguments */ linux_exit(-1);
+		/* wrong number of arguments */ lone_lisp_exit(lone, -1);
 	}
 
 	if (!lone_lisp_is_applicable(lone, function)) {
-		/* not given an applicable value */ linux_exit(-1);
+		/* not given an applicable value */ lone_lisp_exit(lone, -1);
 	}
 
 	if (!lone_lisp_is_list(lone, list) && !lone_lisp_is_nil(list)) {
-		/* second argument must be a list */ linux_exit(-1);
+		/* second argument must be a list */ lone_lisp_exit(lone, -1);
 	}
 
 	machine->applicable = function;
@@ -1744,10 +1896,82 @@ LONE_LISP_PRIMITIVE(lone_print)
 
 	while (!lone_lisp_is_nil(arguments)) {
 		lone_lisp_print(lone, lone_lisp_list_first(lone, arguments), 1);
-		linux_write_bytes(1, LONE_BYTES_VALUE_FROM_LITERAL("\n"));
+		lone_lisp_output_write(lone, 1, LONE_BYTES_VALUE_FROM_LITERAL("\n"));
 		arguments = lone_lisp_list_rest(lone, arguments);
 	}
 
 	lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
 	return 0;
 }
+
+/* (print-limits depth length)
+ * Limits the depth of nesting and the number of elements
+ * of containers printed from then on. Zero means unlimited. */
+LONE_LISP_PRIMITIVE(lone_print_limits)
+{
+	struct lone_lisp_value arguments, depth, length;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		break;
+	}
+
+	lone_lisp_exit(lone, -1);
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &depth, &length)) {
+		/* wrong number of arguments: (print-limits 10) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_integer(lone, depth) || lone_lisp_integer_of(depth) < 0
+	 || !lone_lisp_is_integer(lone, length) || lone_lisp_integer_of(length) < 0) {
+		/* limits must be non-negative integers: (print-limits -1 'x) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	lone->print_limits.depth  = (size_t) lone_lisp_integer_of(depth);
+	lone->print_limits.length = (size_t) lone_lisp_integer_of(length);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+	return 0;
+}
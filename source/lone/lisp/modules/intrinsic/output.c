@@ -0,0 +1,278 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/modules/intrinsic/output.h>
+#include <lone/lisp/modules/intrinsic/lone.h>
+
+#include <lone/lisp/machine.h>
+#include <lone/lisp/machine/stack.h>
+#include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
+#include <lone/lisp/utilities.h>
+
+#include <lone/linux.h>
+
+void lone_lisp_modules_intrinsic_output_initialize(struct lone_lisp *lone)
+{
+	struct lone_lisp_value name, module;
+	struct lone_lisp_function_flags flags;
+
+	name = lone_lisp_intern_c_string(lone, "output");
+	module = lone_lisp_module_for_name(lone, name);
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	lone_lisp_module_export_primitive(lone, module, "write",
+			"output_write", lone_lisp_primitive_output_write, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "flush",
+			"output_flush", lone_lisp_primitive_output_flush, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "buffering",
+			"output_buffering", lone_lisp_primitive_output_buffering, module, flags);
+}
+
+static bool lone_lisp_output_is_file_descriptor(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_integer(lone, value)
+	    && lone_lisp_integer_of(value) >= 0
+	    && lone_lisp_integer_of(value) <= 0x7FFFFFFF;
+}
+
+LONE_LISP_PRIMITIVE(output_write)
+{
+	struct lone_lisp_value arguments, file_descriptor, values, value;
+	int fd;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_is_nil(arguments)) {
+		/* file descriptor not given: (write) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	file_descriptor = lone_lisp_list_first(lone, arguments);
+	values = lone_lisp_list_rest(lone, arguments);
+
+	if (!lone_lisp_output_is_file_descriptor(lone, file_descriptor)) {
+		/* not a file descriptor: (write "1" "text") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	for (value = values; !lone_lisp_is_nil(value); value = lone_lisp_list_rest(lone, value)) {
+		if (!lone_lisp_is_text(lone, lone_lisp_list_first(lone, value))
+		 && !lone_lisp_is_bytes(lone, lone_lisp_list_first(lone, value))) {
+			/* neither text nor bytes: (write 1 123) */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+	}
+
+	fd = (int) lone_lisp_integer_of(file_descriptor);
+
+	for (; !lone_lisp_is_nil(values); values = lone_lisp_list_rest(lone, values)) {
+		value = lone_lisp_list_first(lone, values);
+		lone_lisp_output_write(lone, fd, lone_lisp_bytes_of(lone, &value));
+	}
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(output_flush)
+{
+	struct lone_lisp_value arguments, file_descriptor;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_is_nil(arguments)) {
+		lone_lisp_output_flush_all(lone);
+		goto done;
+	}
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &file_descriptor)) {
+		/* too many arguments: (flush 1 2) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_output_is_file_descriptor(lone, file_descriptor)) {
+		/* not a file descriptor: (flush "1") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	lone_lisp_output_flush(lone, (int) lone_lisp_integer_of(file_descriptor));
+
+done:
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(output_buffering)
+{
+	struct lone_lisp_value arguments, file_descriptor, mode;
+	enum lone_lisp_output_buffering buffering;
+	bool buffered;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 2, &file_descriptor, &mode)) {
+		/* wrong number of arguments: (buffering), (buffering 1), (buffering 1 'line 2) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_output_is_file_descriptor(lone, file_descriptor)) { goto type_error; }
+
+	if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "none"))) {
+		buffering = LONE_LISP_OUTPUT_UNBUFFERED;
+	} else if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "line"))) {
+		buffering = LONE_LISP_OUTPUT_LINE_BUFFERED;
+	} else if (lone_lisp_is_identical(lone, mode, lone_lisp_intern_c_string(lone, "full"))) {
+		buffering = LONE_LISP_OUTPUT_FULLY_BUFFERED;
+	} else {
+		goto type_error;
+	}
+
+	/* false when every stream is in use and output stays unbuffered */
+	buffered = lone_lisp_output_set_buffering(lone, (int) lone_lisp_integer_of(file_descriptor), buffering);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_boolean_for(buffered));
+	return 0;
+
+type_error:
+	/* invalid descriptor or mode: (buffering "1" 'line), (buffering 1 'sometimes) */
+	return
+		lone_lisp_signal_emit(
+			lone,
+			machine,
+			1,
+			lone->symbols.tags.type_error,
+			arguments
+		);
+}
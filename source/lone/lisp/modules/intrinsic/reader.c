@@ -0,0 +1,211 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/modules/intrinsic/reader.h>
+#include <lone/lisp/modules/intrinsic/lone.h>
+
+#include <lone/lisp/machine.h>
+#include <lone/lisp/machine/stack.h>
+#include <lone/lisp/module.h>
+#include <lone/lisp/reader.h>
+#include <lone/lisp/utilities.h>
+
+#include <lone/linux.h>
+
+void lone_lisp_modules_intrinsic_reader_initialize(struct lone_lisp *lone)
+{
+	struct lone_lisp_value name, module, yield;
+	struct lone_lisp_function_flags flags;
+
+	name = lone_lisp_intern_c_string(lone, "reader");
+	module = lone_lisp_module_for_name(lone, name);
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	/* forms are yielded from C through the yield primitive */
+	yield = lone_lisp_primitive_create(lone, "yield", lone_lisp_primitive_lone_yield, lone_lisp_nil(), flags);
+
+	lone_lisp_module_export_primitive(lone, module, "forms",
+			"reader_forms", lone_lisp_primitive_reader_forms, yield, flags);
+}
+
+static bool lone_lisp_reader_is_file_descriptor(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	return lone_lisp_is_integer(lone, value)
+	    && lone_lisp_integer_of(value) >= 0
+	    && lone_lisp_integer_of(value) <= 0x7FFFFFFF;
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Each generator is driven by a primitive whose closure holds:        │
+   │                                                                        │
+   │        (yield state buffer)                                            │
+   │                                                                        │
+   │    The state is a bytes value containing the reader structure.         │
+   │    The buffer is the bytes or text being read or, for file             │
+   │    descriptors, a bytes value which owns the memory of the             │
+   │    reader's buffer. Its count is kept one less than the size of        │
+   │    the buffer to account for the trailing null byte which the          │
+   │    garbage collector deallocates along with all bytes values.          │
+   │    The reader's buffer may be reallocated as it grows so the           │
+   │    buffer value is updated after every read. Generators which          │
+   │    are abandoned before the end of the input are thus collected        │
+   │    along with their buffers. The file descriptor is not closed.        │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+LONE_LISP_PRIMITIVE(reader_forms)
+{
+	struct lone_lisp_value arguments, source, state, buffer, closure, function;
+	struct lone_lisp_function_flags flags;
+	struct lone_lisp_reader *reader;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &source)) {
+		/* wrong number of arguments: (forms) (forms 0 1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_reader_is_file_descriptor(lone, source)
+	 && !lone_lisp_is_text(lone, source)
+	 && !lone_lisp_is_bytes(lone, source)) {
+		/* neither file descriptor, text nor bytes: (forms 'symbol) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	state = lone_lisp_bytes_create(lone, sizeof(*reader));
+	reader = (struct lone_lisp_reader *) lone_lisp_heap_value_of(lone, state)->as.bytes.data.pointer;
+
+	if (lone_lisp_is_integer(lone, source)) {
+		lone_lisp_reader_for_file_descriptor(lone, reader, LONE_LISP_BUFFER_SIZE,
+				(int) lone_lisp_integer_of(source));
+		buffer = lone_lisp_bytes_transfer(lone, reader->buffer.bytes.pointer,
+				reader->buffer.bytes.count - 1, true);
+	} else {
+		lone_lisp_reader_for_bytes(lone, reader, lone_lisp_bytes_of(lone, &source));
+		buffer = source;
+	}
+
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	closure = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+	closure = lone_lisp_list_build(lone, 3, &closure, &state, &buffer);
+	function = lone_lisp_primitive_create(lone, "forms", lone_lisp_primitive_reader_next, closure, flags);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_generator_prepare(lone, function, lone_lisp_nil()));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(reader_next)
+{
+	struct lone_lisp_value closure, yield, state, buffer, form, source;
+	struct lone_lisp_reader *reader;
+
+	switch (step) {
+	case 0: /* started by the generator with no arguments */
+
+		lone_lisp_machine_pop_value(lone, machine);
+
+		break;
+
+	case 1: /* resumed by the generator's caller, value is ignored */
+
+		break;
+
+	case 2: /* read-error handler returned, its value is the final one */
+
+		lone_lisp_machine_push_value(lone, machine, machine->value);
+		return 0;
+
+	default:
+		__builtin_trap();
+	}
+
+	closure = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+	lone_lisp_list_destructure(lone, closure, 3, &yield, &state, &buffer);
+	reader = (struct lone_lisp_reader *) lone_lisp_heap_value_of(lone, state)->as.bytes.data.pointer;
+
+	if (reader->file_descriptor == -1) {
+		/* the input may have moved or be stored inline in the value */
+		reader->buffer.bytes = lone_lisp_bytes_of(lone, &buffer);
+	}
+
+	form = lone_lisp_read(lone, reader);
+
+	if (reader->file_descriptor != -1) {
+		lone_lisp_heap_value_of(lone, buffer)->as.bytes.data = (struct lone_bytes) {
+			.count   = reader->buffer.bytes.count - 1,
+			.pointer = reader->buffer.bytes.pointer,
+		};
+	}
+
+	if (reader->status.error) {
+		source = reader->file_descriptor == -1?
+			buffer : lone_lisp_integer_create(reader->file_descriptor);
+
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				2,
+				lone->symbols.tags.read_error,
+				source
+			);
+	}
+
+	if (reader->status.end_of_input) {
+		lone_lisp_machine_push_value(lone, machine, lone_lisp_nil());
+		return 0;
+	}
+
+	machine->applicable = yield;
+	machine->list = lone_lisp_list_build(lone, 1, &form);
+	machine->step = LONE_LISP_MACHINE_STEP_APPLY;
+
+	return 1;
+}
@@ -33,6 +33,9 @@ void lone_lisp_modules_intrinsic_table_initialize(struct lone_lisp *lone)
 
 	lone_lisp_module_export_primitive(lone, module, "count",
 			"table_count", lone_lisp_primitive_table_count, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "weak",
+			"table_weak", lone_lisp_primitive_table_weak, module, flags);
 }
 
 LONE_LISP_PRIMITIVE(table_get)
@@ -500,3 +503,86 @@ check_table:
 	lone_lisp_machine_push_value(lone, machine, count);
 	return 0;
 }
+
+LONE_LISP_PRIMITIVE(table_weak)
+{
+	struct lone_lisp_value arguments, kind, table;
+	bool weak_keys, weak_values;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	case 2: /* resumed with replacement kind from type-error */
+
+		kind = machine->value;
+
+		goto check_kind;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	if (lone_lisp_list_destructure(lone, arguments, 1, &kind)) {
+		/* wrong number of arguments: (weak), (weak 'keys "extra") */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+check_kind:
+
+	if (lone_lisp_is_identical(lone, kind, lone_lisp_intern_c_string(lone, "keys"))) {
+		weak_keys   = true;
+		weak_values = false;
+	} else if (lone_lisp_is_identical(lone, kind, lone_lisp_intern_c_string(lone, "values"))) {
+		weak_keys   = false;
+		weak_values = true;
+	} else if (lone_lisp_is_identical(lone, kind, lone_lisp_intern_c_string(lone, "both"))) {
+		weak_keys   = true;
+		weak_values = true;
+	} else {
+		/* unknown weakness: (weak 'neither), (weak 0) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				2,
+				lone->symbols.tags.type_error,
+				kind
+			);
+	}
+
+	table = lone_lisp_table_create_weak(lone, 8, lone_lisp_nil(), weak_keys, weak_values);
+
+	lone_lisp_machine_push_value(lone, machine, table);
+	return 0;
+}
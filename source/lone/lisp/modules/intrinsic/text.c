@@ -9,6 +9,7 @@
 #include <lone/lisp/utilities.h>
 #include <lone/lisp/heap.h>
 
+#include <lone/memory/functions.h>
 #include <lone/unicode.h>
 
 #include <lone/linux.h>
@@ -46,6 +47,9 @@ void lone_lisp_modules_intrinsic_text_initialize(struct lone_lisp *lone)
 
 	lone_lisp_module_export_primitive(lone, module, "slice",
 			"text_slice", lone_lisp_primitive_text_slice, module, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "format-integer",
+			"text_format_integer", lone_lisp_primitive_text_format_integer, module, flags);
 }
 
 LONE_LISP_PRIMITIVE(text_to_symbol)
@@ -835,6 +839,132 @@ build_slice:
 	}
 
 	lone_lisp_machine_push_value(lone, machine,
-			lone_lisp_text_copy(lone, slice_start, slice_length));
+			lone_lisp_text_slice(lone, text, slice_start, slice_length, end_index - start_index));
+	return 0;
+}
+
+/* (format-integer bytes offset integer)
+ * (format-integer bytes offset integer 16)
+ *
+ * Writes the decimal or hexadecimal digits of the integer
+ * into the bytes at the offset without allocating.
+ * Returns the number of bytes written. */
+LONE_LISP_PRIMITIVE(text_format_integer)
+{
+	struct lone_lisp_value arguments, bytes, offset, integer, base;
+	unsigned char digits[LONE_LISP_INTEGER_FORMAT_SIZE];
+	struct lone_bytes buffer;
+	size_t count;
+
+	switch (step) {
+	case 0:
+
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+
+		goto destructure;
+
+	case 1: /* resumed with replacement argument list */
+
+		arguments = machine->value;
+
+		if (!lone_lisp_is_list(lone, arguments)) {
+			/* cannot destructure */
+			return
+				lone_lisp_signal_emit(
+					lone,
+					machine,
+					1,
+					lone->symbols.tags.type_error,
+					arguments
+				);
+		}
+
+		goto destructure;
+
+	default:
+		__builtin_trap();
+	}
+
+destructure:
+
+	base = lone_lisp_integer_create(10);
+
+	if (lone_lisp_list_destructure(lone, arguments, 3, &bytes, &offset, &integer)
+	 && lone_lisp_list_destructure(lone, arguments, 4, &bytes, &offset, &integer, &base)) {
+		/* wrong number of arguments: (format-integer b 0) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	if (!lone_lisp_is_bytes(lone, bytes)
+	 || !lone_lisp_is_integer(lone, offset)
+	 || !lone_lisp_is_integer(lone, integer)
+	 || !lone_lisp_is_integer(lone, base)) {
+		/* wrong types: (format-integer "text" 0 1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.type_error,
+				arguments
+			);
+	}
+
+	switch (lone_lisp_integer_of(base)) {
+	case 10:
+		count = lone_lisp_integer_format_decimal(lone_lisp_integer_of(integer), digits);
+		break;
+	case 16:
+		count = lone_lisp_integer_format_hexadecimal(lone_lisp_integer_of(integer), digits);
+		break;
+	default:
+		/* unsupported base: (format-integer b 0 1 2) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.range_error,
+				arguments
+			);
+	}
+
+	if (lone_lisp_is_frozen(lone, bytes)) {
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.frozen_error,
+				arguments
+			);
+	}
+
+	buffer = lone_lisp_heap_value_of(lone, bytes)->as.bytes.data;
+
+	if (lone_lisp_integer_of(offset) < 0
+	 || (size_t) lone_lisp_integer_of(offset) > buffer.count
+	 || buffer.count - (size_t) lone_lisp_integer_of(offset) < count) {
+		/* digits do not fit: (format-integer (bytes 2) 0 100) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.index_error,
+				arguments
+			);
+	}
+
+	lone_memory_move(digits, buffer.pointer + lone_lisp_integer_of(offset), count);
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create((lone_lisp_integer) count));
 	return 0;
 }
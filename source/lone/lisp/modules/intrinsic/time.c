@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/modules/intrinsic/time.h>
+#include <lone/lisp/modules/intrinsic/lone.h>
+
+#include <lone/lisp/machine.h>
+#include <lone/lisp/machine/stack.h>
+#include <lone/lisp/module.h>
+#include <lone/lisp/output.h>
+
+#include <lone/vdso.h>
+#include <lone/linux.h>
+
+void lone_lisp_modules_intrinsic_time_initialize(struct lone_lisp *lone,
+		struct lone_auxiliary_vector *auxv)
+{
+	struct lone_lisp_value name, module, vdso;
+	struct lone_lisp_function_flags flags;
+
+	name = lone_lisp_intern_c_string(lone, "time");
+	module = lone_lisp_module_for_name(lone, name);
+	flags.evaluate_arguments = true;
+	flags.evaluate_result = false;
+
+	/* the resolved function pointers are the closure of every primitive */
+	vdso = lone_lisp_bytes_create(lone, sizeof(struct lone_vdso));
+	lone_vdso_initialize((struct lone_vdso *) lone_lisp_heap_value_of(lone, vdso)->as.bytes.data.pointer, auxv);
+
+	lone_lisp_module_export_primitive(lone, module, "monotonic",
+			"time_monotonic", lone_lisp_primitive_time_monotonic, vdso, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "realtime",
+			"time_realtime", lone_lisp_primitive_time_realtime, vdso, flags);
+
+	lone_lisp_module_export_primitive(lone, module, "cpu",
+			"time_cpu", lone_lisp_primitive_time_cpu, vdso, flags);
+}
+
+static struct lone_vdso *lone_lisp_time_vdso(struct lone_lisp *lone, struct lone_lisp_machine *machine)
+{
+	struct lone_lisp_value closure;
+
+	closure = lone_lisp_heap_value_of(lone, machine->applicable)->as.primitive.closure;
+
+	return (struct lone_vdso *) lone_lisp_heap_value_of(lone, closure)->as.bytes.data.pointer;
+}
+
+static long lone_lisp_time_check_arguments(struct lone_lisp *lone, struct lone_lisp_machine *machine, long step)
+{
+	struct lone_lisp_value arguments;
+
+	switch (step) {
+	case 0:
+		arguments = lone_lisp_machine_pop_value(lone, machine);
+		break;
+	case 1: /* resumed with replacement argument list */
+		arguments = machine->value;
+		break;
+	default:
+		lone_lisp_exit(lone, -1);
+	}
+
+	if (!lone_lisp_is_nil(arguments)) {
+		/* no arguments expected: (monotonic 1) */
+		return
+			lone_lisp_signal_emit(
+				lone,
+				machine,
+				1,
+				lone->symbols.tags.arity_error,
+				arguments
+			);
+	}
+
+	return -1;
+}
+
+static long lone_lisp_time_clock_gettime(struct lone_vdso *vdso, int clock, struct __kernel_timespec *time)
+{
+	if (vdso->clock_gettime) {
+		return vdso->clock_gettime(clock, time);
+	} else {
+		return linux_clock_gettime(clock, time);
+	}
+}
+
+LONE_LISP_PRIMITIVE(time_monotonic)
+{
+	struct __kernel_timespec time;
+	long result;
+
+	result = lone_lisp_time_check_arguments(lone, machine, step);
+	if (result >= 0) { return result; }
+
+	result = lone_lisp_time_clock_gettime(lone_lisp_time_vdso(lone, machine), CLOCK_MONOTONIC, &time);
+
+	if (result >= 0) {
+		result = time.tv_sec * 1000000L + time.tv_nsec / 1000;
+	}
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(time_realtime)
+{
+	struct __kernel_old_timeval microseconds;
+	struct __kernel_timespec time;
+	struct lone_vdso *vdso;
+	long result;
+
+	result = lone_lisp_time_check_arguments(lone, machine, step);
+	if (result >= 0) { return result; }
+
+	vdso = lone_lisp_time_vdso(lone, machine);
+
+	if (vdso->gettimeofday) {
+		result = vdso->gettimeofday(&microseconds, 0);
+		if (result >= 0) {
+			result = microseconds.tv_sec * 1000000L + microseconds.tv_usec;
+		}
+	} else {
+		result = lone_lisp_time_clock_gettime(vdso, CLOCK_REALTIME, &time);
+		if (result >= 0) {
+			result = time.tv_sec * 1000000L + time.tv_nsec / 1000;
+		}
+	}
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
+
+LONE_LISP_PRIMITIVE(time_cpu)
+{
+	struct lone_vdso *vdso;
+	unsigned int cpu;
+	long result;
+
+	result = lone_lisp_time_check_arguments(lone, machine, step);
+	if (result >= 0) { return result; }
+
+	vdso = lone_lisp_time_vdso(lone, machine);
+
+	if (vdso->getcpu) {
+		result = vdso->getcpu(&cpu, 0, 0);
+	} else {
+		result = linux_getcpu(&cpu, 0);
+	}
+
+	if (result >= 0) { result = cpu; }
+
+	lone_lisp_machine_push_value(lone, machine, lone_lisp_integer_create(result));
+	return 0;
+}
@@ -0,0 +1,212 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/names.h>
+
+#include <lone/memory/functions.h>
+
+#include <lone/bits.h>
+#include <lone/linux.h>
+
+static size_t lone_lisp_names_round_to_pages(struct lone_lisp *lone, size_t size)
+{
+	size_t page_size = lone->system->allocator.page_size;
+	return (size + page_size - 1) & ~(page_size - 1);
+}
+
+static size_t lone_lisp_names_record_size(size_t count)
+{
+	size_t size = count + 1; /* trailing NUL */
+	size = (size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+	return sizeof(struct lone_lisp_name_header) + size;
+}
+
+static struct lone_lisp_name_header *lone_lisp_names_header_at(struct lone_lisp *lone, size_t offset)
+{
+	return (struct lone_lisp_name_header *) (lone->symbols.names.base + offset);
+}
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    A name is live if the heap value at its recorded index is a live    │
+   │    symbol whose name points at it. Dead symbols fail this check and    │
+   │    so do values allocated into their heap slots afterwards.            │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static struct lone_lisp_heap_value *lone_lisp_names_owner(struct lone_lisp *lone,
+		struct lone_lisp_name_header *header, unsigned char *name)
+{
+	struct lone_lisp_heap_value *value;
+
+	if (header->index >= lone->heap.count) { return 0; }
+	if (!lone_bits_get(lone->heap.bits.live, header->index)) { return 0; }
+
+	value = &lone->heap.values[header->index];
+
+	if (value->type != LONE_LISP_TAG_SYMBOL) { return 0; }
+	if (value->as.symbol.name.pointer != name) { return 0; }
+
+	return value;
+}
+
+void lone_lisp_names_initialize(struct lone_lisp *lone)
+{
+	size_t capacity;
+	intptr_t mapped;
+
+	capacity = lone_lisp_names_round_to_pages(lone, LONE_LISP_NAMES_INITIAL_CAPACITY);
+	mapped   = linux_mmap(0, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (mapped < 0) { linux_exit(-1); }
+
+	lone->symbols.names.base     = (unsigned char *) mapped;
+	lone->symbols.names.used     = 0;
+	lone->symbols.names.capacity = capacity;
+}
+
+bool lone_lisp_names_contain(struct lone_lisp *lone, void *pointer)
+{
+	unsigned char *p = pointer;
+
+	return p >= lone->symbols.names.base
+	    && p <  lone->symbols.names.base + lone->symbols.names.used;
+}
+
+static void lone_lisp_names_rebase(struct lone_lisp *lone, unsigned char *old_base)
+{
+	struct lone_lisp_name_header *header;
+	struct lone_lisp_heap_value *owner;
+	size_t offset, name_offset;
+
+	for (offset = 0; offset < lone->symbols.names.used; offset += lone_lisp_names_record_size(header->count)) {
+		header      = lone_lisp_names_header_at(lone, offset);
+		name_offset = offset + sizeof(*header);
+		owner       = lone_lisp_names_owner(lone, header, old_base + name_offset);
+
+		if (owner) {
+			owner->as.symbol.name.pointer = lone->symbols.names.base + name_offset;
+		}
+	}
+}
+
+static void lone_lisp_names_grow(struct lone_lisp *lone, size_t needed)
+{
+	size_t capacity, required;
+	unsigned char *old_base;
+	intptr_t remapped;
+
+	if (__builtin_add_overflow(lone->symbols.names.used, needed, &required)) { goto overflow; }
+
+	capacity = lone->symbols.names.capacity;
+
+	while (capacity < required) {
+		if (__builtin_mul_overflow(capacity, LONE_LISP_NAMES_GROWTH_FACTOR, &capacity)) { goto overflow; }
+	}
+
+	capacity = lone_lisp_names_round_to_pages(lone, capacity);
+	old_base = lone->symbols.names.base;
+	remapped = linux_mremap(old_base, lone->symbols.names.capacity, capacity, MREMAP_MAYMOVE, 0);
+
+	if (remapped < 0) { goto remap_error; }
+
+	lone->symbols.names.base     = (unsigned char *) remapped;
+	lone->symbols.names.capacity = capacity;
+
+	if (lone->symbols.names.base != old_base) {
+		lone_lisp_names_rebase(lone, old_base);
+	}
+
+	return;
+
+overflow:
+remap_error:
+	linux_exit(-1);
+}
+
+unsigned char *lone_lisp_names_store(struct lone_lisp *lone,
+		size_t index, unsigned char *bytes, size_t count)
+{
+	struct lone_lisp_name_header *header;
+	size_t size, offset;
+	unsigned char *name;
+	bool internal;
+
+	size = lone_lisp_names_record_size(count);
+
+	if (lone->symbols.names.capacity - lone->symbols.names.used < size) {
+		/* growing may move the arena along with the bytes being stored */
+		internal = lone_lisp_names_contain(lone, bytes);
+		offset   = internal? (size_t) (bytes - lone->symbols.names.base) : 0;
+
+		lone_lisp_names_grow(lone, size);
+
+		if (internal) { bytes = lone->symbols.names.base + offset; }
+	}
+
+	header        = lone_lisp_names_header_at(lone, lone->symbols.names.used);
+	header->index = index;
+	header->count = count;
+
+	name = (unsigned char *) (header + 1);
+	lone_memory_move(bytes, name, count);
+	name[count] = '\0';
+
+	lone->symbols.names.used += size;
+
+	return name;
+}
+
+void lone_lisp_names_move(struct lone_lisp *lone, unsigned char *name, size_t index)
+{
+	struct lone_lisp_name_header *header;
+
+	header = ((struct lone_lisp_name_header *) name) - 1;
+	header->index = index;
+}
+
+static void lone_lisp_names_shrink(struct lone_lisp *lone)
+{
+	size_t minimum, capacity;
+
+	minimum  = lone_lisp_names_round_to_pages(lone, LONE_LISP_NAMES_INITIAL_CAPACITY);
+	capacity = lone->symbols.names.capacity;
+
+	if (capacity <= minimum) { return; }
+	if (lone->symbols.names.used * LONE_LISP_NAMES_GROWTH_FACTOR * LONE_LISP_NAMES_GROWTH_FACTOR >= capacity) { return; }
+
+	capacity = lone_lisp_names_round_to_pages(lone, capacity / LONE_LISP_NAMES_GROWTH_FACTOR);
+	if (capacity < minimum) { capacity = minimum; }
+
+	/* shrinking in place never moves the mapping */
+	if (linux_mremap(lone->symbols.names.base, lone->symbols.names.capacity, capacity, 0, 0) < 0) {
+		return;
+	}
+
+	lone->symbols.names.capacity = capacity;
+}
+
+void lone_lisp_names_compact(struct lone_lisp *lone)
+{
+	struct lone_lisp_name_header *header;
+	struct lone_lisp_heap_value *owner;
+	size_t read, write, size;
+
+	for (read = 0, write = 0; read < lone->symbols.names.used; read += size) {
+		header = lone_lisp_names_header_at(lone, read);
+		size   = lone_lisp_names_record_size(header->count);
+		owner  = lone_lisp_names_owner(lone, header, (unsigned char *) (header + 1));
+
+		if (!owner) { continue; }
+
+		if (write != read) {
+			lone_memory_move(header, lone->symbols.names.base + write, size);
+			header = lone_lisp_names_header_at(lone, write);
+			owner->as.symbol.name.pointer = (unsigned char *) (header + 1);
+		}
+
+		write += size;
+	}
+
+	lone->symbols.names.used = write;
+
+	lone_lisp_names_shrink(lone);
+}
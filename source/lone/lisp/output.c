@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/output.h>
+
+#include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
+
+#include <lone/linux.h>
+
+#include <asm/termbits.h>
+#include <asm/ioctls.h>
+
+void lone_lisp_output_initialize(struct lone_lisp *lone)
+{
+	size_t i;
+
+	for (i = 0; i < LONE_LISP_OUTPUT_STREAMS; ++i) {
+		lone->outputs[i].file_descriptor = -1;
+		lone->outputs[i].buffering = LONE_LISP_OUTPUT_UNBUFFERED;
+		lone->outputs[i].buffer = (struct lone_bytes) { 0, 0 };
+		lone->outputs[i].used = 0;
+	}
+}
+
+static enum lone_lisp_output_buffering lone_lisp_output_default_buffering(int file_descriptor)
+{
+	struct termios terminal;
+
+	if (file_descriptor == 2) { return LONE_LISP_OUTPUT_UNBUFFERED; }
+
+	if (linux_ioctl(file_descriptor, TCGETS, &terminal) == 0) {
+		return LONE_LISP_OUTPUT_LINE_BUFFERED;
+	}
+
+	return LONE_LISP_OUTPUT_FULLY_BUFFERED;
+}
+
+static struct lone_lisp_output *lone_lisp_output_find(struct lone_lisp *lone, int file_descriptor)
+{
+	size_t i;
+
+	for (i = 0; i < LONE_LISP_OUTPUT_STREAMS; ++i) {
+		if (lone->outputs[i].file_descriptor == file_descriptor) {
+			return &lone->outputs[i];
+		}
+	}
+
+	return 0;
+}
+
+/* Returns the stream for the file descriptor,
+ * opening one if there is a free slot. */
+static struct lone_lisp_output *lone_lisp_output_open(struct lone_lisp *lone, int file_descriptor)
+{
+	struct lone_lisp_output *output;
+
+	if (file_descriptor < 0) { return 0; }
+
+	output = lone_lisp_output_find(lone, file_descriptor);
+	if (output) { return output; }
+
+	output = lone_lisp_output_find(lone, -1);
+	if (!output) { return 0; }
+
+	if (!output->buffer.pointer) {
+		output->buffer.count   = LONE_LISP_OUTPUT_BUFFER_SIZE;
+		output->buffer.pointer = lone_memory_allocate(lone->system,
+				LONE_LISP_OUTPUT_BUFFER_SIZE, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+	}
+
+	output->file_descriptor = file_descriptor;
+	output->buffering       = lone_lisp_output_default_buffering(file_descriptor);
+	output->used            = 0;
+
+	return output;
+}
+
+/* Writes the pending buffered output followed by the given bytes
+ * with as few writev system calls as possible. Write errors
+ * discard the output, as with unbuffered writes. Nonblocking
+ * file descriptors are waited on until they become writable. */
+static void lone_lisp_output_drain(struct lone_lisp_output *output, struct lone_bytes bytes)
+{
+	struct iovec vectors[2], *vector;
+	ssize_t result;
+	size_t written;
+	int count;
+
+	vectors[0] = (struct iovec) { .iov_base = output->buffer.pointer, .iov_len = output->used };
+	vectors[1] = (struct iovec) { .iov_base = bytes.pointer,          .iov_len = bytes.count };
+	vector = vectors;
+	count = 2;
+
+	output->used = 0;
+
+	while (count > 0) {
+		if (vector->iov_len == 0) { ++vector; --count; continue; }
+
+		result = linux_writev(output->file_descriptor, vector, count);
+
+		if (result < 0) {
+			if (result == -EINTR) { continue; }
+			if (result == -EAGAIN && linux_poll_one(output->file_descriptor, POLLOUT, -1) >= 0) { continue; }
+			return;
+		}
+
+		if (result == 0) { return; }
+
+		written = (size_t) result;
+
+		while (count > 0 && written >= vector->iov_len) {
+			written -= vector->iov_len;
+			++vector;
+			--count;
+		}
+
+		if (count > 0) {
+			vector->iov_base = (unsigned char *) vector->iov_base + written;
+			vector->iov_len -= written;
+		}
+	}
+}
+
+static bool lone_lisp_output_has_newline(struct lone_bytes bytes)
+{
+	size_t i;
+
+	for (i = 0; i < bytes.count; ++i) {
+		if (bytes.pointer[i] == '\n') { return true; }
+	}
+
+	return false;
+}
+
+void lone_lisp_output_write(struct lone_lisp *lone, int file_descriptor, struct lone_bytes bytes)
+{
+	struct lone_lisp_output *output;
+
+	output = lone_lisp_output_open(lone, file_descriptor);
+
+	if (!output) {
+		/* out of streams */
+		linux_write_bytes(file_descriptor, bytes);
+		return;
+	}
+
+	if (output->buffering == LONE_LISP_OUTPUT_UNBUFFERED
+	 || bytes.count > output->buffer.count - output->used) {
+		lone_lisp_output_drain(output, bytes);
+		return;
+	}
+
+	lone_memory_move(bytes.pointer, output->buffer.pointer + output->used, bytes.count);
+	output->used += bytes.count;
+
+	if (output->buffering == LONE_LISP_OUTPUT_LINE_BUFFERED && lone_lisp_output_has_newline(bytes)) {
+		lone_lisp_output_drain(output, (struct lone_bytes) { 0, 0 });
+	}
+}
+
+void lone_lisp_output_flush(struct lone_lisp *lone, int file_descriptor)
+{
+	struct lone_lisp_output *output;
+
+	if (file_descriptor < 0) { return; }
+
+	output = lone_lisp_output_find(lone, file_descriptor);
+
+	if (output && output->used) {
+		lone_lisp_output_drain(output, (struct lone_bytes) { 0, 0 });
+	}
+}
+
+void lone_lisp_output_flush_all(struct lone_lisp *lone)
+{
+	size_t i;
+
+	for (i = 0; i < LONE_LISP_OUTPUT_STREAMS; ++i) {
+		lone_lisp_output_flush(lone, lone->outputs[i].file_descriptor);
+	}
+}
+
+void lone_lisp_output_close(struct lone_lisp *lone, int file_descriptor)
+{
+	struct lone_lisp_output *output;
+
+	if (file_descriptor < 0) { return; }
+
+	output = lone_lisp_output_find(lone, file_descriptor);
+	if (!output) { return; }
+
+	/* the buffer is kept for the next stream to use the slot */
+	output->file_descriptor = -1;
+	output->buffering       = LONE_LISP_OUTPUT_UNBUFFERED;
+	output->used            = 0;
+}
+
+void lone_lisp_exit(struct lone_lisp *lone, int code)
+{
+	lone_lisp_output_flush_all(lone);
+	linux_exit(code);
+}
+
+bool lone_lisp_output_set_buffering(struct lone_lisp *lone, int file_descriptor,
+		enum lone_lisp_output_buffering buffering)
+{
+	struct lone_lisp_output *output;
+
+	output = lone_lisp_output_open(lone, file_descriptor);
+	if (!output) { return false; }
+
+	lone_lisp_output_flush(lone, file_descriptor);
+	output->buffering = buffering;
+
+	return true;
+}
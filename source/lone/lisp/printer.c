@@ -1,46 +1,23 @@
 /* SPDX-License-Identifier: AGPL-3.0-or-later */
 
 #include <lone/lisp/printer.h>
+#include <lone/lisp/output.h>
 
 #include <lone/memory/allocator.h>
+#include <lone/memory/array.h>
 #include <lone/memory/functions.h>
 
+#include <lone/bits.h>
 #include <lone/linux.h>
 
-static void lone_lisp_print_integer(int fd, long n)
+static void lone_lisp_print_integer(struct lone_lisp *lone, int fd, long n)
 {
-	char digits[LONE_LISP_DECIMAL_DIGITS_PER_INTEGER + 1]; /* digits + sign */
-	char *digit;
-	bool is_negative;
-	unsigned long magnitude;
-	size_t count;
-
-	digit = digits + LONE_LISP_DECIMAL_DIGITS_PER_INTEGER;  /* work backwards */
-	count = 0;
-
-	if (n < 0) {
-		is_negative = true;
-		magnitude = -((unsigned long) n);
-	} else {
-		is_negative = false;
-		magnitude = (unsigned long) n;
-	}
-
-	do {
-		*--digit = '0' + (magnitude % 10);
-		magnitude /= 10;
-		++count;
-	} while (magnitude > 0);
-
-	if (is_negative) {
-		*--digit = '-';
-		++count;
-	}
+	unsigned char digits[LONE_LISP_INTEGER_FORMAT_SIZE];
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE(count, digit));
+	lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE(lone_lisp_integer_format_decimal(n, digits), digits));
 }
 
-static void lone_lisp_print_escaped_content(struct lone_bytes content, int fd,
+static void lone_lisp_print_escaped_content(struct lone_lisp *lone, struct lone_bytes content, int fd,
 		bool escape_non_ascii, bool unicode_escapes)
 {
 	static const char hex[] = "0123456789abcdef";
@@ -97,15 +74,15 @@ static void lone_lisp_print_escaped_content(struct lone_bytes content, int fd,
 		#undef ESCAPE
 
 		if (i > run_start) {
-			linux_write_bytes(fd, LONE_BYTES_VALUE(i - run_start, content.pointer + run_start));
+			lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE(i - run_start, content.pointer + run_start));
 		}
 
-		linux_write_bytes(fd, LONE_BYTES_VALUE(escape_length, escape));
+		lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE(escape_length, escape));
 		run_start = i + 1;
 	}
 
 	if (content.count > run_start) {
-		linux_write_bytes(fd, LONE_BYTES_VALUE(content.count - run_start, content.pointer + run_start));
+		lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE(content.count - run_start, content.pointer + run_start));
 	}
 }
 
@@ -115,177 +92,420 @@ static void lone_lisp_print_bytes(struct lone_lisp *lone, struct lone_lisp_value
 
 	content = lone_lisp_bytes_of(lone, &bytes);
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("b\""));
-	lone_lisp_print_escaped_content(content, fd, true, false);
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
+	lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE_FROM_LITERAL("b\""));
+	lone_lisp_print_escaped_content(lone, content, fd, true, false);
+	lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
 }
 
-static void lone_lisp_print_list(struct lone_lisp *lone, struct lone_lisp_value list, int fd)
+static void lone_lisp_print_text(struct lone_lisp *lone, struct lone_lisp_value value, int fd)
 {
-	struct lone_lisp_value first, rest;
-
-	first = lone_lisp_list_first(lone, list);
-	rest = lone_lisp_list_rest(lone, list);
+	struct lone_bytes text;
 
-	lone_lisp_print(lone, first, fd);
+	text = lone_lisp_bytes_of(lone, &value);
 
-	if (lone_lisp_is_nil(rest)) {
-		/* proper list termination */
-	} else if (lone_lisp_is_list(lone, rest)) {
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
-		lone_lisp_print_list(lone, rest, fd);
-	} else {
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" . "));
-		lone_lisp_print(lone, rest, fd);
-	}
+	lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
+	lone_lisp_print_escaped_content(lone, text, fd, false, true);
+	lone_lisp_output_write(lone, fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
 }
 
-static void lone_lisp_print_vector(struct lone_lisp *lone, struct lone_lisp_value vector, int fd)
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Values are printed iteratively from an explicit stack of tasks      │
+   │    so that the depth of nesting is bounded only by memory rather       │
+   │    than by the native stack. Tasks are pushed in reverse order of      │
+   │    execution: the element printed next is always on top.               │
+   │                                                                        │
+   │    Containers being printed are flagged and recorded on a path.        │
+   │    Encountering a flagged container again means the value refers       │
+   │    to itself, which is printed as #<cycle> instead of recursing        │
+   │    forever. Every cell of a list is flagged as it is traversed         │
+   │    so that lists whose tails loop back are detected as well.           │
+   │    Flags are cleared when the container is finished, so shared         │
+   │    but acyclic structure is printed in full at each occurrence.        │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+enum lone_lisp_print_task_type {
+	LONE_LISP_PRINT_VALUE,
+	LONE_LISP_PRINT_LITERAL,
+	LONE_LISP_PRINT_LIST,
+	LONE_LISP_PRINT_LIST_REST,
+	LONE_LISP_PRINT_VECTOR,
+	LONE_LISP_PRINT_TABLE,
+	LONE_LISP_PRINT_CODE,
+	LONE_LISP_PRINT_LEAVE,
+};
+
+struct lone_lisp_print_task {
+	enum lone_lisp_print_task_type type;
+	struct lone_lisp_value value;
+	size_t depth;
+	size_t index;  /* next vector index or table slot */
+	size_t count;  /* elements printed so far, path height for LEAVE */
+	char *literal;
+};
+
+struct lone_lisp_printer {
+	struct lone_lisp *lone;
+	int fd;
+	struct lone_lisp_print_limits limits;
+
+	struct {
+		struct lone_lisp_print_task *tasks;
+		size_t count;
+		size_t capacity;
+	} stack;
+
+	struct {
+		struct lone_lisp_value *values;
+		size_t count;
+		size_t capacity;
+	} path;
+};
+
+static void *lone_lisp_printer_grow(struct lone_lisp_printer *printer,
+		void *pointer, size_t *capacity, size_t size, size_t alignment)
 {
-	struct lone_lisp_value element;
-	size_t count, i;
-
-	count = lone_lisp_vector_count(lone, vector);
+	size_t old_capacity = *capacity;
 
-	if (count == 0) { linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("[]")); return; }
+	if (__builtin_mul_overflow(old_capacity, (size_t) 2, capacity)) { linux_exit(-1); }
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("[ "));
+	return lone_memory_array(printer->lone->system, pointer, old_capacity, *capacity, size, alignment);
+}
 
-	LONE_LISP_VECTOR_FOR_EACH(lone, element, vector, i) {
-		lone_lisp_print(lone, element, fd);
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
+static void lone_lisp_printer_push(struct lone_lisp_printer *printer, struct lone_lisp_print_task task)
+{
+	if (printer->stack.count == printer->stack.capacity) {
+		printer->stack.tasks = lone_lisp_printer_grow(printer, printer->stack.tasks,
+				&printer->stack.capacity, sizeof(*printer->stack.tasks), alignof(*printer->stack.tasks));
 	}
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("]"));
+	printer->stack.tasks[printer->stack.count++] = task;
 }
 
-static void lone_lisp_print_table(struct lone_lisp *lone, struct lone_lisp_value table, int fd)
+static void lone_lisp_printer_push_value(struct lone_lisp_printer *printer,
+		struct lone_lisp_value value, size_t depth)
 {
-	struct lone_lisp_table_entry entry;
-	size_t i;
-
-	if (lone_lisp_table_count(lone, table) == 0) { linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("{}")); return; }
-
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("{ "));
-
-	LONE_LISP_TABLE_FOR_EACH(lone, entry, table, i) {
-		lone_lisp_print(lone, entry.key, fd);
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
-		lone_lisp_print(lone, entry.value, fd);
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
-	}
+	lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+		.type = LONE_LISP_PRINT_VALUE, .value = value, .depth = depth,
+	});
+}
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("}"));
+static void lone_lisp_printer_push_literal(struct lone_lisp_printer *printer, char *literal)
+{
+	lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+		.type = LONE_LISP_PRINT_LITERAL, .literal = literal,
+	});
 }
 
-static void lone_lisp_print_function(struct lone_lisp *lone, struct lone_lisp_value function, int fd)
+static void lone_lisp_printer_write(struct lone_lisp_printer *printer, char *literal)
 {
-	struct lone_lisp_value arguments, code;
+	lone_lisp_output_write(printer->lone, printer->fd,
+			LONE_BYTES_VALUE(lone_c_string_length(literal), literal));
+}
 
-	arguments = lone_lisp_heap_value_of(lone, function)->as.function.arguments;
-	code = lone_lisp_heap_value_of(lone, function)->as.function.code;
+/* Values being printed are tracked in a heap bitmap rather than
+ * in the values so that printing never writes to shared pages. */
+static size_t lone_lisp_printer_index_of(struct lone_lisp_printer *printer, struct lone_lisp_value value)
+{
+	return (size_t) (lone_lisp_heap_value_of(printer->lone, value) - printer->lone->heap.values);
+}
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("(𝛌 "));
-	lone_lisp_print(lone, arguments, fd);
+static bool lone_lisp_printer_is_printing(struct lone_lisp_printer *printer, struct lone_lisp_value value)
+{
+	return lone_bits_get(printer->lone->heap.bits.printing, lone_lisp_printer_index_of(printer, value));
+}
 
-	while (!lone_lisp_is_nil(code)) {
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("\n  "));
-		lone_lisp_print(lone, lone_lisp_list_first(lone, code), fd);
-		code = lone_lisp_list_rest(lone, code);
+static void lone_lisp_printer_enter(struct lone_lisp_printer *printer, struct lone_lisp_value value)
+{
+	if (printer->path.count == printer->path.capacity) {
+		printer->path.values = lone_lisp_printer_grow(printer, printer->path.values,
+				&printer->path.capacity, sizeof(*printer->path.values), alignof(*printer->path.values));
 	}
 
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(")"));
+	printer->path.values[printer->path.count++] = value;
+	lone_bits_mark(printer->lone->heap.bits.printing, lone_lisp_printer_index_of(printer, value));
 }
 
-static void lone_lisp_print_text(struct lone_lisp *lone, struct lone_lisp_value value, int fd)
+static void lone_lisp_printer_leave(struct lone_lisp_printer *printer, size_t height)
 {
-	struct lone_bytes text;
-
-	text = lone_lisp_bytes_of(lone, &value);
-
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
-	lone_lisp_print_escaped_content(text, fd, false, true);
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("\""));
+	while (printer->path.count > height) {
+		--printer->path.count;
+		lone_bits_clear(printer->lone->heap.bits.printing,
+				lone_lisp_printer_index_of(printer, printer->path.values[printer->path.count]));
+	}
 }
 
-static void lone_lisp_print_hash_notation(struct lone_lisp *lone, char *descriptor, struct lone_lisp_value value, int fd)
+static bool lone_lisp_printer_is_too_long(struct lone_lisp_printer *printer, size_t count)
 {
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("#<"));
-	linux_write_bytes(fd, LONE_BYTES_VALUE(lone_c_string_length(descriptor), descriptor));
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
-	lone_lisp_print(lone, value, fd);
-	linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(">"));
+	return printer->limits.length && count >= printer->limits.length;
 }
 
-void lone_lisp_print(struct lone_lisp *lone, struct lone_lisp_value value, int fd)
+/* Prints scalars immediately. Containers print their opening
+ * and push the tasks which print their elements and close them. */
+static void lone_lisp_printer_value(struct lone_lisp_printer *printer,
+		struct lone_lisp_value value, size_t depth)
 {
+	struct lone_lisp *lone = printer->lone;
+	struct lone_lisp_heap_value *actual;
+	char *opening, *closing, *descriptor;
+	struct lone_lisp_value inner;
+	enum lone_lisp_print_task_type type;
+
 	switch (lone_lisp_type_of(value)) {
 	case LONE_LISP_TAG_NIL:
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("()"));
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("()"));
 		return;
 	case LONE_LISP_TAG_FALSE:
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("false"));
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("false"));
 		return;
 	case LONE_LISP_TAG_TRUE:
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("true"));
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("true"));
 		return;
 	case LONE_LISP_TAG_INTEGER:
-		lone_lisp_print_integer(fd, lone_lisp_integer_of(value));
+		lone_lisp_print_integer(lone, printer->fd, lone_lisp_integer_of(value));
+		return;
+	case LONE_LISP_TAG_BYTES:
+		lone_lisp_print_bytes(lone, value, printer->fd);
+		return;
+	case LONE_LISP_TAG_PACKED_SYMBOL_8:
+	case LONE_LISP_TAG_PACKED_SYMBOL_9:
+	case LONE_LISP_TAG_PACKED_SYMBOL_10:
+	case LONE_LISP_TAG_PACKED_SYMBOL_11:
+	case LONE_LISP_TAG_SYMBOL:
+		lone_lisp_output_write(lone, printer->fd, lone_lisp_bytes_of(lone, &value));
+		return;
+	case LONE_LISP_TAG_TEXT:
+		lone_lisp_print_text(lone, value, printer->fd);
 		return;
 	case LONE_LISP_TAG_MODULE:
-		lone_lisp_print_hash_notation(lone, "module",
-				lone_lisp_heap_value_of(lone, value)->as.module.name, fd);
-		break;
+		descriptor = "module";
+		inner = lone_lisp_heap_value_of(lone, value)->as.module.name;
+		goto hash_notation;
 	case LONE_LISP_TAG_PRIMITIVE:
-		lone_lisp_print_hash_notation(lone, "primitive",
-				lone_lisp_heap_value_of(lone, value)->as.primitive.name, fd);
-		break;
-	case LONE_LISP_TAG_FUNCTION:
-		lone_lisp_print_function(lone, value, fd);
-		break;
+		descriptor = "primitive";
+		inner = lone_lisp_heap_value_of(lone, value)->as.primitive.name;
+		goto hash_notation;
 	case LONE_LISP_TAG_CONTINUATION:
-		lone_lisp_print_hash_notation(lone, "continuation",
-				lone_lisp_integer_create(lone_lisp_heap_value_of(lone, value)->as.continuation.frame_count), fd);
-		break;
+		descriptor = "continuation";
+		inner = lone_lisp_integer_create(lone_lisp_heap_value_of(lone, value)->as.continuation.frame_count);
+		goto hash_notation;
 	case LONE_LISP_TAG_GENERATOR:
-		lone_lisp_print_hash_notation(
-			lone,
-			"generator",
-			lone_lisp_heap_value_of(lone, value)->as.generator.function,
-			fd
-		);
-		break;
+		descriptor = "generator";
+		inner = lone_lisp_heap_value_of(lone, value)->as.generator.function;
+		goto hash_notation;
+	case LONE_LISP_TAG_SHAPE:
+		descriptor = "shape";
+		inner = lone_lisp_integer_create(lone_lisp_heap_value_of(lone, value)->as.shape.count);
+		goto hash_notation;
 	case LONE_LISP_TAG_LIST:
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL("("));
-		lone_lisp_print_list(lone, value, fd);
-		linux_write_bytes(fd, LONE_BYTES_VALUE_FROM_LITERAL(")"));
-		break;
+		opening = "(";   closing = ")";  type = LONE_LISP_PRINT_LIST;
+		goto container;
 	case LONE_LISP_TAG_VECTOR:
-		lone_lisp_print_vector(lone, value, fd);
-		break;
+		opening = "[ ";  closing = "]";  type = LONE_LISP_PRINT_VECTOR;
+		if (lone_lisp_vector_count(lone, value) == 0) { opening = "[]"; closing = ""; }
+		goto container;
 	case LONE_LISP_TAG_TABLE:
-		lone_lisp_print_table(lone, value, fd);
-		break;
-	case LONE_LISP_TAG_SHAPE:
-		lone_lisp_print_hash_notation(
-			lone,
-			"shape",
-			lone_lisp_integer_create(
-				lone_lisp_heap_value_of(lone, value)->as.shape.count
-			),
-			fd
-		);
-		break;
-	case LONE_LISP_TAG_BYTES:
-		lone_lisp_print_bytes(lone, value, fd);
-		break;
-	case LONE_LISP_TAG_SYMBOL: {
-		struct lone_bytes name = lone_lisp_bytes_of(lone, &value);
-		linux_write_bytes(fd, name);
-		break;
+		opening = "{ ";  closing = "}";  type = LONE_LISP_PRINT_TABLE;
+		if (lone_lisp_table_count(lone, value) == 0) { opening = "{}"; closing = ""; }
+		goto container;
+	case LONE_LISP_TAG_FUNCTION:
+		opening = "(𝛌 "; closing = ")";  type = LONE_LISP_PRINT_CODE;
+		goto container;
 	}
-	case LONE_LISP_TAG_TEXT:
-		lone_lisp_print_text(lone, value, fd);
-		break;
+
+	linux_exit(-1);
+
+hash_notation:
+
+	lone_lisp_printer_write(printer, "#<");
+	lone_lisp_printer_write(printer, descriptor);
+	lone_lisp_printer_write(printer, " ");
+	lone_lisp_printer_push_literal(printer, ">");
+	lone_lisp_printer_push_value(printer, inner, depth);
+	return;
+
+container:
+
+	if (lone_lisp_printer_is_printing(printer, value)) {
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("#<cycle>"));
+		return;
+	}
+
+	if (printer->limits.depth && depth >= printer->limits.depth) {
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("..."));
+		return;
+	}
+
+	lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+		.type = LONE_LISP_PRINT_LEAVE, .count = printer->path.count,
+	});
+	lone_lisp_printer_enter(printer, value);
+
+	lone_lisp_printer_write(printer, opening);
+	lone_lisp_printer_push_literal(printer, closing);
+
+	actual = lone_lisp_heap_value_of(lone, value);
+
+	if (type == LONE_LISP_PRINT_CODE) {
+		lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+			.type = LONE_LISP_PRINT_CODE, .value = actual->as.function.code, .depth = depth,
+		});
+		lone_lisp_printer_push_value(printer, actual->as.function.arguments, depth + 1);
+		return;
+	}
+
+	lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+		.type = type, .value = value, .depth = depth,
+	});
+}
+
+static void lone_lisp_printer_task(struct lone_lisp_printer *printer, struct lone_lisp_print_task task)
+{
+	struct lone_lisp *lone = printer->lone;
+	struct lone_lisp_table_entry entry;
+	struct lone_lisp_value rest;
+
+	switch (task.type) {
+	case LONE_LISP_PRINT_VALUE:
+		lone_lisp_printer_value(printer, task.value, task.depth);
+		return;
+	case LONE_LISP_PRINT_LITERAL:
+		lone_lisp_printer_write(printer, task.literal);
+		return;
+	case LONE_LISP_PRINT_LEAVE:
+		lone_lisp_printer_leave(printer, task.count);
+		return;
+
+	case LONE_LISP_PRINT_LIST:
+		if (lone_lisp_printer_is_too_long(printer, task.count)) {
+			lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("..."));
+			return;
+		}
+
+		lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+			.type = LONE_LISP_PRINT_LIST_REST,
+			.value = lone_lisp_list_rest(lone, task.value),
+			.depth = task.depth,
+			.count = task.count + 1,
+		});
+		lone_lisp_printer_push_value(printer, lone_lisp_list_first(lone, task.value), task.depth + 1);
+		return;
+
+	case LONE_LISP_PRINT_LIST_REST:
+		rest = task.value;
+
+		if (lone_lisp_is_nil(rest)) {
+			/* proper list termination */
+		} else if (lone_lisp_is_list(lone, rest)) {
+			if (lone_lisp_printer_is_printing(printer, rest)) {
+				/* tail loops back into the list */
+				lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL(" . #<cycle>"));
+				return;
+			}
+
+			/* cleared along with the first cell of the list */
+			lone_lisp_printer_enter(printer, rest);
+
+			lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL(" "));
+			task.type = LONE_LISP_PRINT_LIST;
+			lone_lisp_printer_push(printer, task);
+		} else {
+			lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL(" . "));
+			lone_lisp_printer_push_value(printer, rest, task.depth + 1);
+		}
+		return;
+
+	case LONE_LISP_PRINT_VECTOR:
+		if (task.index >= lone_lisp_vector_count(lone, task.value)) { return; }
+
+		if (lone_lisp_printer_is_too_long(printer, task.count)) {
+			lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("... "));
+			return;
+		}
+
+		lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+			.type = LONE_LISP_PRINT_VECTOR,
+			.value = task.value,
+			.depth = task.depth,
+			.index = task.index + 1,
+			.count = task.count + 1,
+		});
+		lone_lisp_printer_push_literal(printer, " ");
+		lone_lisp_printer_push_value(printer,
+				lone_lisp_vector_get_value_at(lone, task.value, task.index), task.depth + 1);
+		return;
+
+	case LONE_LISP_PRINT_TABLE:
+		if (!lone_lisp_table_next_entry(lone, task.value, &task.index, &entry)) { return; }
+
+		if (lone_lisp_printer_is_too_long(printer, task.count)) {
+			lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("... "));
+			return;
+		}
+
+		lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+			.type = LONE_LISP_PRINT_TABLE,
+			.value = task.value,
+			.depth = task.depth,
+			.index = task.index + 1,
+			.count = task.count + 1,
+		});
+		lone_lisp_printer_push_literal(printer, " ");
+		lone_lisp_printer_push_value(printer, entry.value, task.depth + 1);
+		lone_lisp_printer_push_literal(printer, " ");
+		lone_lisp_printer_push_value(printer, entry.key, task.depth + 1);
+		return;
+
+	case LONE_LISP_PRINT_CODE:
+		if (lone_lisp_is_nil(task.value)) { return; }
+
+		lone_lisp_output_write(lone, printer->fd, LONE_BYTES_VALUE_FROM_LITERAL("\n  "));
+
+		lone_lisp_printer_push(printer, (struct lone_lisp_print_task) {
+			.type = LONE_LISP_PRINT_CODE,
+			.value = lone_lisp_list_rest(lone, task.value),
+			.depth = task.depth,
+		});
+		lone_lisp_printer_push_value(printer, lone_lisp_list_first(lone, task.value), task.depth + 1);
+		return;
 	}
+
+	linux_exit(-1);
+}
+
+void lone_lisp_print_with_limits(struct lone_lisp *lone, struct lone_lisp_value value, int fd,
+		struct lone_lisp_print_limits limits)
+{
+	struct lone_lisp_printer printer;
+	struct lone_lisp_print_task task;
+
+	printer.lone = lone;
+	printer.fd = fd;
+	printer.limits = limits;
+	printer.stack.count = 0;
+	printer.stack.capacity = LONE_LISP_PRINT_STACK_INITIAL_SIZE;
+	printer.stack.tasks = lone_memory_array(lone->system, 0, 0, printer.stack.capacity,
+			sizeof(*printer.stack.tasks), alignof(*printer.stack.tasks));
+	printer.path.count = 0;
+	printer.path.capacity = LONE_LISP_PRINT_STACK_INITIAL_SIZE;
+	printer.path.values = lone_memory_array(lone->system, 0, 0, printer.path.capacity,
+			sizeof(*printer.path.values), alignof(*printer.path.values));
+
+	lone_lisp_printer_push_value(&printer, value, 0);
+
+	while (printer.stack.count > 0) {
+		task = printer.stack.tasks[--printer.stack.count];
+		lone_lisp_printer_task(&printer, task);
+	}
+
+	lone_memory_deallocate(lone->system, printer.stack.tasks,
+			printer.stack.capacity, sizeof(*printer.stack.tasks), alignof(*printer.stack.tasks));
+	lone_memory_deallocate(lone->system, printer.path.values,
+			printer.path.capacity, sizeof(*printer.path.values), alignof(*printer.path.values));
+}
+
+void lone_lisp_print(struct lone_lisp *lone, struct lone_lisp_value value, int fd)
+{
+	lone_lisp_print_with_limits(lone, value, fd, lone->print_limits);
 }
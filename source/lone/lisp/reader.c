@@ -1,10 +1,13 @@
 /* SPDX-License-Identifier: AGPL-3.0-or-later */
 
 #include <lone/lisp/reader.h>
+#include <lone/lisp/hash_cons.h>
+#include <lone/lisp/scan.h>
 
 #include <lone/unicode.h>
 
 #include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
 
 #include <lone/linux.h>
 
@@ -13,20 +16,31 @@ void lone_lisp_reader_for_bytes(struct lone_lisp *lone,
 {
 	reader->file_descriptor = -1;
 	reader->buffer.bytes = bytes;
+	reader->buffer.position.token = 0;
 	reader->buffer.position.read = 0;
 	reader->buffer.position.write = bytes.count;
+	reader->buffer.mapping = lone_lisp_nil();
 	reader->status.error = false;
 	reader->status.end_of_input = false;
 }
 
+void lone_lisp_reader_for_mapped_bytes(struct lone_lisp *lone,
+		struct lone_lisp_reader *reader, struct lone_lisp_value mapping)
+{
+	lone_lisp_reader_for_bytes(lone, reader, lone_lisp_heap_value_of(lone, mapping)->as.bytes.data);
+	reader->buffer.mapping = mapping;
+}
+
 void lone_lisp_reader_for_file_descriptor(struct lone_lisp *lone,
 		struct lone_lisp_reader *reader, size_t buffer_size, int file_descriptor)
 {
 	reader->file_descriptor = file_descriptor;
 	reader->buffer.bytes.count = buffer_size;
 	reader->buffer.bytes.pointer = lone_memory_allocate(lone->system, buffer_size, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+	reader->buffer.position.token = 0;
 	reader->buffer.position.read = 0;
 	reader->buffer.position.write = 0;
+	reader->buffer.mapping = lone_lisp_nil();
 	reader->status.error = false;
 	reader->status.end_of_input = false;
 }
@@ -38,65 +52,99 @@ void lone_lisp_reader_finalize(struct lone_lisp *lone, struct lone_lisp_reader *
 	}
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    File descriptor readers reuse their buffer as input streams in.     │
+   │    Input before the start of the token being lexed has already         │
+   │    been turned into values and is no longer referenced. It is          │
+   │    discarded by moving the unconsumed input to the start of the        │
+   │    buffer before reading more. The buffer only grows when a single     │
+   │    token does not fit, so memory is bounded by the largest token       │
+   │    rather than by the size of the entire input.                        │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static void lone_lisp_reader_mark(struct lone_lisp_reader *reader)
+{
+	reader->buffer.position.token = reader->buffer.position.read;
+}
+
+static void lone_lisp_reader_compact(struct lone_lisp_reader *reader)
+{
+	size_t discarded;
+
+	discarded = reader->buffer.position.token;
+	if (discarded == 0) { return; }
+
+	lone_memory_move(reader->buffer.bytes.pointer + discarded,
+	                 reader->buffer.bytes.pointer,
+	                 reader->buffer.position.write - discarded);
+
+	reader->buffer.position.token  = 0;
+	reader->buffer.position.read  -= discarded;
+	reader->buffer.position.write -= discarded;
+}
+
 static size_t lone_lisp_reader_fill_buffer(struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
 	unsigned char *buffer;
-	size_t allocated, position, available, bytes_read, total_read, old_allocated;
+	size_t allocated, position, available, old_allocated;
 	ssize_t read_result;
+	long poll_result;
 
 	if (reader->file_descriptor == -1) {
 		/* reading from a fixed buffer, can't read more */
 		return 0;
 	}
 
+	if (reader->status.error) {
+		/* a previous read failed */
+		return 0;
+	}
+
+	lone_lisp_reader_compact(reader);
+
 	buffer = reader->buffer.bytes.pointer;
 	allocated = reader->buffer.bytes.count;
 	position = reader->buffer.position.write;
-	total_read = 0;
-
-	while (1) {
-		available = allocated - position;
-
-		if (available == 0) {
-			/* buffer is full, grow it before reading more */
-			old_allocated = allocated;
+	available = allocated - position;
 
-			if (__builtin_mul_overflow(allocated, (size_t) 2, &allocated)) {
-				goto overflow;
-			}
-
-			buffer = lone_memory_reallocate(
-				lone->system, buffer,
-				old_allocated, 1,
-				allocated, 1,
-				1,
-				LONE_MEMORY_ALLOCATION_FLAGS_NONE
-			);
-
-			available = allocated - position;
-		}
+	if (available == 0) {
+		/* the current token fills the buffer, grow it before reading more */
+		old_allocated = allocated;
 
-		read_result = linux_read_once(reader->file_descriptor, LONE_BYTES_VALUE(available, buffer + position));
-
-		if (read_result < 0) {
-			linux_exit(-1);
+		if (__builtin_mul_overflow(allocated, (size_t) 2, &allocated)) {
+			goto overflow;
 		}
 
-		bytes_read  = (size_t) read_result;
-		total_read += bytes_read;
-		position   += bytes_read;
+		buffer = lone_memory_reallocate(
+			lone->system, buffer,
+			old_allocated, 1,
+			allocated, 1,
+			1,
+			LONE_MEMORY_ALLOCATION_FLAGS_NONE
+		);
 
-		if (bytes_read < available) {
-			/* short read: end of input or no more data available right now */
-			break;
-		}
-		/* full read: loop to grow and read more */
+		available = allocated - position;
 	}
 
 	reader->buffer.bytes.pointer = buffer;
 	reader->buffer.bytes.count = allocated;
-	reader->buffer.position.write = position;
-	return total_read;
+
+	while ((read_result = linux_read_once(reader->file_descriptor,
+	                                      LONE_BYTES_VALUE(available, buffer + position))) == -EAGAIN) {
+		/* nonblocking descriptor without input yet, wait for some instead of spinning */
+		poll_result = linux_poll_one(reader->file_descriptor, POLLIN, -1);
+		if (poll_result < 0 && poll_result != -EINTR) { read_result = poll_result; break; }
+	}
+
+	if (read_result < 0) {
+		/* surfaced through the status like malformed input */
+		reader->status.error = true;
+		return 0;
+	}
+
+	reader->buffer.position.write = position + (size_t) read_result;
+	return (size_t) read_result;
 
 overflow:
 	linux_exit(-1);
@@ -108,6 +156,9 @@ overflow:
    │    starting from the current input position, with peek(0) being        │
    │    the current character and peek(k) being look ahead for k > 1.       │
    │                                                                        │
+   │    Peeking may read more input which may move the buffer               │
+   │    and invalidate pointers returned by previous peeks.                 │
+   │                                                                        │
    ╰────────────────────────────────────────────────────────────────────────╯ */
 static unsigned char *lone_lisp_reader_peek_k(struct lone_lisp *lone, struct lone_lisp_reader *reader, size_t k)
 {
@@ -115,17 +166,16 @@ static unsigned char *lone_lisp_reader_peek_k(struct lone_lisp *lone, struct lon
 
 	if (__builtin_add_overflow(reader->buffer.position.read, k, &position)) { return 0; }
 
-	if (position >= reader->buffer.position.write) {
+	while (position >= reader->buffer.position.write) {
 		/* we'd overrun the buffer because there's not enough input
 		 * fill it up by reading more first */
-		lone_lisp_reader_fill_buffer(lone, reader);
-
-		if (__builtin_add_overflow(reader->buffer.position.read, k, &position)) { return 0; }
-
-		if (position >= reader->buffer.position.write) {
-			/* wanted at least k bytes but got less */
+		if (lone_lisp_reader_fill_buffer(lone, reader) == 0) {
+			/* wanted at least k bytes but input ended */
 			return 0;
 		}
+
+		/* compaction may have moved the read position */
+		if (__builtin_add_overflow(reader->buffer.position.read, k, &position)) { return 0; }
 	}
 
 	return reader->buffer.bytes.pointer + position;
@@ -152,6 +202,58 @@ static void lone_lisp_reader_consume(struct lone_lisp_reader *reader)
 	lone_lisp_reader_consume_k(reader, 1);
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Runs of bytes of the same lexical class are scanned in bulk         │
+   │    over the buffered input rather than peeked at one by one.           │
+   │    Buffers are refilled whenever a run reaches their end.              │
+   │                                                                        │
+   │    Runs which do not belong to any token such as whitespace and        │
+   │    comments are discarded as they are consumed so that the buffer      │
+   │    never grows to hold them.                                           │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static size_t lone_lisp_reader_consume_run(struct lone_lisp *lone, struct lone_lisp_reader *reader,
+		size_t (*scan)(unsigned char *bytes, size_t count), bool discard)
+{
+	size_t consumed, available, scanned;
+
+	consumed = 0;
+
+	while (lone_lisp_reader_peek(lone, reader)) {
+		available = reader->buffer.position.write - reader->buffer.position.read;
+		scanned = scan(reader->buffer.bytes.pointer + reader->buffer.position.read, available);
+
+		lone_lisp_reader_consume_k(reader, scanned);
+		if (discard) { lone_lisp_reader_mark(reader); }
+		consumed += scanned;
+
+		if (scanned < available) { break; }
+	}
+
+	return consumed;
+}
+
+/* Finds the next quote or backslash at or after the given offset
+ * from the current input position without consuming any input.
+ * Returns false if the input ends before one is found. */
+static bool lone_lisp_reader_find_quoted_delimiter(struct lone_lisp *lone,
+		struct lone_lisp_reader *reader, size_t *offset)
+{
+	unsigned char *current;
+	size_t available, scanned;
+
+	while ((current = lone_lisp_reader_peek_k(lone, reader, *offset))) {
+		available = reader->buffer.position.write - reader->buffer.position.read - *offset;
+		scanned = lone_lisp_scan_quoted(current, available);
+		*offset += scanned;
+
+		if (scanned < available) { return true; }
+	}
+
+	return false;
+}
+
 static inline bool lone_lisp_reader_is_whitespace(unsigned char character)
 {
 	switch (character) {
@@ -173,14 +275,6 @@ static inline bool lone_lisp_reader_hex_digit_value(unsigned char character, uns
 	return false;
 }
 
-static inline bool lone_lisp_reader_is_opening_bracket(unsigned char character)
-{
-	switch (character) {
-	case '(': case '[': case '{': return true;
-	default:                      return false;
-	}
-}
-
 static inline bool lone_lisp_reader_is_closing_bracket(unsigned char character)
 {
 	switch (character) {
@@ -196,13 +290,6 @@ static inline bool lone_lisp_reader_is_token_separator(unsigned char character)
 	       || character == ';';
 }
 
-static inline bool lone_lisp_reader_is_symbol_terminator(unsigned char character)
-{
-	return    lone_lisp_reader_is_token_separator(character)
-	       || lone_lisp_reader_is_opening_bracket(character)
-	       || character == '"';
-}
-
 /* ╭────────────────────────────────────────────────────────────────────────╮
    │                                                                        │
    │    Analyzes a number and adds it to the tokens list if valid.          │
@@ -213,16 +300,16 @@ static inline bool lone_lisp_reader_is_symbol_terminator(unsigned char character
 static struct lone_lisp_value lone_lisp_reader_consume_number(struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
 	unsigned char *start, *current;
-	size_t start_offset, end;
+	size_t end;
 
 	start = lone_lisp_reader_peek(lone, reader);
 
 	if (!start) { goto error; }
 
 	/* remember where the token starts as an offset into the buffer
-	   peeking may grow the buffer and move its backing storage
+	   peeking may compact or grow the buffer and move its contents
 	   thereby invalidating any pointer from before that call       */
-	start_offset = reader->buffer.position.read;
+	lone_lisp_reader_mark(reader);
 	end = 0;
 
 	switch (*start) {
@@ -234,23 +321,18 @@ static struct lone_lisp_value lone_lisp_reader_consume_number(struct lone_lisp *
 		break;
 	}
 
-	if ((current = lone_lisp_reader_peek(lone, reader)) && lone_lisp_reader_is_digit(*current)) {
-		lone_lisp_reader_consume(reader);
-		++end;
-	} else {
+	if (!((current = lone_lisp_reader_peek(lone, reader)) && lone_lisp_reader_is_digit(*current))) {
 		goto error;
 	}
 
-	while ((current = lone_lisp_reader_peek(lone, reader)) && lone_lisp_reader_is_digit(*current)) {
-		lone_lisp_reader_consume(reader);
-		++end;
-	}
+	end += lone_lisp_reader_consume_run(lone, reader, lone_lisp_scan_digits, false);
 
+	current = lone_lisp_reader_peek(lone, reader);
 	if (current && !lone_lisp_reader_is_token_separator(*current)) { goto error; }
 
-	/* buffer may have been reallocated
-	   recalculate pointer from offset */
-	start = reader->buffer.bytes.pointer + start_offset;
+	/* buffer may have been compacted or reallocated
+	   recalculate pointer from the token mark */
+	start = reader->buffer.bytes.pointer + reader->buffer.position.token;
 	return lone_lisp_integer_parse(lone, start, end);
 
 error:
@@ -276,22 +358,16 @@ error:
 static struct lone_lisp_value lone_lisp_reader_consume_symbol(struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
 	unsigned char *start, *current;
-	size_t start_offset, end;
+	size_t end;
 
 	if (!lone_lisp_reader_peek(lone, reader)) { goto error; }
 
 	/* remember where the token starts as an offset into the buffer
-	   peeking may grow the buffer and move its backing storage
+	   peeking may compact or grow the buffer and move its contents
 	   thereby invalidating any pointer from before that call       */
-	start_offset = reader->buffer.position.read;
-	end = 0;
-
-	while ((current = lone_lisp_reader_peek(lone, reader)) &&
-	       !lone_lisp_reader_is_symbol_terminator(*current)) {
-
-		lone_lisp_reader_consume(reader);
-		++end;
-	}
+	lone_lisp_reader_mark(reader);
+	end = lone_lisp_reader_consume_run(lone, reader, lone_lisp_scan_symbol, false);
+	current = lone_lisp_reader_peek(lone, reader);
 
 	if (end == 0) { /* zero length symbols shouldn't occur normally */ goto error; }
 
@@ -300,9 +376,9 @@ static struct lone_lisp_value lone_lisp_reader_consume_symbol(struct lone_lisp *
 	if (current && !lone_lisp_reader_is_whitespace(*current)
 	            && !lone_lisp_reader_is_closing_bracket(*current)) { goto error; }
 
-	/* buffer may have been reallocated
-	   recalculate pointer from offset */
-	start = reader->buffer.bytes.pointer + start_offset;
+	/* buffer may have been compacted or reallocated
+	   recalculate pointer from the token mark */
+	start = reader->buffer.bytes.pointer + reader->buffer.position.token;
 	return lone_lisp_intern(lone, start, end, true);
 
 error:
@@ -344,21 +420,19 @@ static bool lone_lisp_reader_map_common_escape_sequence(unsigned char escape, un
 static size_t lone_lisp_reader_measure_quoted_content(
 		struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
-	unsigned char *current;
 	size_t length;
 
 	length = 0;
-	while ((current = lone_lisp_reader_peek_k(lone, reader, length)) &&
-	       *current != '"') {
+	while (lone_lisp_reader_find_quoted_delimiter(lone, reader, &length)) {
+		if (*lone_lisp_reader_peek_k(lone, reader, length) == '"') { return length; }
 
+		/* skip the backslash and the escaped character */
+		++length;
+		if (!lone_lisp_reader_peek_k(lone, reader, length)) { return 0; }
 		++length;
-		if (*current == '\\') {
-			if (!lone_lisp_reader_peek_k(lone, reader, length)) { return 0; }
-			++length;
-		}
 	}
 
-	return current? length : 0;
+	return 0;
 }
 
 static struct lone_bytes lone_lisp_reader_consume_text_content(
@@ -366,7 +440,7 @@ static struct lone_bytes lone_lisp_reader_consume_text_content(
 {
 	struct lone_unicode_utf8_encode_result encoded;
 	unsigned char *current, *output, character, hex_value;
-	size_t input_length, output_length, buffer_size, digits;
+	size_t input_length, output_length, buffer_size, digits, run;
 	lone_u32 code_point;
 	lone_u8 i;
 	struct lone_bytes result = LONE_BYTES_INIT_NULL();
@@ -427,8 +501,11 @@ static struct lone_bytes lone_lisp_reader_consume_text_content(
 			continue;
 		}
 
-		output[output_length++] = *current;
-		lone_lisp_reader_consume(reader);
+		run = lone_lisp_scan_quoted(current,
+				reader->buffer.position.write - reader->buffer.position.read);
+		lone_memory_move(current, output + output_length, run);
+		output_length += run;
+		lone_lisp_reader_consume_k(reader, run);
 	}
 
 	output[output_length] = '\0';
@@ -449,7 +526,7 @@ static struct lone_bytes lone_lisp_reader_consume_bytes_content(
 		struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
 	unsigned char *current, *output, character;
-	size_t input_length, output_length, buffer_size;
+	size_t input_length, output_length, buffer_size, run;
 	struct lone_bytes result = LONE_BYTES_INIT_NULL();
 
 	input_length = lone_lisp_reader_measure_quoted_content(lone, reader);
@@ -495,8 +572,11 @@ static struct lone_bytes lone_lisp_reader_consume_bytes_content(
 			continue;
 		}
 
-		output[output_length++] = *current;
-		lone_lisp_reader_consume(reader);
+		run = lone_lisp_scan_quoted(current,
+				reader->buffer.position.write - reader->buffer.position.read);
+		lone_memory_move(current, output + output_length, run);
+		output_length += run;
+		lone_lisp_reader_consume_k(reader, run);
 	}
 
 	output[output_length] = '\0';
@@ -513,10 +593,49 @@ error:
 	return result;
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Mapped input is kept alive by the values read from it,              │
+   │    so texts without escape sequences can be slices of it.              │
+   │    The mapping is unmapped once all of them are collected.             │
+   │    Like every slice they are not null terminated and are               │
+   │    copied when passed to system calls. Short texts are inline          │
+   │    values and anything else takes the copying path which also          │
+   │    reports syntax errors.                                              │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static bool lone_lisp_reader_consume_text_in_place(struct lone_lisp *lone,
+		struct lone_lisp_reader *reader, struct lone_lisp_value *text)
+{
+	struct lone_unicode_utf8_validation_result validation;
+	unsigned char *start, *current;
+	size_t length;
+
+	length = 0;
+	if (!lone_lisp_reader_find_quoted_delimiter(lone, reader, &length)) { return false; }
+
+	start = lone_lisp_reader_peek(lone, reader);
+	current = lone_lisp_reader_peek_k(lone, reader, length);
+
+	if (*current == '\\' || length <= LONE_LISP_INLINE_MAX_LENGTH) { return false; }
+
+	current = lone_lisp_reader_peek_k(lone, reader, length + 1);
+	if (current && !lone_lisp_reader_is_token_separator(*current)) { return false; }
+
+	validation = lone_unicode_utf8_validate(LONE_BYTES_VALUE(length, start));
+	if (!validation.valid) { return false; }
+
+	lone_lisp_reader_consume_k(reader, length + 1);
+
+	*text = lone_lisp_text_slice(lone, reader->buffer.mapping, start, length, validation.code_point_count);
+	return true;
+}
+
 static struct lone_lisp_value lone_lisp_reader_consume_text(struct lone_lisp *lone, struct lone_lisp_reader *reader)
 {
 	unsigned char *current;
 	struct lone_bytes content;
+	struct lone_lisp_value text;
 
 	current = lone_lisp_reader_peek(lone, reader);
 	if (!current || *current != '"') { goto error; }
@@ -524,6 +643,10 @@ static struct lone_lisp_value lone_lisp_reader_consume_text(struct lone_lisp *lo
 	/* skip leading " */
 	lone_lisp_reader_consume(reader);
 
+	if (!lone_lisp_is_nil(reader->buffer.mapping) && lone_lisp_reader_consume_text_in_place(lone, reader, &text)) {
+		return text;
+	}
+
 	content = lone_lisp_reader_consume_text_content(lone, reader);
 	if (!content.pointer) { goto error; }
 
@@ -641,9 +764,11 @@ static struct lone_lisp_value lone_lisp_lex(struct lone_lisp *lone, struct lone_
 	token = lone_lisp_nil();
 	found = false;
 
+	lone_lisp_reader_mark(reader);
+
 	while ((c = lone_lisp_reader_peek(lone, reader))) {
 		if (lone_lisp_reader_is_whitespace(*c)) {
-			lone_lisp_reader_consume(reader);
+			lone_lisp_reader_consume_run(lone, reader, lone_lisp_scan_whitespace, true);
 			continue;
 		} else {
 			found = true;
@@ -671,9 +796,7 @@ static struct lone_lisp_value lone_lisp_lex(struct lone_lisp *lone, struct lone_
 				break;
 			case ';':
 				/* comment: skip until end of line or end of input */
-				while ((c = lone_lisp_reader_peek(lone, reader)) && *c != '\n') {
-					lone_lisp_reader_consume(reader);
-				}
+				lone_lisp_reader_consume_run(lone, reader, lone_lisp_scan_line, true);
 				found = false;
 				continue;
 			case 'b':
@@ -878,6 +1001,15 @@ error:
 	return lone_lisp_nil();
 }
 
+/* Shares literal data with equal literals read earlier
+ * when the interpreter hash conses literals. */
+static struct lone_lisp_value lone_lisp_reader_literal(struct lone_lisp *lone,
+		struct lone_lisp_reader *reader, struct lone_lisp_value value)
+{
+	if (!lone->hash_cons.literals || reader->status.error) { return value; }
+	return lone_lisp_hash_cons(lone, value);
+}
+
 static struct lone_lisp_value lone_lisp_parse_special_character(struct lone_lisp *lone,
 		struct lone_lisp_reader *reader, char character)
 {
@@ -900,6 +1032,10 @@ static struct lone_lisp_value lone_lisp_parse_special_character(struct lone_lisp
 	symbol = lone_lisp_intern_c_string(lone, c_string);
 	value = lone_lisp_parse(lone, reader, lone_lisp_lex(lone, reader));
 
+	if (character == '\'') {
+		value = lone_lisp_reader_literal(lone, reader, value);
+	}
+
 	return lone_lisp_list_build(lone, 2, &symbol, &value);
 }
 
@@ -920,7 +1056,11 @@ static struct lone_lisp_value lone_lisp_parse(struct lone_lisp *lone,
 		return token;
 	case LONE_LISP_TAG_BYTES:
 	case LONE_LISP_TAG_TEXT:
-		return token;
+		return lone_lisp_reader_literal(lone, reader, token);
+	case LONE_LISP_TAG_PACKED_SYMBOL_8:
+	case LONE_LISP_TAG_PACKED_SYMBOL_9:
+	case LONE_LISP_TAG_PACKED_SYMBOL_10:
+	case LONE_LISP_TAG_PACKED_SYMBOL_11:
 	case LONE_LISP_TAG_SYMBOL:
 
 		name = lone_lisp_bytes_of(lone, &token);
@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/lisp/scan.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Chunks are loaded from arbitrarily aligned addresses.               │
+   │    Comparing a chunk against a byte yields a mask chunk whose          │
+   │    lanes are all ones where the bytes matched and zero elsewhere.      │
+   │    The mask is viewed as two little endian words whose trailing        │
+   │    zero bits count eight times the lanes before the first match.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+typedef unsigned char lone_lisp_scan_chunk __attribute__((vector_size(16), aligned(1)));
+typedef signed char lone_lisp_scan_mask __attribute__((vector_size(16)));
+typedef lone_u64 lone_lisp_scan_words __attribute__((vector_size(16)));
+
+#define LONE_LISP_SCAN_CHUNK_SIZE (sizeof(lone_lisp_scan_chunk))
+#define LONE_LISP_SCAN_PROLOGUE_SIZE 4
+
+static inline lone_lisp_scan_chunk lone_lisp_scan_load(unsigned char *bytes)
+{
+	return *((lone_lisp_scan_chunk *) bytes);
+}
+
+static inline bool lone_lisp_scan_first(lone_lisp_scan_mask mask, size_t *index)
+{
+	lone_lisp_scan_words words = (lone_lisp_scan_words) mask;
+
+	if (words[0]) { *index =     ((size_t) __builtin_ctzll(words[0]) / 8); return true; }
+	if (words[1]) { *index = 8 + ((size_t) __builtin_ctzll(words[1]) / 8); return true; }
+
+	return false;
+}
+
+static inline lone_lisp_scan_mask lone_lisp_scan_whitespace_mask(lone_lisp_scan_chunk chunk)
+{
+	return (chunk == ' ') | (chunk == '\t') | (chunk == '\n');
+}
+
+static inline bool lone_lisp_scan_is_whitespace(unsigned char byte)
+{
+	switch (byte) {
+	case ' ': case '\t': case '\n': return true;
+	default:                        return false;
+	}
+}
+
+static inline bool lone_lisp_scan_is_symbol(unsigned char byte)
+{
+	switch (byte) {
+	case ' ': case '\t': case '\n':
+	case '(': case '[': case '{':
+	case ')': case ']': case '}':
+	case ';': case '"':
+		return false;
+	default:
+		return true;
+	}
+}
+
+size_t lone_lisp_scan_whitespace(unsigned char *bytes, size_t count)
+{
+	size_t i, index;
+
+	/* most whitespace runs are single spaces between tokens */
+	for (i = 0; i < count && i < LONE_LISP_SCAN_PROLOGUE_SIZE; ++i) {
+		if (!lone_lisp_scan_is_whitespace(bytes[i])) { return i; }
+	}
+
+	for (/* i */; count - i >= LONE_LISP_SCAN_CHUNK_SIZE; i += LONE_LISP_SCAN_CHUNK_SIZE) {
+		if (lone_lisp_scan_first(~lone_lisp_scan_whitespace_mask(lone_lisp_scan_load(bytes + i)), &index)) {
+			return i + index;
+		}
+	}
+
+	while (i < count && lone_lisp_scan_is_whitespace(bytes[i])) { ++i; }
+
+	return i;
+}
+
+size_t lone_lisp_scan_symbol(unsigned char *bytes, size_t count)
+{
+	lone_lisp_scan_chunk chunk;
+	lone_lisp_scan_mask mask;
+	size_t i, index;
+
+	for (i = 0; count - i >= LONE_LISP_SCAN_CHUNK_SIZE; i += LONE_LISP_SCAN_CHUNK_SIZE) {
+		chunk = lone_lisp_scan_load(bytes + i);
+
+		mask = lone_lisp_scan_whitespace_mask(chunk)
+		     | (chunk == '(') | (chunk == '[') | (chunk == '{')
+		     | (chunk == ')') | (chunk == ']') | (chunk == '}')
+		     | (chunk == ';') | (chunk == '"');
+
+		if (lone_lisp_scan_first(mask, &index)) {
+			return i + index;
+		}
+	}
+
+	while (i < count && lone_lisp_scan_is_symbol(bytes[i])) { ++i; }
+
+	return i;
+}
+
+size_t lone_lisp_scan_line(unsigned char *bytes, size_t count)
+{
+	size_t i, index;
+
+	for (i = 0; count - i >= LONE_LISP_SCAN_CHUNK_SIZE; i += LONE_LISP_SCAN_CHUNK_SIZE) {
+		if (lone_lisp_scan_first(lone_lisp_scan_load(bytes + i) == '\n', &index)) {
+			return i + index;
+		}
+	}
+
+	while (i < count && bytes[i] != '\n') { ++i; }
+
+	return i;
+}
+
+size_t lone_lisp_scan_quoted(unsigned char *bytes, size_t count)
+{
+	lone_lisp_scan_chunk chunk;
+	size_t i, index;
+
+	for (i = 0; count - i >= LONE_LISP_SCAN_CHUNK_SIZE; i += LONE_LISP_SCAN_CHUNK_SIZE) {
+		chunk = lone_lisp_scan_load(bytes + i);
+
+		if (lone_lisp_scan_first((chunk == '"') | (chunk == '\\'), &index)) {
+			return i + index;
+		}
+	}
+
+	while (i < count && bytes[i] != '"' && bytes[i] != '\\') { ++i; }
+
+	return i;
+}
+
+size_t lone_lisp_scan_digits(unsigned char *bytes, size_t count)
+{
+	lone_lisp_scan_chunk chunk;
+	size_t i, index;
+
+	for (i = 0; count - i >= LONE_LISP_SCAN_CHUNK_SIZE; i += LONE_LISP_SCAN_CHUNK_SIZE) {
+		chunk = lone_lisp_scan_load(bytes + i);
+
+		if (lone_lisp_scan_first((chunk < '0') | (chunk > '9'), &index)) {
+			return i + index;
+		}
+	}
+
+	while (i < count && bytes[i] >= '0' && bytes[i] <= '9') { ++i; }
+
+	return i;
+}
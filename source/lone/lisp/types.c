@@ -39,7 +39,8 @@ enum lone_lisp_tag lone_lisp_type_of(struct lone_lisp_value value)
 	enum lone_lisp_tag tag = value.tagged & LONE_LISP_TAG_MASK;
 
 	/* normalize inline tags to their canonical heap type */
-	if ((tag & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_SYMBOL) {
+	if ((tag & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_SYMBOL
+	 || (tag & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_PACKED_SYMBOL) {
 		return LONE_LISP_TAG_SYMBOL;
 	}
 
@@ -196,7 +197,13 @@ bool lone_lisp_is_text(struct lone_lisp *lone, struct lone_lisp_value value)
 
 bool lone_lisp_is_inline_symbol(struct lone_lisp_value value)
 {
-	return (value.tagged & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_SYMBOL;
+	return (value.tagged & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_SYMBOL
+	    || lone_lisp_is_packed_symbol(value);
+}
+
+bool lone_lisp_is_packed_symbol(struct lone_lisp_value value)
+{
+	return (value.tagged & LONE_LISP_INLINE_TYPE_MASK) == LONE_LISP_INLINE_TYPE_PACKED_SYMBOL;
 }
 
 bool lone_lisp_is_inline_text(struct lone_lisp_value value)
@@ -255,6 +262,93 @@ struct lone_lisp_value lone_lisp_inline_symbol_create(unsigned char *bytes, size
 	return lone_lisp_inline_create(LONE_LISP_INLINE_TYPE_SYMBOL, bytes, count);
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Packed symbol alphabet.                                             │
+   │                                                                        │
+   │    The first 32 characters are the 5 bit alphabet:                     │
+   │    lowercase letters and the punctuation most often found              │
+   │    in lisp identifiers. The 6 bit alphabet extends it with             │
+   │    digits and the remaining operator characters.                       │
+   │    Uppercase letters are rare in lisp identifiers and                  │
+   │    are left out. Codes past the end of the alphabet                    │
+   │    are never produced.                                                 │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static const unsigned char lone_lisp_packed_symbol_alphabet[] =
+	"abcdefghijklmnopqrstuvwxyz-?!*+:"
+	"0123456789/<=>_%&$^~@#|";
+
+/* Character code plus one, zero for characters outside the alphabet. */
+static const unsigned char lone_lisp_packed_symbol_codes[128] = {
+	['a'] =  1, ['b'] =  2, ['c'] =  3, ['d'] =  4, ['e'] =  5, ['f'] =  6,
+	['g'] =  7, ['h'] =  8, ['i'] =  9, ['j'] = 10, ['k'] = 11, ['l'] = 12,
+	['m'] = 13, ['n'] = 14, ['o'] = 15, ['p'] = 16, ['q'] = 17, ['r'] = 18,
+	['s'] = 19, ['t'] = 20, ['u'] = 21, ['v'] = 22, ['w'] = 23, ['x'] = 24,
+	['y'] = 25, ['z'] = 26, ['-'] = 27, ['?'] = 28, ['!'] = 29, ['*'] = 30,
+	['+'] = 31, [':'] = 32,
+
+	['0'] = 33, ['1'] = 34, ['2'] = 35, ['3'] = 36, ['4'] = 37, ['5'] = 38,
+	['6'] = 39, ['7'] = 40, ['8'] = 41, ['9'] = 42, ['/'] = 43, ['<'] = 44,
+	['='] = 45, ['>'] = 46, ['_'] = 47, ['%'] = 48, ['&'] = 49, ['$'] = 50,
+	['^'] = 51, ['~'] = 52, ['@'] = 53, ['#'] = 54, ['|'] = 55,
+};
+
+static size_t lone_lisp_packed_symbol_width(size_t count)
+{
+	return count <= LONE_LISP_PACKED_SYMBOL_WIDE_LENGTH?
+		LONE_LISP_PACKED_SYMBOL_WIDE_BITS : LONE_LISP_PACKED_SYMBOL_NARROW_BITS;
+}
+
+bool lone_lisp_packed_symbol_create(unsigned char *bytes, size_t count, struct lone_lisp_value *symbol)
+{
+	size_t i, width;
+	unsigned long code;
+	long tagged;
+
+	if (count < LONE_LISP_PACKED_SYMBOL_MIN_LENGTH || count > LONE_LISP_PACKED_SYMBOL_MAX_LENGTH) {
+		return false;
+	}
+
+	width  = lone_lisp_packed_symbol_width(count);
+	tagged = LONE_LISP_INLINE_TYPE_PACKED_SYMBOL
+	       | (long) ((count - LONE_LISP_PACKED_SYMBOL_MIN_LENGTH) << LONE_LISP_INLINE_LENGTH_SHIFT);
+
+	for (i = 0; i < count; ++i) {
+		if (bytes[i] >= sizeof(lone_lisp_packed_symbol_codes)) { return false; }
+		code = lone_lisp_packed_symbol_codes[bytes[i]];
+		if (code == 0 || code > (1UL << width)) { return false; }
+		tagged |= (long) ((code - 1) << (LONE_LISP_DATA_SHIFT + i * width));
+	}
+
+	*symbol = (struct lone_lisp_value) { .tagged = tagged };
+	return true;
+}
+
+static struct lone_bytes lone_lisp_packed_symbol_bytes(struct lone_lisp *lone, struct lone_lisp_value value)
+{
+	unsigned char *buffer;
+	size_t i, count, width;
+	unsigned long data, mask;
+
+	count  = ((value.tagged >> LONE_LISP_INLINE_LENGTH_SHIFT) & LONE_LISP_INLINE_LENGTH_MASK)
+	       + LONE_LISP_PACKED_SYMBOL_MIN_LENGTH;
+	width  = lone_lisp_packed_symbol_width(count);
+	mask   = (1UL << width) - 1;
+	data   = ((unsigned long) value.tagged) >> LONE_LISP_DATA_SHIFT;
+
+	buffer = lone->symbols.packed.buffers[lone->symbols.packed.next];
+	lone->symbols.packed.next = (lone->symbols.packed.next + 1) % LONE_LISP_PACKED_SYMBOL_BUFFERS;
+
+	for (i = 0; i < count; ++i) {
+		buffer[i] = lone_lisp_packed_symbol_alphabet[(data >> (i * width)) & mask];
+	}
+	buffer[count] = '\0';
+
+	return (struct lone_bytes) { .count = count, .pointer = buffer };
+}
+
 struct lone_lisp_value lone_lisp_inline_text_create(unsigned char *bytes, size_t count)
 {
 	return lone_lisp_inline_create(LONE_LISP_INLINE_TYPE_TEXT, bytes, count);
@@ -273,10 +367,14 @@ bool lone_lisp_is_identical(struct lone_lisp *lone, struct lone_lisp_value x, st
 
 bool lone_lisp_is_frozen(struct lone_lisp *lone, struct lone_lisp_value value)
 {
+	struct lone_lisp_heap_value *actual;
+
 	if (lone_lisp_is_inline_bytes(value)) { return true; }
 
 	if (lone_lisp_type_of(value) == LONE_LISP_TAG_BYTES) {
-		return lone_lisp_heap_value_of(lone, value)->frozen;
+		actual = lone_lisp_heap_value_of(lone, value);
+		/* the parent may have been frozen after slicing */
+		return actual->frozen || (actual->slice && lone_lisp_is_frozen(lone, actual->as.bytes.parent));
 	}
 
 	if (lone_lisp_is_vector(lone, value)) { return false; }
@@ -289,6 +387,10 @@ struct lone_bytes lone_lisp_bytes_of(struct lone_lisp *lone, struct lone_lisp_va
 {
 	struct lone_lisp_heap_value *heap_value;
 
+	if (lone_lisp_is_packed_symbol(*value)) {
+		return lone_lisp_packed_symbol_bytes(lone, *value);
+	}
+
 	if (lone_lisp_is_inline_value(*value)) {
 		return lone_lisp_inline_value_bytes(value);
 	}
@@ -5,6 +5,9 @@
 #include <lone/lisp/utilities.h>
 
 #include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
+
+#include <lone/linux.h>
 
 struct lone_lisp_value lone_lisp_bytes_transfer(struct lone_lisp *lone,
 		unsigned char *pointer, size_t count,
@@ -45,3 +48,140 @@ struct lone_lisp_value lone_lisp_bytes_create(struct lone_lisp *lone, size_t cou
 	unsigned char *pointer = lone_memory_allocate(lone->system, count + 1, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
 	return lone_lisp_bytes_transfer(lone, pointer, count, true);
 }
+
+struct lone_lisp_value lone_lisp_bytes_slice(struct lone_lisp *lone,
+		struct lone_lisp_value bytes, size_t start, size_t count)
+{
+	struct lone_lisp_heap_value *actual, *parent;
+	struct lone_lisp_value root;
+	unsigned char *pointer;
+	bool frozen;
+
+	pointer = lone_lisp_bytes_of(lone, &bytes).pointer + start;
+
+	if (count <= LONE_LISP_INLINE_MAX_LENGTH) {
+		/* also covers every slice of inline bytes */
+		return lone_lisp_inline_bytes_create(pointer, count);
+	}
+
+	parent = lone_lisp_heap_value_of(lone, bytes);
+	root = parent->slice? parent->as.bytes.parent : bytes;
+	frozen = lone_lisp_is_frozen(lone, bytes);
+
+	actual = lone_lisp_heap_allocate_value(lone);
+	actual->slice = true;
+	actual->frozen = frozen;
+	actual->as.bytes.parent = root;
+
+	return lone_lisp_buffer_transfer(lone, actual, &actual->as.bytes.data,
+			pointer, count, false, LONE_LISP_TAG_BYTES);
+}
+
+struct lone_lisp_value lone_lisp_bytes_map(struct lone_lisp *lone,
+		void *mapping, size_t count, bool frozen)
+{
+	struct lone_lisp_heap_value *actual;
+
+	/* never inline: the mapping may be shared and must be unmapped */
+	actual = lone_lisp_heap_allocate_value(lone);
+	actual->mapped = true;
+	actual->frozen = frozen;
+
+	return lone_lisp_buffer_transfer(lone, actual, &actual->as.bytes.data,
+			mapping, count, false, LONE_LISP_TAG_BYTES);
+}
+
+/* Mappings are one byte longer than the bytes so that they are null
+ * terminated like allocated bytes. Files are mapped over zero filled
+ * anonymous memory so that the terminator exists even when their size
+ * is a multiple of the page size. The bytes past the end of the file
+ * in its last page are zero unless the file grows while mapped.
+ * Errors are returned as negative integers. */
+struct lone_lisp_value lone_lisp_bytes_mmap(struct lone_lisp *lone,
+		size_t count, int protection, int flags, int fd, bool frozen)
+{
+	intptr_t mapping, file;
+
+	if (fd < 0) {
+		mapping = linux_mmap(0, count + 1, protection, flags, -1, 0);
+		if (mapping < 0) { return lone_lisp_integer_create(mapping); }
+	} else {
+		mapping = linux_mmap(0, count + 1, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping < 0) { return lone_lisp_integer_create(mapping); }
+
+		file = linux_mmap((void *) mapping, count, protection, flags | MAP_FIXED, fd, 0);
+
+		if (file < 0) {
+			linux_munmap((void *) mapping, count + 1);
+			return lone_lisp_integer_create(file);
+		}
+	}
+
+	return lone_lisp_bytes_map(lone, (void *) mapping, count, frozen);
+}
+
+struct lone_lisp_value lone_lisp_bytes_descriptor(struct lone_lisp *lone, int file_descriptor)
+{
+	struct lone_lisp_value bytes;
+
+	/* owned buffers are never inline */
+	bytes = lone_lisp_bytes_create(lone, sizeof(file_descriptor));
+	lone_memory_move(&file_descriptor,
+			lone_lisp_heap_value_of(lone, bytes)->as.bytes.data.pointer, sizeof(file_descriptor));
+	lone_lisp_heap_value_of(lone, bytes)->descriptor = true;
+
+	return bytes;
+}
+
+int lone_lisp_bytes_descriptor_of(struct lone_lisp *lone, struct lone_lisp_value bytes)
+{
+	int file_descriptor;
+
+	lone_memory_move(lone_lisp_heap_value_of(lone, bytes)->as.bytes.data.pointer,
+			&file_descriptor, sizeof(file_descriptor));
+
+	return file_descriptor;
+}
+
+void lone_lisp_bytes_descriptor_close(struct lone_lisp *lone, struct lone_lisp_value bytes)
+{
+	struct lone_lisp_heap_value *actual;
+
+	actual = lone_lisp_heap_value_of(lone, bytes);
+	if (!actual->descriptor) { return; }
+
+	actual->descriptor = false;
+	linux_close(lone_lisp_bytes_descriptor_of(lone, bytes));
+}
+
+void lone_lisp_slice_detach(struct lone_lisp *lone, struct lone_lisp_value slice)
+{
+	struct lone_lisp_heap_value *actual;
+	struct lone_bytes *bytes;
+	unsigned char *copy;
+
+	actual = lone_lisp_heap_value_of(lone, slice);
+
+	if (!actual->slice) { return; }
+
+	switch (actual->type) {
+	case LONE_LISP_TAG_BYTES:
+		bytes = &actual->as.bytes.data;
+		actual->as.bytes.parent = lone_lisp_nil();
+		break;
+	case LONE_LISP_TAG_TEXT:
+		bytes = &actual->as.text.bytes;
+		actual->as.text.parent = lone_lisp_nil();
+		break;
+	default:
+		linux_exit(-1);
+	}
+
+	copy = lone_memory_allocate(lone->system, bytes->count + 1, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+	lone_memory_move(bytes->pointer, copy, bytes->count);
+	copy[bytes->count] = '\0';
+
+	bytes->pointer = copy;
+	actual->should_deallocate_bytes = true;
+	actual->slice = false;
+}
@@ -20,14 +20,48 @@ struct lone_lisp_value lone_lisp_integer_from_pointer(void *pointer)
 	return lone_lisp_integer_create((intptr_t) pointer);
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Digits are parsed eight at a time when possible. Eight ASCII        │
+   │    digits loaded as a little endian word are combined pairwise         │
+   │    into four two digit numbers, then into two four digit numbers       │
+   │    and finally into one eight digit number with a multiplication       │
+   │    at each step rather than a multiplication per digit.                │
+   │                                                                        │
+   │    The magnitude is accumulated unsigned so that the most negative     │
+   │    integer can be parsed. Nineteen digits always fit in 64 bits so     │
+   │    overflow is only checked for longer runs, which are still valid     │
+   │    when they begin with enough zeros. Runs shorter than eight          │
+   │    digits are the common case and go straight to the digit loop.       │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static lone_u64 lone_lisp_integer_parse_eight_digits(unsigned char *digits)
+{
+	lone_u64 word;
+
+	__builtin_memcpy(&word, digits, sizeof(word));
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	word = __builtin_bswap64(word);
+#endif
+
+	word -= 0x3030303030303030ULL;
+	word = (word * 10) + (word >> 8);
+	word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+	     + (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+
+	return word;
+}
+
 struct lone_lisp_value lone_lisp_integer_parse(struct lone_lisp *lone, unsigned char *digits, size_t count)
 {
+	lone_u64 magnitude, limit;
 	size_t i;
-	long integer, digit;
 	bool negative;
 
 	i = 0;
-	integer = 0;
+	magnitude = 0;
 	negative = false;
 
 	switch (*digits) {
@@ -39,19 +73,129 @@ struct lone_lisp_value lone_lisp_integer_parse(struct lone_lisp *lone, unsigned
 		break;
 	}
 
-	while (i < count) {
-		digit = digits[i++] - '0';
-		if (negative) { digit = -digit; }
-		if (__builtin_mul_overflow(integer, 10, &integer)) { goto overflow; }
-		if (__builtin_add_overflow(integer, digit, &integer)) { goto overflow; }
+	if (count - i < 8) {
+		for (/* i */; i < count; ++i) {
+			magnitude = magnitude * 10 + (lone_u64) (digits[i] - '0');
+		}
+	} else if (count - i > 19) {
+		for (/* i */; count - i >= 8; i += 8) {
+			if (__builtin_mul_overflow(magnitude, (lone_u64) 100000000, &magnitude)) { goto overflow; }
+			if (__builtin_add_overflow(magnitude, lone_lisp_integer_parse_eight_digits(digits + i), &magnitude)) { goto overflow; }
+		}
+
+		for (/* i */; i < count; ++i) {
+			if (__builtin_mul_overflow(magnitude, (lone_u64) 10, &magnitude)) { goto overflow; }
+			if (__builtin_add_overflow(magnitude, (lone_u64) (digits[i] - '0'), &magnitude)) { goto overflow; }
+		}
+	} else {
+		for (/* i */; count - i >= 8; i += 8) {
+			magnitude = magnitude * 100000000 + lone_lisp_integer_parse_eight_digits(digits + i);
+		}
+
+		for (/* i */; i < count; ++i) {
+			magnitude = magnitude * 10 + (lone_u64) (digits[i] - '0');
+		}
 	}
 
-	return lone_lisp_integer_create(integer);
+	limit = negative? (lone_u64) LONE_LISP_INTEGER_MAX + 1 : (lone_u64) LONE_LISP_INTEGER_MAX;
+	if (magnitude > limit) { goto overflow; }
+
+	return lone_lisp_integer_create(negative? (lone_lisp_integer) -magnitude : (lone_lisp_integer) magnitude);
 
 overflow:
 	linux_exit(-1);
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Decimal formatting first computes the number of digits and then     │
+   │    writes them backwards two at a time from a table of all pairs,      │
+   │    halving the number of divisions compared to one per digit.          │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static const char lone_lisp_integer_digit_pairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static size_t lone_lisp_integer_decimal_digit_count(lone_u64 magnitude)
+{
+	size_t count;
+
+	for (count = 1; magnitude >= 10000; magnitude /= 10000, count += 4);
+
+	if (magnitude >= 1000) { return count + 3; }
+	if (magnitude >= 100)  { return count + 2; }
+	if (magnitude >= 10)   { return count + 1; }
+	return count;
+}
+
+static lone_u64 lone_lisp_integer_magnitude(lone_lisp_integer integer)
+{
+	return integer < 0? -((lone_u64) integer) : (lone_u64) integer;
+}
+
+size_t lone_lisp_integer_format_decimal(lone_lisp_integer integer, unsigned char *buffer)
+{
+	lone_u64 magnitude, pair;
+	size_t count, sign;
+	unsigned char *digit;
+
+	magnitude = lone_lisp_integer_magnitude(integer);
+	sign = integer < 0? 1 : 0;
+	count = sign + lone_lisp_integer_decimal_digit_count(magnitude);
+	digit = buffer + count;
+
+	while (magnitude >= 100) {
+		pair = (magnitude % 100) * 2;
+		magnitude /= 100;
+		*--digit = lone_lisp_integer_digit_pairs[pair + 1];
+		*--digit = lone_lisp_integer_digit_pairs[pair];
+	}
+
+	if (magnitude >= 10) {
+		pair = magnitude * 2;
+		*--digit = lone_lisp_integer_digit_pairs[pair + 1];
+		*--digit = lone_lisp_integer_digit_pairs[pair];
+	} else {
+		*--digit = '0' + magnitude;
+	}
+
+	if (sign) { *--digit = '-'; }
+
+	return count;
+}
+
+size_t lone_lisp_integer_format_hexadecimal(lone_lisp_integer integer, unsigned char *buffer)
+{
+	static const char hex[] = "0123456789abcdef";
+	lone_u64 magnitude;
+	size_t count, sign;
+	unsigned char *digit;
+
+	magnitude = lone_lisp_integer_magnitude(integer);
+	sign = integer < 0? 1 : 0;
+	count = sign + (magnitude? (64 - (size_t) __builtin_clzll(magnitude) + 3) / 4 : 1);
+	digit = buffer + count;
+
+	do {
+		*--digit = hex[magnitude & 0xF];
+		magnitude >>= 4;
+	} while (magnitude);
+
+	if (sign) { *--digit = '-'; }
+
+	return count;
+}
+
 struct lone_lisp_value lone_lisp_zero(void)
 {
 	return lone_lisp_integer_create(0);
@@ -7,17 +7,22 @@ struct lone_lisp_value lone_lisp_primitive_create(struct lone_lisp *lone,
 		char *name, lone_lisp_primitive_function function,
 		struct lone_lisp_value closure, struct lone_lisp_function_flags flags)
 {
-	struct lone_lisp_heap_value *actual;
-	struct lone_lisp_value interned_name, value;
-
 	/* intern the name before allocating the heap value
 	   interning transitively calls heap_allocate_value
 	   which may grow the heap and invalidate pointers  */
-	interned_name = lone_lisp_intern_c_string(lone, name);
+	return lone_lisp_primitive_create_named(lone, lone_lisp_intern_c_string(lone, name), function, closure, flags);
+}
+
+struct lone_lisp_value lone_lisp_primitive_create_named(struct lone_lisp *lone,
+		struct lone_lisp_value name, lone_lisp_primitive_function function,
+		struct lone_lisp_value closure, struct lone_lisp_function_flags flags)
+{
+	struct lone_lisp_heap_value *actual;
+	struct lone_lisp_value value;
 
 	actual = lone_lisp_heap_allocate_value(lone);
 
-	actual->as.primitive.name     = interned_name;
+	actual->as.primitive.name     = name;
 	actual->as.primitive.function = function;
 	actual->as.primitive.closure  = closure;
 	actual->as.primitive.flags    = flags;
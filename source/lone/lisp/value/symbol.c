@@ -3,14 +3,15 @@
 #include <lone/lisp/types.h>
 #include <lone/lisp/heap.h>
 #include <lone/lisp/hash.h>
+#include <lone/lisp/names.h>
 
 #include <lone/memory/allocator.h>
 #include <lone/memory/functions.h>
 
-static struct lone_lisp_value lone_lisp_symbol_transfer(struct lone_lisp *lone,
+static struct lone_lisp_value lone_lisp_symbol_initialize(struct lone_lisp *lone,
+		struct lone_lisp_heap_value *actual,
 		unsigned char *text, size_t length, bool should_deallocate)
 {
-	struct lone_lisp_heap_value *actual = lone_lisp_heap_allocate_value(lone);
 	struct lone_lisp_value value;
 	lone_hash hash;
 
@@ -36,6 +37,12 @@ static struct lone_lisp_value lone_lisp_symbol_transfer(struct lone_lisp *lone,
 	return value;
 }
 
+static struct lone_lisp_value lone_lisp_symbol_transfer(struct lone_lisp *lone,
+		unsigned char *text, size_t length, bool should_deallocate)
+{
+	return lone_lisp_symbol_initialize(lone, lone_lisp_heap_allocate_value(lone), text, length, should_deallocate);
+}
+
 static struct lone_lisp_value lone_lisp_symbol_transfer_bytes(struct lone_lisp *lone,
 		struct lone_bytes bytes, bool should_deallocate)
 {
@@ -45,10 +52,13 @@ static struct lone_lisp_value lone_lisp_symbol_transfer_bytes(struct lone_lisp *
 static struct lone_lisp_value lone_lisp_symbol_copy(struct lone_lisp *lone,
 		unsigned char *text, size_t length)
 {
-	unsigned char *copy = lone_memory_allocate(lone->system, length + 1, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
-	lone_memory_move(text, copy, length);
-	copy[length] = '\0';
-	return lone_lisp_symbol_transfer(lone, copy, length, true);
+	struct lone_lisp_heap_value *actual;
+	unsigned char *copy;
+
+	actual = lone_lisp_heap_allocate_value(lone);
+	copy   = lone_lisp_names_store(lone, actual - lone->heap.values, text, length);
+
+	return lone_lisp_symbol_initialize(lone, actual, copy, length, false);
 }
 
 struct lone_lisp_value lone_lisp_intern(struct lone_lisp *lone,
@@ -61,6 +71,10 @@ struct lone_lisp_value lone_lisp_intern(struct lone_lisp *lone,
 		return lone_lisp_inline_symbol_create(bytes, count);
 	}
 
+	if (lone_lisp_packed_symbol_create(bytes, count, &value)) {
+		return value;
+	}
+
 	value = lone_lisp_table_get_by_symbol(lone, lone->symbol_table, name);
 
 	if (lone_lisp_is_nil(value)) {
@@ -108,6 +108,22 @@ struct lone_lisp_value lone_lisp_table_create_from_shape(struct lone_lisp *lone,
 	return lone_lisp_value_from_heap_value(lone, heap_value, LONE_LISP_TAG_TABLE);
 }
 
+struct lone_lisp_value lone_lisp_table_create_weak(struct lone_lisp *lone,
+		size_t capacity, struct lone_lisp_value prototype,
+		bool weak_keys, bool weak_values)
+{
+	struct lone_lisp_heap_value *heap_value;
+	struct lone_lisp_value table;
+
+	table      = lone_lisp_table_create(lone, capacity, prototype);
+	heap_value = lone_lisp_heap_value_of(lone, table);
+
+	heap_value->weak_keys   = weak_keys;
+	heap_value->weak_values = weak_values;
+
+	return table;
+}
+
 static bool lone_lisp_table_is_shaped(struct lone_lisp *lone, struct lone_lisp_value table)
 {
 	return lone_lisp_heap_value_of(lone, table)->shaped;
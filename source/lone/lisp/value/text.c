@@ -74,6 +74,31 @@ struct lone_lisp_value lone_lisp_text_copy(struct lone_lisp *lone, unsigned char
 			text, length, LONE_LISP_TAG_TEXT);
 }
 
+struct lone_lisp_value lone_lisp_text_slice(struct lone_lisp *lone,
+		struct lone_lisp_value text, unsigned char *start, size_t length,
+		size_t code_point_count)
+{
+	struct lone_lisp_heap_value *actual, *parent;
+	struct lone_lisp_value root;
+
+	if (length <= LONE_LISP_INLINE_MAX_LENGTH) {
+		/* also covers every slice of inline text */
+		return lone_lisp_inline_text_create(start, length);
+	}
+
+	parent = lone_lisp_heap_value_of(lone, text);
+	root = parent->slice? parent->as.text.parent : text;
+
+	actual = lone_lisp_heap_allocate_value(lone);
+	actual->slice = true;
+	actual->as.text.parent = root;
+	actual->as.text.code_point_count = code_point_count;
+	actual->code_point_count_cached = true;
+
+	return lone_lisp_buffer_transfer(lone, actual, &actual->as.text.bytes,
+			start, length, false, LONE_LISP_TAG_TEXT);
+}
+
 struct lone_lisp_value lone_lisp_text_from_c_string(struct lone_lisp *lone, char *c_string)
 {
 	return lone_lisp_text_transfer(lone, (unsigned char *) c_string, lone_c_string_length(c_string), false);
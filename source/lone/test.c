@@ -1,7 +1,9 @@
 /* SPDX-License-Identifier: AGPL-3.0-or-later */
 
 #include <lone/test.h>
+#include <lone/definitions.h>
 #include <lone/linux.h>
+#include <lone/memory/functions.h>
 
 static enum lone_test_result lone_test_result_for(bool passed)
 {
@@ -289,3 +291,47 @@ void lone_test_suite_default_test_finished_handler(struct lone_test_suite *suite
 	linux_write_bytes(1, result);
 	LINUX_WRITE_LITERAL(1, "\n");
 }
+
+lone_u64 lone_test_benchmark_nanoseconds(void)
+{
+	struct __kernel_timespec time;
+
+	if (linux_clock_gettime(CLOCK_MONOTONIC, &time) < 0) { return 0; }
+
+	return (lone_u64) time.tv_sec * 1000000000 + (lone_u64) time.tv_nsec;
+}
+
+static void lone_test_write_decimal(lone_u64 n)
+{
+	unsigned char digits[LONE_DECIMAL_DIGITS_PER_LONG];
+	size_t i = sizeof(digits);
+
+	do {
+		digits[--i] = '0' + (n % 10);
+		n /= 10;
+	} while (n);
+
+	linux_write(1, digits + i, sizeof(digits) - i);
+}
+
+static void lone_test_write_c_string(char *c_string)
+{
+	linux_write(1, c_string, lone_c_string_length(c_string));
+}
+
+void lone_test_benchmark_report(char *name, char *method, lone_u64 elapsed, lone_u64 amount, char *unit)
+{
+	if (elapsed == 0) { elapsed = 1; }
+
+	LINUX_WRITE_LITERAL(1, "\tBENCHMARK ");
+	lone_test_write_c_string(name);
+	LINUX_WRITE_LITERAL(1, " ");
+	lone_test_write_c_string(method);
+	LINUX_WRITE_LITERAL(1, " ");
+	lone_test_write_decimal(elapsed / 1000);
+	LINUX_WRITE_LITERAL(1, " us ");
+	lone_test_write_decimal((amount * 1000) / elapsed);
+	LINUX_WRITE_LITERAL(1, " ");
+	lone_test_write_c_string(unit);
+	LINUX_WRITE_LITERAL(1, "/s\n");
+}
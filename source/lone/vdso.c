@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/vdso.h>
+#include <lone/auxiliary_vector.h>
+#include <lone/memory/functions.h>
+
+#ifndef DT_GNU_HASH
+	#define DT_GNU_HASH 0x6ffffef5
+#endif
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    The number of dynamic symbols is not recorded anywhere directly.    │
+   │    The classic hash table's chain has exactly one entry per symbol.    │
+   │    The GNU hash table only chains the hashed symbols: the last one     │
+   │    is found by following the chain of the highest bucket until the     │
+   │    entry whose lowest bit marks the end of the chain.                  │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+static size_t lone_vdso_gnu_hash_symbol_count(lone_u32 *table)
+{
+	lone_u32 bucket_count, symbol_offset, bloom_size, *buckets, *chain, last;
+	size_t i;
+
+	bucket_count  = table[0];
+	symbol_offset = table[1];
+	bloom_size    = table[2];
+
+	buckets = table + 4 + bloom_size * (sizeof(long) / sizeof(lone_u32));
+	chain = buckets + bucket_count;
+
+	for (i = 0, last = 0; i < bucket_count; ++i) {
+		if (buckets[i] > last) { last = buckets[i]; }
+	}
+
+	if (last < symbol_offset) { return symbol_offset; }
+
+	while (!(chain[last - symbol_offset] & 1)) { ++last; }
+
+	return (size_t) last + 1;
+}
+
+void *lone_vdso_symbol(lone_elf_native_header *header, char *name)
+{
+	lone_elf_native_segment *segments;
+	lone_elf_native_dynamic *dynamic;
+	lone_elf_native_symbol *symbols;
+	lone_u32 *hash, *gnu_hash;
+	unsigned char *base;
+	char *strings, *symbol;
+	size_t i, count, length;
+	bool has_bias;
+
+	if (!header || !lone_elf_header_ident_has_valid_magic_numbers((struct lone_elf_header *) header)) {
+		return 0;
+	}
+
+	segments = (lone_elf_native_segment *) (((unsigned char *) header) + header->e_phoff);
+	base = 0;
+	dynamic = 0;
+	has_bias = false;
+
+	/* the image is mapped as a whole, its addresses are relative to the first loaded segment */
+	for (i = 0; i < header->e_phnum; ++i) {
+		if (segments[i].p_type == PT_LOAD && !has_bias) {
+			base = ((unsigned char *) header) + segments[i].p_offset - segments[i].p_vaddr;
+			has_bias = true;
+		}
+	}
+
+	if (!has_bias) { return 0; }
+
+	for (i = 0; i < header->e_phnum; ++i) {
+		if (segments[i].p_type == PT_DYNAMIC) {
+			dynamic = (lone_elf_native_dynamic *) (base + segments[i].p_vaddr);
+		}
+	}
+
+	if (!dynamic) { return 0; }
+
+	symbols = 0;
+	strings = 0;
+	hash = gnu_hash = 0;
+
+	for (; dynamic->d_tag != DT_NULL; ++dynamic) {
+		switch (dynamic->d_tag) {
+		case DT_SYMTAB:   symbols  = (lone_elf_native_symbol *) (base + dynamic->d_un.d_ptr); break;
+		case DT_STRTAB:   strings  = (char *)                   (base + dynamic->d_un.d_ptr); break;
+		case DT_HASH:     hash     = (lone_u32 *)               (base + dynamic->d_un.d_ptr); break;
+		case DT_GNU_HASH: gnu_hash = (lone_u32 *)               (base + dynamic->d_un.d_ptr); break;
+		default:          break;
+		}
+	}
+
+	if (!symbols || !strings) { return 0; }
+
+	if (hash) {
+		count = hash[1];
+	} else if (gnu_hash) {
+		count = lone_vdso_gnu_hash_symbol_count(gnu_hash);
+	} else {
+		return 0;
+	}
+
+	length = lone_c_string_length(name);
+
+	/* the vDSO only exports a handful of symbols, a linear search is enough */
+	for (i = 0; i < count; ++i) {
+		if (symbols[i].st_shndx == SHN_UNDEF) { continue; }
+		if (ELF_ST_TYPE(symbols[i].st_info) != STT_FUNC) { continue; }
+
+		symbol = strings + symbols[i].st_name;
+
+		if (lone_memory_is_equal(symbol, name, length + 1)) {
+			return base + symbols[i].st_value;
+		}
+	}
+
+	return 0;
+}
+
+void lone_vdso_initialize(struct lone_vdso *vdso, struct lone_auxiliary_vector *auxiliary_vector)
+{
+	lone_elf_native_header *header;
+	void *symbol;
+
+	vdso->clock_gettime = 0;
+	vdso->gettimeofday = 0;
+	vdso->getcpu = 0;
+
+#if __BITS_PER_LONG == 64
+	/* the 32 bit vDSO functions use the old time structures */
+
+	header = lone_auxiliary_vector_value(auxiliary_vector, AT_SYSINFO_EHDR).as.pointer;
+
+	symbol = lone_vdso_symbol(header, "__vdso_clock_gettime");
+	if (!symbol) { symbol = lone_vdso_symbol(header, "__kernel_clock_gettime"); }
+	vdso->clock_gettime = (lone_vdso_clock_gettime_function) (uintptr_t) symbol;
+
+	symbol = lone_vdso_symbol(header, "__vdso_gettimeofday");
+	if (!symbol) { symbol = lone_vdso_symbol(header, "__kernel_gettimeofday"); }
+	vdso->gettimeofday = (lone_vdso_gettimeofday_function) (uintptr_t) symbol;
+
+	symbol = lone_vdso_symbol(header, "__vdso_getcpu");
+	if (!symbol) { symbol = lone_vdso_symbol(header, "__kernel_getcpu"); }
+	vdso->getcpu = (lone_vdso_getcpu_function) (uintptr_t) symbol;
+#else
+	(void) header;
+	(void) symbol;
+	(void) auxiliary_vector;
+#endif
+}
@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/memory/functions.h>
+#include <lone/system.h>
+#include <lone/hash/siphash.h>
+#include <lone/lisp.h>
+#include <lone/lisp/hash.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Hashing throughput for symbol, text and bytes keys.                 │
+   │                                                                        │
+   │    Every key length is hashed through the interpreter's entry          │
+   │    points, which use the precomputed key state and the single shot     │
+   │    fast path, and through a freshly keyed incremental state fed        │
+   │    the tag byte and then the data, which is how every hash used to     │
+   │    be computed. Both must agree. Timings are reported as extra         │
+   │    lines in the test output for the harness to pass through.           │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define BENCHMARK_ITERATIONS 20000
+
+struct benchmark_context {
+	struct lone_lisp *lone;
+};
+
+typedef lone_hash (*benchmark_hash_function)(struct lone_lisp *lone, struct lone_bytes data);
+
+static const size_t benchmark_lengths[] = { 8, 16, 32, 64 };
+
+/* name/length, as reported */
+static void benchmark_label(char *label, char *name, size_t length)
+{
+	size_t count;
+
+	count = lone_c_string_length(name);
+	lone_memory_move(name, label, count);
+	label[count++] = '/';
+	count += lone_lisp_integer_format_decimal((lone_lisp_integer) length, (unsigned char *) label + count);
+	label[count] = '\0';
+}
+
+static lone_hash benchmark_hash_incremental(struct lone_lisp *lone,
+		enum lone_lisp_tag tag, struct lone_bytes data)
+{
+	struct lone_hash_siphash_state state;
+	struct lone_bytes prefix;
+	lone_u64 k0, k1;
+
+	k0 = lone_u64le_read(lone->system->random);
+	k1 = lone_u64le_read(lone->system->random + 8);
+
+	prefix.pointer = (unsigned char *) &tag;
+	prefix.count   = sizeof(tag);
+
+	lone_hash_siphash_initialize(&state, k0, k1);
+	lone_hash_siphash_update(&state, prefix);
+	lone_hash_siphash_update(&state, data);
+
+	return lone_hash_siphash_finish(&state);
+}
+
+static void benchmark_run(struct lone_test_suite *suite, struct lone_test_case *test,
+		char *name, enum lone_lisp_tag tag, benchmark_hash_function hash)
+{
+	struct benchmark_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	unsigned char key[LONE_HASH_SIPHASH_SHORT_MAXIMUM];
+	char label[32];
+	volatile lone_hash sink;
+	lone_hash fast, incremental;
+	struct lone_bytes data;
+	lone_u64 start, elapsed;
+	size_t i, j;
+
+	for (i = 0; i < sizeof(key); ++i) { key[i] = 'a' + (i % 26); }
+
+	for (i = 0; i < sizeof(benchmark_lengths) / sizeof(benchmark_lengths[0]); ++i) {
+		data.pointer = key;
+		data.count   = benchmark_lengths[i];
+
+		fast        = hash(lone, data);
+		incremental = benchmark_hash_incremental(lone, tag, data);
+		lone_test_assert_u64_equal(suite, test, fast, incremental);
+
+		benchmark_label(label, name, data.count);
+
+		start = lone_test_benchmark_nanoseconds();
+		for (j = 0; j < BENCHMARK_ITERATIONS; ++j) {
+			key[0] = 'a' + (j % 26);
+			sink = hash(lone, data);
+		}
+		elapsed = lone_test_benchmark_nanoseconds() - start;
+		lone_test_benchmark_report(label, "single-shot", elapsed, data.count * BENCHMARK_ITERATIONS, "MB");
+
+		start = lone_test_benchmark_nanoseconds();
+		for (j = 0; j < BENCHMARK_ITERATIONS; ++j) {
+			key[0] = 'a' + (j % 26);
+			sink = benchmark_hash_incremental(lone, tag, data);
+		}
+		elapsed = lone_test_benchmark_nanoseconds() - start;
+		lone_test_benchmark_report(label, "incremental", elapsed, data.count * BENCHMARK_ITERATIONS, "MB");
+	}
+
+	(void) sink;
+}
+
+static LONE_TEST_FUNCTION(test_hash_benchmark_symbol)
+{
+	benchmark_run(suite, test, "symbol", LONE_LISP_TAG_SYMBOL, lone_lisp_hash_as_symbol);
+}
+
+static LONE_TEST_FUNCTION(test_hash_benchmark_text)
+{
+	benchmark_run(suite, test, "text", LONE_LISP_TAG_TEXT, lone_lisp_hash_as_text);
+}
+
+static LONE_TEST_FUNCTION(test_hash_benchmark_bytes)
+{
+	benchmark_run(suite, test, "bytes", LONE_LISP_TAG_BYTES, lone_lisp_hash_as_bytes);
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	struct benchmark_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/hash/benchmark/symbol",
+				test_hash_benchmark_symbol),
+		LONE_TEST_CASE("lone/hash/benchmark/text",
+				test_hash_benchmark_text),
+		LONE_TEST_CASE("lone/hash/benchmark/bytes",
+				test_hash_benchmark_bytes),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
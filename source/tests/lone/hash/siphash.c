@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: AGPL-3.0-or-later */
 
+#include <lone/definitions.h>
 #include <lone/types.h>
 #include <lone/hash/siphash.h>
 
@@ -110,6 +111,18 @@ static lone_u64 siphash_test_expected(size_t i)
 	return lone_u64le_read((void *) siphash_test_vectors[i]);
 }
 
+/* The reference vectors are only valid for SipHash-2-4. */
+static bool siphash_test_skip_unless_2_4(struct lone_test_case *test)
+{
+	if (   LONE_HASH_SIPHASH_COMPRESSION_ROUNDS  == 2
+	    && LONE_HASH_SIPHASH_FINALIZATION_ROUNDS == 4) {
+		return false;
+	}
+
+	test->result = LONE_TEST_RESULT_SKIPPED;
+	return true;
+}
+
 /* ╭────────────────────────────────────────────────────────────────────────╮
    │                                                                        │
    │    Single shot: feed the entire message in one call                    │
@@ -123,6 +136,8 @@ static LONE_TEST_FUNCTION(test_siphash_vectors_one_shot)
 	lone_u64 k0, k1, hash;
 	size_t i;
 
+	if (siphash_test_skip_unless_2_4(test)) { return; }
+
 	siphash_test_keys(&k0, &k1);
 
 	for (i = 0; i < 64; ++i) {
@@ -149,6 +164,8 @@ static LONE_TEST_FUNCTION(test_siphash_vectors_incremental)
 	lone_u64 k0, k1, hash;
 	size_t i;
 
+	if (siphash_test_skip_unless_2_4(test)) { return; }
+
 	siphash_test_keys(&k0, &k1);
 
 	for (i = 0; i < 64; ++i) {
@@ -179,6 +196,8 @@ static LONE_TEST_FUNCTION(test_siphash_vectors_byte_by_byte)
 	lone_u64 k0, k1, hash;
 	size_t i, j;
 
+	if (siphash_test_skip_unless_2_4(test)) { return; }
+
 	siphash_test_keys(&k0, &k1);
 
 	for (i = 0; i < 64; ++i) {
@@ -213,6 +232,8 @@ static LONE_TEST_FUNCTION(test_siphash_vectors_split_at_every_offset)
 	lone_u64 k0, k1, hash, expected;
 	size_t i, split;
 
+	if (siphash_test_skip_unless_2_4(test)) { return; }
+
 	siphash_test_keys(&k0, &k1);
 
 	for (i = 0; i < 64; ++i) {
@@ -235,6 +256,46 @@ static LONE_TEST_FUNCTION(test_siphash_vectors_split_at_every_offset)
 	}
 }
 
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Prefixed, across the short maximum:                                 │
+   │    hash the first byte as the prefix and the rest as the data,         │
+   │    for every length up to past LONE_HASH_SIPHASH_SHORT_MAXIMUM,        │
+   │    and compare against a state updated with both. Lengths on           │
+   │    either side of the maximum take different paths.                    │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+static LONE_TEST_FUNCTION(test_siphash_prefixed_short_maximum)
+{
+	unsigned char message[LONE_HASH_SIPHASH_SHORT_MAXIMUM + 9];
+	struct lone_hash_siphash_state state;
+	struct lone_hash_siphash_key key;
+	struct lone_bytes prefix, data;
+	lone_u64 k0, k1, hash, expected;
+	size_t i;
+
+	siphash_test_keys(&k0, &k1);
+	lone_hash_siphash_key_initialize(&key, k0, k1);
+	siphash_test_message_for(message, sizeof(message));
+
+	prefix.pointer = message;
+	prefix.count   = 1;
+	data.pointer   = message + 1;
+
+	for (i = 0; i < sizeof(message); ++i) {
+		data.count = i;
+
+		lone_hash_siphash_initialize_from_key(&state, &key);
+		lone_hash_siphash_update(&state, prefix);
+		lone_hash_siphash_update(&state, data);
+		expected = lone_hash_siphash_finish(&state);
+
+		hash = lone_hash_siphash_prefixed(&key, message[0], data);
+
+		if (!lone_test_assert_u64_equal(suite, test, hash, expected)) { return; }
+	}
+}
+
 long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
 {
 	static struct lone_test_case cases[] = {
@@ -247,6 +308,8 @@ long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv
 				test_siphash_vectors_byte_by_byte),
 		LONE_TEST_CASE("lone/hash/siphash/vectors/split-at-every-offset",
 				test_siphash_vectors_split_at_every_offset),
+		LONE_TEST_CASE("lone/hash/siphash/prefixed/short-maximum",
+				test_siphash_prefixed_short_maximum),
 
 		LONE_TEST_CASE_NULL(),
 	};
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/system.h>
+#include <lone/lisp.h>
+#include <lone/lisp/hash_cons.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Hash cons tests.                                                    │
+   │                                                                        │
+   │    Equal lists must come out as the same value. Lists far deeper or    │
+   │    longer than the cache depth limit must come out unchanged without   │
+   │    exhausting the native stack.                                        │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define HASH_CONS_TEST_SIZE (128 * 1024)
+
+struct hash_cons_test_context {
+	struct lone_lisp *lone;
+};
+
+static struct lone_lisp_value numbers(struct lone_lisp *lone, size_t count)
+{
+	struct lone_lisp_value list;
+
+	for (list = lone_lisp_nil(); count; --count) {
+		list = lone_lisp_list_create(lone, lone_lisp_integer_create((lone_lisp_integer) count), list);
+	}
+
+	return list;
+}
+
+static LONE_TEST_FUNCTION(test_hash_cons_equal_lists)
+{
+	struct hash_cons_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value x, y;
+
+	x = lone_lisp_hash_cons(lone, numbers(lone, 16));
+	y = lone_lisp_hash_cons(lone, numbers(lone, 16));
+
+	lone_test_assert_true(suite, test, lone_lisp_is_identical(lone, x, y));
+}
+
+static LONE_TEST_FUNCTION(test_hash_cons_long_list)
+{
+	struct hash_cons_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value list;
+
+	list = numbers(lone, HASH_CONS_TEST_SIZE);
+
+	lone_test_assert_true(suite, test, lone_lisp_is_identical(lone, list, lone_lisp_hash_cons(lone, list)));
+}
+
+static LONE_TEST_FUNCTION(test_hash_cons_deep_list)
+{
+	struct hash_cons_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value list;
+	size_t i;
+
+	for (list = lone_lisp_nil(), i = 0; i < HASH_CONS_TEST_SIZE; ++i) {
+		list = lone_lisp_list_create(lone, list, lone_lisp_nil());
+	}
+
+	lone_test_assert_true(suite, test, lone_lisp_is_identical(lone, list, lone_lisp_hash_cons(lone, list)));
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	struct hash_cons_test_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/lisp/hash-cons/equal-lists",
+				test_hash_cons_equal_lists),
+		LONE_TEST_CASE("lone/lisp/hash-cons/long-list",
+				test_hash_cons_long_list),
+		LONE_TEST_CASE("lone/lisp/hash-cons/deep-list",
+				test_hash_cons_deep_list),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
@@ -0,0 +1,294 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/memory/functions.h>
+#include <lone/system.h>
+#include <lone/lisp.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Integer formatting and parsing throughput.                          │
+   │                                                                        │
+   │    Integers of every length and sign are formatted and parsed by       │
+   │    the lisp functions and by digit at a time references which are      │
+   │    the implementations they replaced. Results are checked against      │
+   │    each other, including at powers of ten and at the limits of the     │
+   │    integer range, and then both are timed over the same values.        │
+   │    Timings are reported as extra lines in the test output for the      │
+   │    harness to pass through.                                            │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define BENCHMARK_VALUES 4096
+#define BENCHMARK_ROUNDS 256
+
+struct benchmark_context {
+	struct lone_lisp *lone;
+	lone_lisp_integer values[BENCHMARK_VALUES];
+	lone_lisp_integer long_values[BENCHMARK_VALUES];
+};
+
+static size_t benchmark_reference_format(lone_lisp_integer n, unsigned char *buffer)
+{
+	unsigned char digits[LONE_LISP_INTEGER_FORMAT_SIZE];
+	unsigned char *digit;
+	lone_u64 magnitude;
+	size_t count;
+
+	digit = digits + sizeof(digits);
+	magnitude = n < 0? -((lone_u64) n) : (lone_u64) n;
+
+	do {
+		*--digit = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude > 0);
+
+	if (n < 0) { *--digit = '-'; }
+
+	count = (size_t) (digits + sizeof(digits) - digit);
+	lone_memory_move(digit, buffer, count);
+
+	return count;
+}
+
+static lone_lisp_integer benchmark_reference_parse(unsigned char *digits, size_t count)
+{
+	lone_lisp_integer integer, digit;
+	bool negative;
+	size_t i;
+
+	i = 0;
+	integer = 0;
+	negative = *digits == '-';
+	if (negative || *digits == '+') { ++i; }
+
+	while (i < count) {
+		digit = digits[i++] - '0';
+		if (negative) { digit = -digit; }
+		integer = integer * 10 + digit;
+	}
+
+	return integer;
+}
+
+static lone_u64 benchmark_random(lone_u64 *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+/* uniformly distributed lengths rather than magnitudes */
+static lone_lisp_integer benchmark_generate_value(lone_u64 *state, size_t minimum, size_t maximum)
+{
+	lone_u64 magnitude;
+	size_t digits;
+
+	digits = minimum + benchmark_random(state) % (maximum - minimum + 1);
+
+	for (magnitude = 0; digits > 0; --digits) {
+		magnitude = magnitude * 10 + benchmark_random(state) % 10;
+	}
+
+	if (magnitude > LONE_LISP_INTEGER_MAX) { magnitude %= LONE_LISP_INTEGER_MAX; }
+
+	return (benchmark_random(state) & 1)? -(lone_lisp_integer) magnitude : (lone_lisp_integer) magnitude;
+}
+
+static void benchmark_generate_values(struct benchmark_context *context)
+{
+	lone_u64 state;
+	size_t i;
+
+	for (i = 0, state = 0x9E3779B97F4A7C15ULL; i < BENCHMARK_VALUES; ++i) {
+		context->values[i] = benchmark_generate_value(&state, 1, LONE_LISP_DECIMAL_DIGITS_PER_INTEGER - 3);
+		context->long_values[i] = benchmark_generate_value(&state, 16, 16);
+	}
+}
+
+static bool benchmark_check(struct lone_test_suite *suite, struct lone_test_case *test,
+		struct lone_lisp *lone, lone_lisp_integer n)
+{
+	unsigned char expected[LONE_LISP_INTEGER_FORMAT_SIZE], actual[LONE_LISP_INTEGER_FORMAT_SIZE];
+	size_t expected_count, actual_count;
+
+	expected_count = benchmark_reference_format(n, expected);
+	actual_count = lone_lisp_integer_format_decimal(n, actual);
+
+	return lone_test_assert_u64_equal(suite, test, expected_count, actual_count)
+	    && lone_test_assert_true(suite, test,
+	               lone_bytes_is_equal(LONE_BYTES_VALUE(expected_count, expected),
+	                                   LONE_BYTES_VALUE(actual_count, actual)))
+	    && lone_test_assert_long_equal(suite, test, n,
+	               lone_lisp_integer_of(lone_lisp_integer_parse(lone, actual, actual_count)));
+}
+
+static LONE_TEST_FUNCTION(test_integer_benchmark_correctness)
+{
+	struct benchmark_context *context = test->context;
+	lone_lisp_integer power;
+	size_t i;
+
+	if (!benchmark_check(suite, test, context->lone, LONE_LISP_INTEGER_MIN)) { return; }
+	if (!benchmark_check(suite, test, context->lone, LONE_LISP_INTEGER_MAX)) { return; }
+
+	for (power = 1; power <= LONE_LISP_INTEGER_MAX / 10; power *= 10) {
+		if (!benchmark_check(suite, test, context->lone, power - 1))  { return; }
+		if (!benchmark_check(suite, test, context->lone, power))      { return; }
+		if (!benchmark_check(suite, test, context->lone, -power))     { return; }
+		if (!benchmark_check(suite, test, context->lone, -power + 1)) { return; }
+	}
+
+	for (i = 0; i < BENCHMARK_VALUES; ++i) {
+		if (!benchmark_check(suite, test, context->lone, context->values[i]))      { return; }
+		if (!benchmark_check(suite, test, context->lone, context->long_values[i])) { return; }
+	}
+}
+
+static LONE_TEST_FUNCTION(test_integer_benchmark_hexadecimal)
+{
+	unsigned char buffer[LONE_LISP_INTEGER_FORMAT_SIZE];
+	size_t count;
+
+	count = lone_lisp_integer_format_hexadecimal(0, buffer);
+	lone_test_assert_true(suite, test, lone_bytes_is_equal_to_c_string(LONE_BYTES_VALUE(count, buffer), "0"));
+
+	count = lone_lisp_integer_format_hexadecimal(0xdeadbeef, buffer);
+	lone_test_assert_true(suite, test, lone_bytes_is_equal_to_c_string(LONE_BYTES_VALUE(count, buffer), "deadbeef"));
+
+	count = lone_lisp_integer_format_hexadecimal(-0x10, buffer);
+	lone_test_assert_true(suite, test, lone_bytes_is_equal_to_c_string(LONE_BYTES_VALUE(count, buffer), "-10"));
+
+	count = lone_lisp_integer_format_hexadecimal(LONE_LISP_INTEGER_MIN, buffer);
+	lone_test_assert_true(suite, test, lone_bytes_is_equal_to_c_string(LONE_BYTES_VALUE(count, buffer), "-80000000000000"));
+}
+
+static LONE_TEST_FUNCTION(test_integer_benchmark_format)
+{
+	struct benchmark_context *context = test->context;
+	unsigned char buffer[LONE_LISP_INTEGER_FORMAT_SIZE];
+	lone_u64 start, elapsed, expected, actual;
+	size_t round, i;
+
+	start = lone_test_benchmark_nanoseconds();
+	for (expected = 0, round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		for (i = 0; i < BENCHMARK_VALUES; ++i) {
+			expected += benchmark_reference_format(context->values[i], buffer) + buffer[0];
+		}
+	}
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report("format", "digitwise", elapsed, BENCHMARK_ROUNDS * BENCHMARK_VALUES, "M");
+
+	start = lone_test_benchmark_nanoseconds();
+	for (actual = 0, round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		for (i = 0; i < BENCHMARK_VALUES; ++i) {
+			actual += lone_lisp_integer_format_decimal(context->values[i], buffer) + buffer[0];
+		}
+	}
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report("format", "pairwise", elapsed, BENCHMARK_ROUNDS * BENCHMARK_VALUES, "M");
+
+	lone_test_assert_u64_equal(suite, test, expected, actual);
+}
+
+static void benchmark_parse(struct lone_test_suite *suite, struct lone_test_case *test,
+		struct lone_lisp *lone, char *name, lone_lisp_integer *values)
+{
+	static unsigned char digits[BENCHMARK_VALUES][LONE_LISP_INTEGER_FORMAT_SIZE];
+	static size_t counts[BENCHMARK_VALUES];
+	lone_u64 start, elapsed, expected, actual;
+	size_t round, i;
+
+	for (i = 0; i < BENCHMARK_VALUES; ++i) {
+		counts[i] = lone_lisp_integer_format_decimal(values[i], digits[i]);
+	}
+
+	start = lone_test_benchmark_nanoseconds();
+	for (expected = 0, round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		for (i = 0; i < BENCHMARK_VALUES; ++i) {
+			expected += (lone_u64) benchmark_reference_parse(digits[i], counts[i]);
+		}
+	}
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report(name, "digitwise", elapsed, BENCHMARK_ROUNDS * BENCHMARK_VALUES, "M");
+
+	start = lone_test_benchmark_nanoseconds();
+	for (actual = 0, round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		for (i = 0; i < BENCHMARK_VALUES; ++i) {
+			actual += (lone_u64) lone_lisp_integer_of(lone_lisp_integer_parse(lone, digits[i], counts[i]));
+		}
+	}
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report(name, "swar", elapsed, BENCHMARK_ROUNDS * BENCHMARK_VALUES, "M");
+
+	lone_test_assert_u64_equal(suite, test, expected, actual);
+}
+
+static LONE_TEST_FUNCTION(test_integer_benchmark_parse)
+{
+	struct benchmark_context *context = test->context;
+
+	benchmark_parse(suite, test, context->lone, "parse", context->values);
+}
+
+static LONE_TEST_FUNCTION(test_integer_benchmark_parse_long)
+{
+	struct benchmark_context *context = test->context;
+
+	benchmark_parse(suite, test, context->lone, "parse-long", context->long_values);
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	static struct benchmark_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/lisp/integer/benchmark/correctness",
+				test_integer_benchmark_correctness),
+		LONE_TEST_CASE("lone/lisp/integer/benchmark/hexadecimal",
+				test_integer_benchmark_hexadecimal),
+		LONE_TEST_CASE("lone/lisp/integer/benchmark/format",
+				test_integer_benchmark_format),
+		LONE_TEST_CASE("lone/lisp/integer/benchmark/parse",
+				test_integer_benchmark_parse),
+		LONE_TEST_CASE("lone/lisp/integer/benchmark/parse/long",
+				test_integer_benchmark_parse_long),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	benchmark_generate_values(&context);
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
@@ -0,0 +1,241 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/system.h>
+#include <lone/lisp.h>
+#include <lone/lisp/output.h>
+#include <lone/lisp/printer.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Printer tests.                                                      │
+   │                                                                        │
+   │    print_to_buffer prints a value into a pipe with the given limits    │
+   │    and reads back what was written. Outputs are kept well below the    │
+   │    capacity of the pipe so that no reader needs to run concurrently.   │
+   │                                                                        │
+   │    Values which refer to themselves cannot be built from lisp code     │
+   │    through lists, which have no mutating primitives, so their cells    │
+   │    are linked directly here.                                           │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define PRINTER_TEST_NESTING 200000
+
+struct printer_test_context {
+	struct lone_lisp *lone;
+};
+
+static struct lone_lisp_print_limits unlimited = { 0, 0 };
+
+static bool print_to_buffer(struct lone_lisp *lone, struct lone_lisp_value value,
+		struct lone_lisp_print_limits limits, unsigned char *buffer, size_t size, size_t *count)
+{
+	int fds[2];
+	ssize_t result;
+
+	if (linux_pipe2(fds, 0) < 0) { return false; }
+
+	lone_lisp_print_with_limits(lone, value, fds[1], limits);
+	lone_lisp_output_flush(lone, fds[1]);
+	linux_close(fds[1]);
+
+	for (*count = 0; *count < size; *count += (size_t) result) {
+		result = linux_read_once(fds[0], LONE_BYTES_VALUE(size - *count, buffer + *count));
+		if (result <= 0) { break; }
+	}
+
+	linux_close(fds[0]);
+	return true;
+}
+
+static void assert_printed(struct lone_test_suite *suite, struct lone_test_case *test,
+		struct lone_lisp_value value, struct lone_lisp_print_limits limits, char *expected)
+{
+	struct printer_test_context *context = test->context;
+	unsigned char buffer[256];
+	size_t count;
+
+	if (!lone_test_assert_true(suite, test,
+			print_to_buffer(context->lone, value, limits, buffer, sizeof(buffer), &count))) {
+		return;
+	}
+
+	if (!lone_bytes_is_equal_to_c_string(LONE_BYTES_VALUE(count, buffer), expected)) {
+		linux_write(2, buffer, count);
+		linux_write(2, "\n", 1);
+		lone_test_assert_true(suite, test, false);
+	}
+}
+
+static struct lone_lisp_value integers(struct lone_lisp *lone, size_t count)
+{
+	struct lone_lisp_value list;
+
+	for (list = lone_lisp_nil(); count > 0; --count) {
+		list = lone_lisp_list_create(lone, lone_lisp_integer_create((lone_lisp_integer) count), list);
+	}
+
+	return list;
+}
+
+static LONE_TEST_FUNCTION(test_printer_cycle_list_tail)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value list, last;
+
+	list = integers(lone, 3);
+	last = lone_lisp_list_rest(lone, lone_lisp_list_rest(lone, list));
+	lone_lisp_heap_value_of(lone, last)->as.list.rest = list;
+
+	assert_printed(suite, test, list, unlimited, "(1 2 3 . #<cycle>)");
+}
+
+static LONE_TEST_FUNCTION(test_printer_cycle_list_element)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value list;
+
+	list = integers(lone, 2);
+	lone_lisp_heap_value_of(lone, list)->as.list.first = list;
+
+	assert_printed(suite, test, list, unlimited, "(#<cycle> 2)");
+}
+
+static LONE_TEST_FUNCTION(test_printer_cycle_vector)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value vector, list;
+
+	vector = lone_lisp_vector_create(lone, 2);
+	list = lone_lisp_list_create(lone, vector, lone_lisp_nil());
+	lone_lisp_vector_push(lone, vector, lone_lisp_integer_create(1));
+	lone_lisp_vector_push(lone, vector, list);
+
+	assert_printed(suite, test, vector, unlimited, "[ 1 (#<cycle>) ]");
+}
+
+static LONE_TEST_FUNCTION(test_printer_shared)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value shared, list;
+
+	shared = integers(lone, 2);
+	list = lone_lisp_list_build(lone, 2, &shared, &shared);
+
+	assert_printed(suite, test, list, unlimited, "((1 2) (1 2))");
+}
+
+static LONE_TEST_FUNCTION(test_printer_length_limit)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_print_limits limits = { 0, 3 };
+	struct lone_lisp_value vector;
+	size_t i;
+
+	vector = lone_lisp_vector_create(lone, 8);
+	for (i = 0; i < 8; ++i) { lone_lisp_vector_push(lone, vector, lone_lisp_integer_create((lone_lisp_integer) i)); }
+
+	assert_printed(suite, test, integers(lone, 8), limits, "(1 2 3 ...)");
+	assert_printed(suite, test, integers(lone, 3), limits, "(1 2 3)");
+	assert_printed(suite, test, vector, limits, "[ 0 1 2 ... ]");
+}
+
+static LONE_TEST_FUNCTION(test_printer_depth_limit)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_print_limits limits = { 2, 0 };
+	struct lone_lisp_value value;
+	size_t i;
+
+	for (value = lone_lisp_nil(), i = 0; i < PRINTER_TEST_NESTING; ++i) {
+		value = lone_lisp_list_create(lone, value, lone_lisp_nil());
+	}
+
+	assert_printed(suite, test, value, limits, "((...))");
+}
+
+static LONE_TEST_FUNCTION(test_printer_deep_nesting)
+{
+	struct printer_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value value;
+	size_t i;
+	int fd;
+
+	for (value = lone_lisp_nil(), i = 0; i < PRINTER_TEST_NESTING; ++i) {
+		value = lone_lisp_vector_create(lone, 1);
+		lone_lisp_vector_push(lone, value, lone_lisp_list_create(lone, value, lone_lisp_nil()));
+	}
+
+	fd = (int) linux_openat(AT_FDCWD, (unsigned char *) "/dev/null", O_WRONLY | O_CLOEXEC);
+	if (!lone_test_assert_true(suite, test, fd >= 0)) { return; }
+
+	/* would overflow the native stack if the printer recursed */
+	lone_lisp_print_with_limits(lone, value, fd, unlimited);
+	lone_lisp_output_flush(lone, fd);
+	linux_close(fd);
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	struct printer_test_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/lisp/printer/cycle/list-tail",
+				test_printer_cycle_list_tail),
+		LONE_TEST_CASE("lone/lisp/printer/cycle/list-element",
+				test_printer_cycle_list_element),
+		LONE_TEST_CASE("lone/lisp/printer/cycle/vector",
+				test_printer_cycle_vector),
+		LONE_TEST_CASE("lone/lisp/printer/shared",
+				test_printer_shared),
+		LONE_TEST_CASE("lone/lisp/printer/limits/length",
+				test_printer_length_limit),
+		LONE_TEST_CASE("lone/lisp/printer/limits/depth",
+				test_printer_depth_limit),
+		LONE_TEST_CASE("lone/lisp/printer/deep-nesting",
+				test_printer_deep_nesting),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
@@ -0,0 +1,249 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/memory/allocator.h>
+#include <lone/memory/functions.h>
+#include <lone/system.h>
+#include <lone/lisp.h>
+#include <lone/lisp/reader.h>
+#include <lone/lisp/scan.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Lexical scanning and reader throughput.                             │
+   │                                                                        │
+   │    A large program is generated from a handful of lines mixing         │
+   │    symbols, numbers, texts, comments and indentation. Each scanner     │
+   │    is checked against a byte at a time reference at every offset       │
+   │    and length of a short input covering all chunk boundaries and       │
+   │    then timed against it over the whole program. The program is        │
+   │    finally read into values by the reader. Timings are reported as     │
+   │    extra lines in the test output for the harness to pass through.     │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define BENCHMARK_INPUT_SIZE (1024 * 1024)
+
+struct benchmark_context {
+	struct lone_lisp *lone;
+	struct lone_bytes input;
+};
+
+typedef size_t (*benchmark_scanner)(unsigned char *bytes, size_t count);
+
+static char *benchmark_lines[] = {
+	"(set symbol-with-a-rather-long-name (lambda (first second) (+ first second)))\n",
+	"    ; indented comment explaining something about the code below it\n",
+	"    (print \"a text literal long enough to be scanned in several chunks\")\n",
+	"        [vector of a few symbols 12345 -678 \"with\\tescapes\\n\" b\"\\x00\"]\n",
+	"\n",
+	"{ key value other-key \"other value\" } ; trailing comment\n",
+};
+
+static struct lone_bytes benchmark_generate_input(struct lone_lisp *lone)
+{
+	size_t count, length, i, lines;
+	unsigned char *input;
+	char *line;
+
+	lines = sizeof(benchmark_lines) / sizeof(benchmark_lines[0]);
+	input = lone_memory_allocate(lone->system, BENCHMARK_INPUT_SIZE, 1, 1, LONE_MEMORY_ALLOCATION_FLAGS_NONE);
+
+	for (count = 0, i = 0; /* input */; ++i) {
+		line = benchmark_lines[i % lines];
+		length = lone_c_string_length(line);
+		if (length > BENCHMARK_INPUT_SIZE - count) { break; }
+
+		lone_memory_move(line, input + count, length);
+		count += length;
+	}
+
+	return LONE_BYTES_VALUE(count, input);
+}
+
+static size_t benchmark_reference_whitespace(unsigned char *bytes, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count && (bytes[i] == ' ' || bytes[i] == '\t' || bytes[i] == '\n'); ++i);
+	return i;
+}
+
+static size_t benchmark_reference_symbol(unsigned char *bytes, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; ++i) {
+		switch (bytes[i]) {
+		case ' ': case '\t': case '\n':
+		case '(': case '[': case '{':
+		case ')': case ']': case '}':
+		case ';': case '"':
+			return i;
+		default:
+			continue;
+		}
+	}
+
+	return i;
+}
+
+static size_t benchmark_reference_line(unsigned char *bytes, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count && bytes[i] != '\n'; ++i);
+	return i;
+}
+
+static size_t benchmark_reference_quoted(unsigned char *bytes, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count && bytes[i] != '"' && bytes[i] != '\\'; ++i);
+	return i;
+}
+
+/* Scans every run of the class in the input like the reader does,
+ * only calling the scanner at bytes that start one. Returns the sum
+ * of run lengths so the work is not elided. */
+static size_t benchmark_scan_all(benchmark_scanner scan, benchmark_scanner reference,
+		struct lone_bytes input)
+{
+	size_t i, total, run;
+
+	for (i = 0, total = 0; i < input.count; i += run + 1) {
+		run = reference(input.pointer + i, 1)? scan(input.pointer + i, input.count - i) : 0;
+		total += run;
+	}
+
+	return total;
+}
+
+static void benchmark_scanner_run(struct lone_test_suite *suite, struct lone_test_case *test,
+		char *name, benchmark_scanner scan, benchmark_scanner reference)
+{
+	struct benchmark_context *context = test->context;
+	unsigned char *sample = context->input.pointer;
+	size_t offset, length, expected, actual;
+	lone_u64 start, elapsed;
+
+	/* every position of the scanned byte relative to the chunks */
+	for (offset = 0; offset < 256; ++offset) {
+		for (length = 0; length <= 64; ++length) {
+			if (!lone_test_assert_u64_equal(suite, test,
+					reference(sample + offset, length),
+					scan(sample + offset, length))) {
+				return;
+			}
+		}
+	}
+
+	start = lone_test_benchmark_nanoseconds();
+	expected = benchmark_scan_all(reference, reference, context->input);
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report(name, "bytewise", elapsed, context->input.count, "MB");
+
+	start = lone_test_benchmark_nanoseconds();
+	actual = benchmark_scan_all(scan, reference, context->input);
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+	lone_test_benchmark_report(name, "chunked", elapsed, context->input.count, "MB");
+
+	lone_test_assert_u64_equal(suite, test, expected, actual);
+}
+
+static LONE_TEST_FUNCTION(test_scan_benchmark_whitespace)
+{
+	benchmark_scanner_run(suite, test, "whitespace", lone_lisp_scan_whitespace, benchmark_reference_whitespace);
+}
+
+static LONE_TEST_FUNCTION(test_scan_benchmark_symbol)
+{
+	benchmark_scanner_run(suite, test, "symbol", lone_lisp_scan_symbol, benchmark_reference_symbol);
+}
+
+static LONE_TEST_FUNCTION(test_scan_benchmark_line)
+{
+	benchmark_scanner_run(suite, test, "line", lone_lisp_scan_line, benchmark_reference_line);
+}
+
+static LONE_TEST_FUNCTION(test_scan_benchmark_quoted)
+{
+	benchmark_scanner_run(suite, test, "quoted", lone_lisp_scan_quoted, benchmark_reference_quoted);
+}
+
+static LONE_TEST_FUNCTION(test_scan_benchmark_reader)
+{
+	struct benchmark_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_reader reader;
+	lone_u64 start, elapsed;
+	size_t forms;
+
+	lone_lisp_reader_for_bytes(lone, &reader, context->input);
+
+	start = lone_test_benchmark_nanoseconds();
+	for (forms = 0; /* input */; ++forms) {
+		lone_lisp_read(lone, &reader);
+		if (reader.status.error || reader.status.end_of_input) { break; }
+	}
+	elapsed = lone_test_benchmark_nanoseconds() - start;
+
+	lone_test_assert_false(suite, test, reader.status.error);
+	lone_test_assert_true(suite, test, forms > 0);
+
+	lone_lisp_reader_finalize(lone, &reader);
+
+	lone_test_benchmark_report("reader", "read", elapsed, context->input.count, "MB");
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	struct benchmark_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/lisp/scan/benchmark/whitespace",
+				test_scan_benchmark_whitespace),
+		LONE_TEST_CASE("lone/lisp/scan/benchmark/symbol",
+				test_scan_benchmark_symbol),
+		LONE_TEST_CASE("lone/lisp/scan/benchmark/line",
+				test_scan_benchmark_line),
+		LONE_TEST_CASE("lone/lisp/scan/benchmark/quoted",
+				test_scan_benchmark_quoted),
+		LONE_TEST_CASE("lone/lisp/scan/benchmark/reader",
+				test_scan_benchmark_reader),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	context.input = benchmark_generate_input(&lone_interpreter);
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
@@ -0,0 +1,144 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/definitions.h>
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/test.h>
+#include <lone/system.h>
+#include <lone/lisp.h>
+
+/* ╭────────────────────────────────────────────────────────────────────────╮
+   │                                                                        │
+   │    Slice tests.                                                        │
+   │                                                                        │
+   │    A read buffer is split into fixed size fields the way a protocol    │
+   │    parser would. Every field must point into the buffer itself and     │
+   │    own nothing, so that no field contents are ever allocated.          │
+   │                                                                        │
+   ╰────────────────────────────────────────────────────────────────────────╯ */
+
+#define SLICE_TEST_BUFFER_SIZE (64 * 1024)
+#define SLICE_TEST_FIELD_SIZE  16
+
+struct slice_test_context {
+	struct lone_lisp *lone;
+};
+
+static bool is_view_of(struct lone_lisp *lone, struct lone_lisp_value slice,
+		struct lone_lisp_value parent, size_t start, size_t count)
+{
+	struct lone_lisp_heap_value *actual;
+	struct lone_bytes data;
+
+	actual = lone_lisp_heap_value_of(lone, slice);
+	data = actual->as.bytes.data;
+
+	return actual->slice
+	    && !actual->should_deallocate_bytes
+	    && lone_lisp_is_identical(lone, actual->as.bytes.parent, parent)
+	    && data.count == count
+	    && data.pointer == lone_lisp_heap_value_of(lone, parent)->as.bytes.data.pointer + start;
+}
+
+static LONE_TEST_FUNCTION(test_slice_fields)
+{
+	struct slice_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value buffer, field;
+	size_t offset;
+
+	buffer = lone_lisp_bytes_create(lone, SLICE_TEST_BUFFER_SIZE);
+
+	for (offset = 0; offset < SLICE_TEST_BUFFER_SIZE; offset += SLICE_TEST_FIELD_SIZE) {
+		field = lone_lisp_bytes_slice(lone, buffer, offset, SLICE_TEST_FIELD_SIZE);
+		if (!lone_test_assert_true(suite, test,
+				is_view_of(lone, field, buffer, offset, SLICE_TEST_FIELD_SIZE))) {
+			return;
+		}
+	}
+}
+
+static LONE_TEST_FUNCTION(test_slice_of_slice)
+{
+	struct slice_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value buffer, outer, inner;
+
+	buffer = lone_lisp_bytes_create(lone, SLICE_TEST_BUFFER_SIZE);
+	outer = lone_lisp_bytes_slice(lone, buffer, 1024, 4096);
+	inner = lone_lisp_bytes_slice(lone, outer, 100, 200);
+
+	/* slices of slices refer to the original buffer directly */
+	lone_test_assert_true(suite, test, is_view_of(lone, inner, buffer, 1124, 200));
+}
+
+static LONE_TEST_FUNCTION(test_slice_detach)
+{
+	struct slice_test_context *context = test->context;
+	struct lone_lisp *lone = context->lone;
+	struct lone_lisp_value buffer, field;
+	struct lone_lisp_heap_value *actual;
+	struct lone_bytes data;
+
+	buffer = lone_lisp_bytes_create(lone, SLICE_TEST_BUFFER_SIZE);
+	lone_lisp_heap_value_of(lone, buffer)->as.bytes.data.pointer[40] = 'x';
+	field = lone_lisp_bytes_slice(lone, buffer, 32, 64);
+
+	lone_lisp_slice_detach(lone, field);
+
+	actual = lone_lisp_heap_value_of(lone, field);
+	data = actual->as.bytes.data;
+
+	lone_test_assert_true(suite, test, !actual->slice);
+	lone_test_assert_true(suite, test, actual->should_deallocate_bytes);
+	lone_test_assert_true(suite, test, data.pointer != lone_lisp_heap_value_of(lone, buffer)->as.bytes.data.pointer + 32);
+	lone_test_assert_u64_equal(suite, test, 64, data.count);
+	lone_test_assert_u64_equal(suite, test, 'x', data.pointer[8]);
+	lone_test_assert_u64_equal(suite, test, 0, data.pointer[64]);
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	void *stack = __builtin_frame_address(0);
+	struct lone_system system;
+	struct lone_lisp lone_interpreter;
+	struct slice_test_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/lisp/slice/fields",
+				test_slice_fields),
+		LONE_TEST_CASE("lone/lisp/slice/slice-of-slice",
+				test_slice_of_slice),
+		LONE_TEST_CASE("lone/lisp/slice/detach",
+				test_slice_detach),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	lone_system_initialize(&system, auxv);
+	lone_lisp_initialize(&lone_interpreter, &system, stack);
+
+	context.lone = &lone_interpreter;
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>
@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: AGPL-3.0-or-later */
+
+#include <lone/types.h>
+#include <lone/linux.h>
+#include <lone/vdso.h>
+#include <lone/auxiliary_vector.h>
+
+#include <lone/test.h>
+
+struct vdso_test_context {
+	struct lone_auxiliary_vector *auxv;
+	struct lone_vdso vdso;
+};
+
+static long nanoseconds_of(struct __kernel_timespec *time)
+{
+	return time->tv_sec * 1000000000L + time->tv_nsec;
+}
+
+static LONE_TEST_FUNCTION(test_vdso_clock_gettime_is_resolved)
+{
+	struct vdso_test_context *context = test->context;
+
+	lone_test_assert_true(suite, test, context->vdso.clock_gettime != 0);
+}
+
+static LONE_TEST_FUNCTION(test_vdso_clock_gettime_matches_system_call)
+{
+	struct vdso_test_context *context = test->context;
+	struct __kernel_timespec before, during, after;
+
+	if (!context->vdso.clock_gettime) {
+		test->result = LONE_TEST_RESULT_SKIPPED;
+		return;
+	}
+
+	linux_clock_gettime(CLOCK_MONOTONIC, &before);
+	lone_test_assert_u64_equal(suite, test, 0, context->vdso.clock_gettime(CLOCK_MONOTONIC, &during));
+	linux_clock_gettime(CLOCK_MONOTONIC, &after);
+
+	lone_test_assert_true(suite, test, nanoseconds_of(&before) <= nanoseconds_of(&during));
+	lone_test_assert_true(suite, test, nanoseconds_of(&during) <= nanoseconds_of(&after));
+}
+
+static LONE_TEST_FUNCTION(test_vdso_unknown_symbol)
+{
+	struct vdso_test_context *context = test->context;
+	lone_elf_native_header *header;
+
+	header = lone_auxiliary_vector_value(context->auxv, AT_SYSINFO_EHDR).as.pointer;
+
+	lone_test_assert_true(suite, test, lone_vdso_symbol(header, "__vdso_no_such_function") == 0);
+	lone_test_assert_true(suite, test, lone_vdso_symbol(0, "__vdso_clock_gettime") == 0);
+}
+
+long lone(int argc, char **argv, char **envp, struct lone_auxiliary_vector *auxv)
+{
+	struct vdso_test_context context;
+	struct lone_test_suite suite;
+	enum lone_test_result result;
+	size_t i;
+
+	static struct lone_test_case cases[] = {
+
+		LONE_TEST_CASE("lone/vdso/clock_gettime/resolved",
+				test_vdso_clock_gettime_is_resolved),
+		LONE_TEST_CASE("lone/vdso/clock_gettime/matches-system-call",
+				test_vdso_clock_gettime_matches_system_call),
+		LONE_TEST_CASE("lone/vdso/unknown-symbol",
+				test_vdso_unknown_symbol),
+
+		LONE_TEST_CASE_NULL(),
+	};
+
+	context.auxv = auxv;
+	lone_vdso_initialize(&context.vdso, auxv);
+	for (i = 0; cases[i].test; ++i) { cases[i].context = &context; }
+
+	suite = (struct lone_test_suite) LONE_TEST_SUITE(cases);
+
+	result = lone_test_suite_run(&suite);
+
+	switch (result) {
+	case LONE_TEST_RESULT_PASS:
+		return 0;
+	case LONE_TEST_RESULT_FAIL:
+		return 1;
+	case LONE_TEST_RESULT_SKIP:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+#include <lone/architecture/linux/entry.c>